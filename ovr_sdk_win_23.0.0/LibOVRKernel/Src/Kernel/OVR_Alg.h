@@ -28,6 +28,7 @@ limitations under the License.
 #define OVR_Alg_h
 
 #include <string.h>
+#include "OVR_Std.h"
 #include "OVR_Types.h"
 #if defined(_MSC_VER)
 #include <intrin.h>
@@ -276,95 +277,284 @@ struct OperatorLess {
 };
 
 //-----------------------------------------------------------------------------------
-// ***** QuickSortSliced
+// ***** HeapSortSliced
 //
 // Sort any part of any array: plain, Array, ArrayPaged, ArrayUnsafe.
 // The range is specified with start, end, where "end" is exclusive!
 // The comparison predicate must be specified.
+// Guaranteed O(n log n) regardless of input, but typically slower than IntroSort.
+// IntroSort falls back to it when the partitioning goes bad.
 template <class Array, class Less>
-void QuickSortSliced(Array& arr, size_t start, size_t end, Less less) {
-  enum { Threshold = 9 };
+void HeapSiftDown(Array& arr, size_t start, size_t root, size_t count, Less less) {
+  for (;;) {
+    size_t child = 2 * root + 1;
+    if (child >= count)
+      break;
+    if ((child + 1 < count) && less(arr[start + child], arr[start + child + 1]))
+      ++child;
+    if (!less(arr[start + root], arr[start + child]))
+      break;
+    Swap(arr[start + root], arr[start + child]);
+    root = child;
+  }
+}
 
-  if (end - start < 2)
+template <class Array, class Less>
+void HeapSortSliced(Array& arr, size_t start, size_t end, Less less) {
+  size_t count = end - start;
+  if (count < 2)
     return;
 
-  intptr_t stack[80];
-  intptr_t* top = stack;
-  intptr_t base = (intptr_t)start;
-  intptr_t limit = (intptr_t)end;
+  for (size_t i = count / 2; i-- > 0;)
+    HeapSiftDown(arr, start, i, count, less);
+
+  while (count > 1) {
+    --count;
+    Swap(arr[start], arr[start + count]);
+    HeapSiftDown(arr, start, 0, count, less);
+  }
+}
+
+template <class Array>
+void HeapSortSliced(Array& arr, size_t start, size_t end) {
+  typedef typename Array::ValueType ValueType;
+  HeapSortSliced(arr, start, end, OperatorLess<ValueType>::Compare);
+}
+
+//-----------------------------------------------------------------------------------
+// ***** IntroSortSliced
+//
+// Sort any part of any array: plain, Array, ArrayPaged, ArrayUnsafe.
+// The range is specified with start, end, where "end" is exclusive!
+// The comparison predicate must be specified.
+//
+// This is a pattern-defeating introsort: quicksort with median-of-three (ninther for
+// large ranges) pivots, insertion sort for small ranges, detection of already partitioned
+// ranges, and a heap sort fallback once too many unbalanced partitions have been seen.
+// The worst case is O(n log n). Like QuickSort, it is not stable.
+//
+// The Checked variants test the array limits on every scan, so that a comparator which
+// is not a strict weak ordering returns false instead of reading outside of the range.
+
+enum {
+  IntroSortInsertionThreshold = 16, // Ranges of at most this size are insertion sorted.
+  IntroSortNintherThreshold = 128, // Ranges above this size use Tukey's ninther as the pivot.
+  IntroSortPartialInsertionLimit = 8 // Element moves allowed before giving up on a presorted range.
+};
+
+// Returns the number of partitions that may be unbalanced before IntroSort falls back
+// to HeapSort, which is log2(count).
+inline int IntroSortDepthBudget(size_t count) {
+  return 64 - CountLeading0Bits((uint64_t)count);
+}
+
+template <class Array, class Less>
+void IntroSortInsertion(Array& arr, intptr_t base, intptr_t limit, Less less) {
+  for (intptr_t i = base + 1; i < limit; i++) {
+    for (intptr_t j = i - 1; less(arr[j + 1], arr[j]); j--) {
+      Swap(arr[j + 1], arr[j]);
+      if (j == base)
+        break;
+    }
+  }
+}
+
+// Insertion sort which gives up after IntroSortPartialInsertionLimit moves.
+// Returns true if the range was sorted.
+template <class Array, class Less>
+bool IntroSortPartialInsertion(Array& arr, intptr_t base, intptr_t limit, Less less) {
+  intptr_t moves = 0;
+  for (intptr_t i = base + 1; i < limit; i++) {
+    for (intptr_t j = i - 1; less(arr[j + 1], arr[j]); j--) {
+      Swap(arr[j + 1], arr[j]);
+      ++moves;
+      if (j == base)
+        break;
+    }
+    if (moves > IntroSortPartialInsertionLimit)
+      return false;
+  }
+  return true;
+}
+
+// Returns whichever index of a, b, c refers to the median value.
+template <class Array, class Less>
+intptr_t IntroSortMedian3(Array& arr, intptr_t a, intptr_t b, intptr_t c, Less less) {
+  if (less(arr[a], arr[b])) {
+    if (less(arr[b], arr[c]))
+      return b;
+    return less(arr[a], arr[c]) ? c : a;
+  }
+  if (less(arr[a], arr[c]))
+    return a;
+  return less(arr[b], arr[c]) ? c : b;
+}
+
+// Partitions [base, limit) around a pivot and returns the final pivot position in pivotPos.
+// On return, every element in [base, pivotPos) is not greater than the pivot and every
+// element in (pivotPos, limit) is not less than the pivot.
+// alreadyPartitioned is set if no elements had to be exchanged.
+// Requires limit - base > IntroSortInsertionThreshold.
+template <bool Checked, class Array, class Less>
+bool IntroSortPartition(
+    Array& arr,
+    intptr_t base,
+    intptr_t limit,
+    Less less,
+    intptr_t& pivotPos,
+    bool& alreadyPartitioned) {
+  intptr_t len = limit - base;
+  intptr_t mid = base + len / 2;
+  intptr_t pivot = mid;
+
+  if (len > IntroSortNintherThreshold) {
+    intptr_t s = len / 8;
+    intptr_t m1 = IntroSortMedian3(arr, base, base + s, base + 2 * s, less);
+    intptr_t m2 = IntroSortMedian3(arr, mid - s, mid, mid + s, less);
+    intptr_t m3 = IntroSortMedian3(arr, limit - 1 - 2 * s, limit - 1 - s, limit - 1, less);
+    pivot = IntroSortMedian3(arr, m1, m2, m3, less);
+  }
+
+  Swap(arr[base], arr[pivot]);
+
+  intptr_t i = base + 1;
+  intptr_t j = limit - 1;
+  alreadyPartitioned = true;
 
+  // Now ensure that *i <= *base <= *j, which act as sentinels for the scans below.
+  if (less(arr[j], arr[i])) {
+    Swap(arr[j], arr[i]);
+    alreadyPartitioned = false;
+  }
+  if (less(arr[base], arr[i])) {
+    Swap(arr[base], arr[i]);
+    alreadyPartitioned = false;
+  }
+  if (less(arr[j], arr[base])) {
+    Swap(arr[j], arr[base]);
+    alreadyPartitioned = false;
+  }
+
+  // Scans stop on elements equal to the pivot, which keeps runs of equal keys balanced.
+  for (;;) {
+    do {
+      i++;
+      if (Checked && (i >= limit))
+        return false;
+    } while (less(arr[i], arr[base]));
+    do {
+      j--;
+      if (Checked && (j < base))
+        return false;
+    } while (less(arr[base], arr[j]));
+
+    if (i > j)
+      break;
+
+    Swap(arr[i], arr[j]);
+    alreadyPartitioned = false;
+  }
+
+  Swap(arr[base], arr[j]);
+  pivotPos = j;
+  return true;
+}
+
+template <bool Checked, class Array, class Less>
+bool IntroSortLoop(Array& arr, intptr_t base, intptr_t limit, Less less, int badAllowed) {
   for (;;) {
     intptr_t len = limit - base;
-    intptr_t i, j, pivot;
-
-    if (len > Threshold) {
-      // we use base + len/2 as the pivot
-      pivot = base + len / 2;
-      Swap(arr[base], arr[pivot]);
-
-      i = base + 1;
-      j = limit - 1;
-
-      // now ensure that *i <= *base <= *j
-      if (less(arr[j], arr[i]))
-        Swap(arr[j], arr[i]);
-      if (less(arr[base], arr[i]))
-        Swap(arr[base], arr[i]);
-      if (less(arr[j], arr[base]))
-        Swap(arr[j], arr[base]);
-
-      for (;;) {
-        do
-          i++;
-        while (less(arr[i], arr[base]));
-        do
-          j--;
-        while (less(arr[base], arr[j]));
-
-        if (i > j) {
-          break;
-        }
-
-        Swap(arr[i], arr[j]);
-      }
 
-      Swap(arr[base], arr[j]);
-
-      // now, push the largest sub-array
-      if (j - base > limit - i) {
-        top[0] = base;
-        top[1] = j;
-        base = i;
-      } else {
-        top[0] = i;
-        top[1] = limit;
-        limit = j;
+    if (len <= IntroSortInsertionThreshold) {
+      IntroSortInsertion(arr, base, limit, less);
+      return true;
+    }
+
+    intptr_t pivotPos;
+    bool alreadyPartitioned;
+    if (!IntroSortPartition<Checked>(arr, base, limit, less, pivotPos, alreadyPartitioned))
+      return false;
+
+    intptr_t lSize = pivotPos - base;
+    intptr_t rSize = limit - (pivotPos + 1);
+    bool highlyUnbalanced = (lSize < len / 8) || (rSize < len / 8);
+
+    if (highlyUnbalanced) {
+      // Too many bad pivots: the input is adversarial, so switch to the guaranteed method.
+      if (--badAllowed == 0) {
+        HeapSortSliced(arr, (size_t)base, (size_t)limit, less);
+        return true;
       }
-      top += 2;
-    } else {
-      // the sub-array is small, perform insertion sort
-      j = base;
-      i = j + 1;
-
-      for (; i < limit; j = i, i++) {
-        for (; less(arr[j + 1], arr[j]); j--) {
-          Swap(arr[j + 1], arr[j]);
-          if (j == base) {
-            break;
-          }
-        }
+
+      // Break up patterns which may be causing the bad pivots.
+      if (lSize >= IntroSortInsertionThreshold) {
+        Swap(arr[base], arr[base + lSize / 4]);
+        Swap(arr[pivotPos - 1], arr[pivotPos - lSize / 4]);
       }
-      if (top > stack) {
-        top -= 2;
-        base = top[0];
-        limit = top[1];
-      } else {
-        break;
+      if (rSize >= IntroSortInsertionThreshold) {
+        Swap(arr[pivotPos + 1], arr[pivotPos + 1 + rSize / 4]);
+        Swap(arr[limit - 1], arr[limit - rSize / 4]);
       }
+    } else if (alreadyPartitioned) {
+      // The range was likely sorted or nearly sorted already; try to finish it cheaply.
+      if (IntroSortPartialInsertion(arr, base, pivotPos, less) &&
+          IntroSortPartialInsertion(arr, pivotPos + 1, limit, less))
+        return true;
+    }
+
+    // Recurse into the smaller side and loop on the larger, which bounds the stack depth.
+    if (lSize < rSize) {
+      if (!IntroSortLoop<Checked>(arr, base, pivotPos, less, badAllowed))
+        return false;
+      base = pivotPos + 1;
+    } else {
+      if (!IntroSortLoop<Checked>(arr, pivotPos + 1, limit, less, badAllowed))
+        return false;
+      limit = pivotPos;
     }
   }
 }
 
+template <class Array, class Less>
+void IntroSortSliced(Array& arr, size_t start, size_t end, Less less) {
+  if (end - start < 2)
+    return;
+  IntroSortLoop<false>(
+      arr, (intptr_t)start, (intptr_t)end, less, IntroSortDepthBudget(end - start));
+}
+
+template <class Array>
+void IntroSortSliced(Array& arr, size_t start, size_t end) {
+  typedef typename Array::ValueType ValueType;
+  IntroSortSliced(arr, start, end, OperatorLess<ValueType>::Compare);
+}
+
+template <class Array, class Less>
+bool IntroSortSlicedChecked(Array& arr, size_t start, size_t end, Less less) {
+  if (end - start < 2)
+    return true;
+  return IntroSortLoop<true>(
+      arr, (intptr_t)start, (intptr_t)end, less, IntroSortDepthBudget(end - start));
+}
+
+template <class Array>
+bool IntroSortSlicedChecked(Array& arr, size_t start, size_t end) {
+  typedef typename Array::ValueType ValueType;
+  return IntroSortSlicedChecked(arr, start, end, OperatorLess<ValueType>::Compare);
+}
+
+//-----------------------------------------------------------------------------------
+// ***** QuickSortSliced
+//
+// Sort any part of any array: plain, Array, ArrayPaged, ArrayUnsafe.
+// The range is specified with start, end, where "end" is exclusive!
+// The comparison predicate must be specified.
+// This is implemented with IntroSortSliced, and so is O(n log n) in the worst case.
+template <class Array, class Less>
+void QuickSortSliced(Array& arr, size_t start, size_t end, Less less) {
+  IntroSortSliced(arr, start, end, less);
+}
+
 //-----------------------------------------------------------------------------------
 // ***** QuickSortSliced
 //
@@ -381,91 +571,7 @@ void QuickSortSliced(Array& arr, size_t start, size_t end) {
 // crash in the case of wrong comparator functor.
 template <class Array, class Less>
 bool QuickSortSlicedSafe(Array& arr, size_t start, size_t end, Less less) {
-  enum { Threshold = 9 };
-
-  if (end - start < 2)
-    return true;
-
-  intptr_t stack[80];
-  intptr_t* top = stack;
-  intptr_t base = (intptr_t)start;
-  intptr_t limit = (intptr_t)end;
-
-  for (;;) {
-    intptr_t len = limit - base;
-    intptr_t i, j, pivot;
-
-    if (len > Threshold) {
-      // we use base + len/2 as the pivot
-      pivot = base + len / 2;
-      Swap(arr[base], arr[pivot]);
-
-      i = base + 1;
-      j = limit - 1;
-
-      // now ensure that *i <= *base <= *j
-      if (less(arr[j], arr[i]))
-        Swap(arr[j], arr[i]);
-      if (less(arr[base], arr[i]))
-        Swap(arr[base], arr[i]);
-      if (less(arr[j], arr[base]))
-        Swap(arr[j], arr[base]);
-
-      for (;;) {
-        do {
-          i++;
-          if (i >= limit)
-            return false;
-        } while (less(arr[i], arr[base]));
-        do {
-          j--;
-          if (j < 0)
-            return false;
-        } while (less(arr[base], arr[j]));
-
-        if (i > j) {
-          break;
-        }
-
-        Swap(arr[i], arr[j]);
-      }
-
-      Swap(arr[base], arr[j]);
-
-      // now, push the largest sub-array
-      if (j - base > limit - i) {
-        top[0] = base;
-        top[1] = j;
-        base = i;
-      } else {
-        top[0] = i;
-        top[1] = limit;
-        limit = j;
-      }
-      top += 2;
-    } else {
-      // the sub-array is small, perform insertion sort
-      j = base;
-      i = j + 1;
-
-      for (; i < limit; j = i, i++) {
-        for (; less(arr[j + 1], arr[j]); j--) {
-          Swap(arr[j + 1], arr[j]);
-          if (j == base) {
-            break;
-          }
-        }
-      }
-      if (top > stack) {
-        top -= 2;
-        base = top[0];
-        limit = top[1];
-      } else {
-        break;
-      }
-    }
-  }
-  return true;
+  return IntroSortSlicedChecked(arr, start, end, less);
 }
 
 template <class Array>
@@ -782,6 +888,127 @@ class ConstArrayAdaptor {
   size_t Size;
 };
 
+//-----------------------------------------------------------------------------------
+// ***** RadixSort
+//
+// Sorts a plain array of integer or floating point keys with an LSD radix sort, which is
+// O(n) and typically several times faster than QuickSort for large arrays of these types.
+// scratch must point to storage for at least count elements; it is left in an undefined state.
+// Passes in which all keys share the same byte are skipped.
+// Floating point values are ordered by their IEEE-754 total order, so -0 sorts before +0
+// and NaNs sort to the ends, instead of making the result undefined as with operator <.
+//
+// Example usage:
+//     float values[512], scratch[512];
+//     RadixSort(values, 512, scratch);
+
+// RadixKey maps a value to an unsigned integer with the same ordering.
+template <class T>
+struct RadixKey;
+
+#define OVR_RADIX_KEY_UNSIGNED(T) \
+  template <>                     \
+  struct RadixKey<T> {            \
+    typedef T KeyType;            \
+    static KeyType Get(T value) { \
+      return value;               \
+    }                             \
+  };
+
+#define OVR_RADIX_KEY_SIGNED(T, U)                          \
+  template <>                                               \
+  struct RadixKey<T> {                                      \
+    typedef U KeyType;                                      \
+    static KeyType Get(T value) {                           \
+      return (U)((U)value ^ ((U)1 << (sizeof(U) * 8 - 1))); \
+    }                                                       \
+  };
+
+#define OVR_RADIX_KEY_FLOAT(T, U)                               \
+  template <>                                                   \
+  struct RadixKey<T> {                                          \
+    typedef U KeyType;                                          \
+    static KeyType Get(T value) {                               \
+      U bits;                                                   \
+      memcpy(&bits, &value, sizeof(bits));                      \
+      const U signBit = ((U)1 << (sizeof(U) * 8 - 1));          \
+      return (bits & signBit) ? (U)~bits : (U)(bits ^ signBit); \
+    }                                                           \
+  };
+
+OVR_RADIX_KEY_UNSIGNED(uint8_t)
+OVR_RADIX_KEY_UNSIGNED(uint16_t)
+OVR_RADIX_KEY_UNSIGNED(uint32_t)
+OVR_RADIX_KEY_UNSIGNED(uint64_t)
+OVR_RADIX_KEY_SIGNED(int8_t, uint8_t)
+OVR_RADIX_KEY_SIGNED(int16_t, uint16_t)
+OVR_RADIX_KEY_SIGNED(int32_t, uint32_t)
+OVR_RADIX_KEY_SIGNED(int64_t, uint64_t)
+OVR_RADIX_KEY_FLOAT(float, uint32_t)
+OVR_RADIX_KEY_FLOAT(double, uint64_t)
+
+#undef OVR_RADIX_KEY_UNSIGNED
+#undef OVR_RADIX_KEY_SIGNED
+#undef OVR_RADIX_KEY_FLOAT
+
+template <class T>
+struct RadixKeyLess {
+  static bool Compare(const T& a, const T& b) {
+    return RadixKey<T>::Get(a) < RadixKey<T>::Get(b);
+  }
+};
+
+template <class T>
+void RadixSort(T* data, size_t count, T* scratch) {
+  typedef typename RadixKey<T>::KeyType KeyType;
+  enum { PassCount = sizeof(KeyType), SmallCount = 64 };
+
+  if (count < 2)
+    return;
+
+  // For small arrays the histogram setup costs more than it saves.
+  if (count <= SmallCount) {
+    ArrayAdaptor<T> arr(data, count);
+    IntroSortInsertion(arr, 0, (intptr_t)count, RadixKeyLess<T>::Compare);
+    return;
+  }
+
+  size_t histogram[PassCount][256];
+  memset(histogram, 0, sizeof(histogram));
+
+  for (size_t i = 0; i < count; i++) {
+    KeyType key = RadixKey<T>::Get(data[i]);
+    for (int pass = 0; pass < PassCount; pass++)
+      histogram[pass][(key >> (pass * 8)) & 0xff]++;
+  }
+
+  T* src = data;
+  T* dst = scratch;
+  const KeyType firstKey = RadixKey<T>::Get(data[0]);
+
+  for (int pass = 0; pass < PassCount; pass++) {
+    size_t* bucket = histogram[pass];
+    const int shift = pass * 8;
+
+    if (bucket[(firstKey >> shift) & 0xff] == count) // Every key has the same byte here.
+      continue;
+
+    size_t offset = 0;
+    for (int b = 0; b < 256; b++) {
+      size_t n = bucket[b];
+      bucket[b] = offset;
+      offset += n;
+    }
+
+    for (size_t i = 0; i < count; i++)
+      dst[bucket[(RadixKey<T>::Get(src[i]) >> shift) & 0xff]++] = src[i];
+
+    Swap(src, dst);
+  }
+
+  if (src != data)
+    memcpy(data, src, count * sizeof(T));
+}
 //-----------------------------------------------------------------------------------
 extern const uint8_t UpperBitTable[256];
 extern const uint8_t LowerBitTable[256];
@@ -857,41 +1084,40 @@ class MemUtil {
   static int Cmp16(const void* p1, const void* p2, size_t int16Count);
   static int Cmp32(const void* p1, const void* p2, size_t int32Count);
   static int Cmp64(const void* p1, const void* p2, size_t int64Count);
+
+  // Returns the index of the first byte which differs, or byteCount if none do.
+  // Uses SIMD where the CPU supports it.
+  static size_t FindMismatch(const void* p1, const void* p2, size_t byteCount) {
+    return OVR_memmismatch(p1, p2, byteCount);
+  }
 };
 
 // ** Inline Implementation
 
+// The CmpN functions compare as signed integers rather than bytes, so the SIMD mismatch
+// search finds the first differing element, which is then compared as a whole.
 inline int MemUtil::Cmp16(const void* p1, const void* p2, size_t int16Count) {
-  int16_t* pa = (int16_t*)p1;
-  int16_t* pb = (int16_t*)p2;
-  unsigned ic = 0;
-  if (int16Count == 0)
+  const int16_t* pa = (const int16_t*)p1;
+  const int16_t* pb = (const int16_t*)p2;
+  size_t ic = FindMismatch(p1, p2, int16Count * sizeof(int16_t)) / sizeof(int16_t);
+  if (ic == int16Count)
     return 0;
-  while (pa[ic] == pb[ic])
-    if (++ic == int16Count)
-      return 0;
   return pa[ic] > pb[ic] ? 1 : -1;
 }
 inline int MemUtil::Cmp32(const void* p1, const void* p2, size_t int32Count) {
-  int32_t* pa = (int32_t*)p1;
-  int32_t* pb = (int32_t*)p2;
-  unsigned ic = 0;
-  if (int32Count == 0)
+  const int32_t* pa = (const int32_t*)p1;
+  const int32_t* pb = (const int32_t*)p2;
+  size_t ic = FindMismatch(p1, p2, int32Count * sizeof(int32_t)) / sizeof(int32_t);
+  if (ic == int32Count)
     return 0;
-  while (pa[ic] == pb[ic])
-    if (++ic == int32Count)
-      return 0;
   return pa[ic] > pb[ic] ? 1 : -1;
 }
 inline int MemUtil::Cmp64(const void* p1, const void* p2, size_t int64Count) {
-  int64_t* pa = (int64_t*)p1;
-  int64_t* pb = (int64_t*)p2;
-  unsigned ic = 0;
-  if (int64Count == 0)
+  const int64_t* pa = (const int64_t*)p1;
+  const int64_t* pb = (const int64_t*)p2;
+  size_t ic = FindMismatch(p1, p2, int64Count * sizeof(int64_t)) / sizeof(int64_t);
+  if (ic == int64Count)
     return 0;
-  while (pa[ic] == pb[ic])
-    if (++ic == int64Count)
-      return 0;
   return pa[ic] > pb[ic] ? 1 : -1;
 }
 
@@ -1251,6 +1251,7 @@ Allocator::Allocator(const char* allocatorName)
       DelayedFreeList(),
       DelayedAlignedFreeList(),
       CurrentCounter(),
+      BacktraceTable(nullptr),
       SymbolLookupEnabled(false),
       TagMap(),
       TagMapLock() {
@@ -1455,6 +1456,11 @@ void Allocator::Shutdown() {
     TagMap.clear();
     CurrentCounter = 0;
 
+    if (StackTraceTable* backtraceTable = BacktraceTable.exchange(nullptr)) {
+      backtraceTable->~StackTraceTable();
+      SysMemFree(backtraceTable, sizeof(StackTraceTable));
+    }
+
     // Free the heap.
     if (Heap) {
       Heap->Shutdown();
@@ -1969,10 +1975,9 @@ void Allocator::SetNewBlockMetadata(
     const char* file,
     int line,
     const char* tag,
-    void** backtraceArray,
-    size_t backtraceArraySize) {
+    uint32_t backtraceId) {
   amd.Alloc = alloc;
-  amd.Backtrace.assign(backtraceArray, backtraceArray + backtraceArraySize);
+  amd.BacktraceId = backtraceId;
   amd.BacktraceSymbols.clear(); // This is only set when needed.
   amd.File = file;
   amd.Line = line;
@@ -2002,15 +2007,13 @@ void Allocator::TrackAlloc(
 
     TrackedAllocMap::value_type value(p, AllocMetadata());
 
-#if defined(_WIN64)
+    // Only the addresses are stored here, once per distinct backtrace. They are symbolized by
+    // DescribeAllocation.
     void* addressArray[128];
-    size_t frameCount = Symbols.GetBacktrace(addressArray, OVR_ARRAY_COUNT(addressArray), 2);
-#else
-    // Currently 32 bit backtrace reading is too slow. We can fix it by writing our own version
-    // that reads the stack frames, but it's not a high priority since we work mostly with 64 bit.
-    void* addressArray[1] = {nullptr};
-    size_t frameCount = 0;
-#endif
+    size_t frameCount =
+        SymbolLookup::CaptureBacktrace(addressArray, OVR_ARRAY_COUNT(addressArray), 1);
+    StackTraceTable* backtraceTable = GetBacktraceTable();
+    uint32_t backtraceId = backtraceTable ? backtraceTable->Add(addressArray, frameCount) : 0;
 
     if (!tag)
       tag = GetTag();
@@ -2025,8 +2028,7 @@ void Allocator::TrackAlloc(
         file,
         line,
         tag,
-        addressArray,
-        frameCount);
+        backtraceId);
 
     Lock::Locker locker(&TrackLock);
 
@@ -2037,6 +2039,27 @@ void Allocator::TrackAlloc(
   }
 }
 
+StackTraceTable* Allocator::GetBacktraceTable() {
+  StackTraceTable* backtraceTable = BacktraceTable.load(std::memory_order_acquire);
+
+  if (!backtraceTable) {
+    Lock::Locker locker(&TrackLock);
+
+    backtraceTable = BacktraceTable.load(std::memory_order_acquire);
+
+    if (!backtraceTable) {
+      // SysMemAlloc bypasses this Allocator, and so doesn't recurse into TrackAlloc.
+      void* memory = SysMemAlloc(sizeof(StackTraceTable));
+      if (memory) {
+        backtraceTable = new (memory) StackTraceTable;
+        BacktraceTable.store(backtraceTable, std::memory_order_release);
+      }
+    }
+  }
+
+  return backtraceTable;
+}
+
 bool Allocator::UntrackAlloc(const void* p) {
   if (!TrackingEnabled)
     return true; // Just assume the pointer is valid.
@@ -2250,14 +2273,20 @@ size_t Allocator::DescribeAllocation(
     if (!descriptionString.empty()) // If anything was written above...
       descriptionString += "\n";
 
-    for (size_t j = 0, jEnd = amd->Backtrace.size();
+    StackTraceTable* backtraceTable = BacktraceTable.load(std::memory_order_acquire);
+    void* backtrace[128];
+    const size_t backtraceSize = backtraceTable
+        ? backtraceTable->GetTrace(amd->BacktraceId, backtrace, OVR_ARRAY_COUNT(backtrace))
+        : 0;
+
+    for (size_t j = 0, jEnd = backtraceSize;
          (j < jEnd) && (descriptionString.length() < descriptionCapacity);
          ++j) {
       const bool shouldLookupSymbols =
           (SymbolLookupEnabled && ((amdFlags & AMFBacktraceSymbols) != 0));
       SymbolInfo symbolInfo;
 
-      if (shouldLookupSymbols && Symbols.LookupSymbol((uint64_t)amd->Backtrace[j], symbolInfo) &&
+      if (shouldLookupSymbols && Symbols.LookupSymbol((uint64_t)backtrace[j], symbolInfo) &&
           (symbolInfo.filePath[0] || symbolInfo.function[0])) {
         if (symbolInfo.filePath[0])
           snprintf(
@@ -2274,7 +2303,7 @@ size_t Allocator::DescribeAllocation(
               OVR_ARRAY_COUNT(buffer),
               "%2u: 0x%p (unknown source file): %s\n",
               (unsigned)j,
-              amd->Backtrace[j],
+              backtrace[j],
               symbolInfo.function);
       } else {
         snprintf(
@@ -2282,7 +2311,7 @@ size_t Allocator::DescribeAllocation(
             OVR_ARRAY_COUNT(buffer),
             "%2u: 0x%p (symbols unavailable)\n",
             (unsigned)j,
-            amd->Backtrace[j]);
+            backtrace[j]);
       }
 
       descriptionString += buffer;
@@ -2351,7 +2380,7 @@ size_t Allocator::TraceTrackedAllocations(AllocationTraceCallback callback, uint
     // buffer. We need more dest buffer space below.
     size_t currentStrlen = OVR_strlcat(leakReportBuffer, line, leakReportBufferSize);
 
-    if (amd.Backtrace.empty()) {
+    if (amd.BacktraceId == 0) {
       snprintf(line, OVR_ARRAY_COUNT(line), "(backtrace unavailable)\n");
       OVR_strlcat(leakReportBuffer, line, leakReportBufferSize);
     } else {
@@ -369,6 +369,7 @@ class Heap {
 };
 
 class InterceptCRTMalloc;
+class StackTraceTable;
 
 //------------------------------------------------------------------------
 // ***** SysAllocatedPointerVector, etc.
@@ -388,7 +389,7 @@ typedef std::vector<SysAllocatedString, StdAllocatorSysMem<SysAllocatedString>>
 //
 struct AllocMetadata {
   const void* Alloc; // The allocation itself.
-  SysAllocatedPointerVector Backtrace; // Array of void*
+  uint32_t BacktraceId; // Id of the backtrace in the Allocator's StackTraceTable, or 0 if none.
   SysAllocatedStringVector BacktraceSymbols; // Array of string.
   const char* File; // __FILE__ of application allocation site.
   int Line; // __LINE__ of application allocation site.
@@ -404,7 +405,7 @@ struct AllocMetadata {
 
   AllocMetadata()
       : Alloc(nullptr),
-        Backtrace(),
+        BacktraceId(0),
         File(nullptr),
         Line(0),
         TimeNs(0),
@@ -647,8 +648,10 @@ class Allocator {
       const char* file,
       int line,
       const char* tag,
-      void** backtraceArray,
-      size_t backtraceArraySize);
+      uint32_t backtraceId);
+
+  // Returns BacktraceTable, creating it if needed. Returns null if it couldn't be created.
+  StackTraceTable* GetBacktraceTable();
 
   // Add the allocation & the callstack to the tracking database.
   void TrackAlloc(const void* p, size_t size, const char* tag, const char* file, int line);
@@ -745,6 +748,8 @@ class Allocator {
   // it.
   SysAllocatedPointerVector DelayedAlignedFreeList; // "
   std::atomic_ullong CurrentCounter; // Ever-increasing count of allocation requests.
+  std::atomic<StackTraceTable*> BacktraceTable; // Backtraces of tracked allocations, created on
+  // first use. Backtraces are symbolized only when allocations are described.
   bool SymbolLookupEnabled; //
   ThreadIdToTagVectorMap TagMap; //
   OVR::Lock TagMapLock; // Thread-exclusive access to TagMap.
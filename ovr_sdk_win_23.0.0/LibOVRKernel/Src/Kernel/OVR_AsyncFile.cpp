@@ -0,0 +1,710 @@
+/************************************************************************************
+
+Filename    :   OVR_AsyncFile.cpp 
+Content     :   Asynchronous file I/O backends: io_uring and a thread pool
+Created     :   October 18, 2026
+Notes       :
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+
+#include "OVR_AsyncFile.h"
+#include "OVR_Allocator.h"
+#include "OVR_Deque.h"
+#include "OVR_UTF8Util.h"
+
+#include <errno.h>
+#include <string.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#if defined(OVR_OS_MS)
+#include "OVR_Win32_IncludeWindows.h"
+#else
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if defined(OVR_OS_LINUX) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define OVR_ASYNCFILE_IO_URING
+#endif
+#endif
+
+namespace OVR {
+
+//-----------------------------------------------------------------------------------
+// ***** Native file access
+
+static const intptr_t InvalidFileHandle = -1;
+
+#if defined(OVR_OS_MS)
+
+static int AsyncFileError(DWORD error) {
+  switch (error) {
+    case ERROR_FILE_NOT_FOUND:
+    case ERROR_PATH_NOT_FOUND:
+      return FileConstants::Error_FileNotFound;
+    case ERROR_ACCESS_DENIED:
+    case ERROR_SHARING_VIOLATION:
+    case ERROR_FILE_EXISTS:
+      return FileConstants::Error_Access;
+    case ERROR_DISK_FULL:
+    case ERROR_HANDLE_DISK_FULL:
+      return FileConstants::Error_DiskFull;
+    default:
+      return FileConstants::Error_IOError;
+  }
+}
+
+static intptr_t OpenNativeFile(const char* path, int flags, int mode, int& errorCode) {
+  OVR_UNUSED(mode);
+
+  DWORD access = 0;
+  if (flags & FileConstants::Open_Read)
+    access |= GENERIC_READ;
+  if (flags & FileConstants::Open_Write)
+    access |= GENERIC_WRITE;
+
+  DWORD disposition;
+  if ((flags & FileConstants::Open_CreateOnly) == FileConstants::Open_CreateOnly)
+    disposition = CREATE_NEW;
+  else if ((flags & FileConstants::Open_Create) && (flags & FileConstants::Open_Truncate))
+    disposition = CREATE_ALWAYS;
+  else if (flags & FileConstants::Open_Create)
+    disposition = OPEN_ALWAYS;
+  else if (flags & FileConstants::Open_Truncate)
+    disposition = TRUNCATE_EXISTING;
+  else
+    disposition = OPEN_EXISTING;
+
+  auto fileNameLength = (size_t)UTF8Util::GetLength(path) + 1;
+  wchar_t* pwFileName = (wchar_t*)OVR_ALLOC(fileNameLength * sizeof(pwFileName[0]));
+  if (!pwFileName) {
+    errorCode = FileConstants::Error_IOError;
+    return InvalidFileHandle;
+  }
+
+  HANDLE hFile = INVALID_HANDLE_VALUE;
+  auto requiredUTF8Length = OVR::UTF8Util::Strlcpy(pwFileName, fileNameLength, path);
+  if (requiredUTF8Length < fileNameLength) {
+    hFile = ::CreateFileW(
+        pwFileName,
+        access,
+        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        nullptr,
+        disposition,
+        FILE_ATTRIBUTE_NORMAL,
+        nullptr);
+  }
+  OVR_FREE(pwFileName);
+
+  if (hFile == INVALID_HANDLE_VALUE) {
+    errorCode = AsyncFileError(::GetLastError());
+    return InvalidFileHandle;
+  }
+  return (intptr_t)hFile;
+}
+
+static void CloseNativeFile(intptr_t handle) {
+  ::CloseHandle((HANDLE)handle);
+}
+
+static bool FlushNativeFile(intptr_t handle) {
+  return ::FlushFileBuffers((HANDLE)handle) != FALSE;
+}
+
+static int64_t GetNativeFileLength(intptr_t handle) {
+  LARGE_INTEGER size;
+  if (!::GetFileSizeEx((HANDLE)handle, &size))
+    return -1;
+  return size.QuadPart;
+}
+
+// Blocking positional read or write. Synchronous handles take the offset from the OVERLAPPED
+// without moving the file pointer, so requests on several threads don't interfere.
+static int TransferNativeFile(
+    intptr_t handle,
+    uint8_t* pbuffer,
+    int numBytes,
+    int64_t offset,
+    bool write,
+    int& errorCode) {
+  OVERLAPPED overlapped = {};
+  overlapped.Offset = (DWORD)offset;
+  overlapped.OffsetHigh = (DWORD)(offset >> 32);
+
+  DWORD transferred = 0;
+  BOOL result = write
+      ? ::WriteFile((HANDLE)handle, pbuffer, (DWORD)numBytes, &transferred, &overlapped)
+      : ::ReadFile((HANDLE)handle, pbuffer, (DWORD)numBytes, &transferred, &overlapped);
+  if (!result) {
+    DWORD error = ::GetLastError();
+    if (error == ERROR_HANDLE_EOF)
+      return 0;
+    errorCode = AsyncFileError(error);
+    return -1;
+  }
+  return (int)transferred;
+}
+
+#else // OVR_OS_MS
+
+static int AsyncFileError(int error) {
+  if (error == ENOENT)
+    return FileConstants::Error_FileNotFound;
+  else if (error == EACCES || error == EPERM || error == EEXIST)
+    return FileConstants::Error_Access;
+  else if (error == ENOSPC)
+    return FileConstants::Error_DiskFull;
+  else
+    return FileConstants::Error_IOError;
+}
+
+static intptr_t OpenNativeFile(const char* path, int flags, int mode, int& errorCode) {
+  int oflags = O_CLOEXEC;
+  if ((flags & FileConstants::Open_ReadWrite) == FileConstants::Open_ReadWrite)
+    oflags |= O_RDWR;
+  else if (flags & FileConstants::Open_Write)
+    oflags |= O_WRONLY;
+  else
+    oflags |= O_RDONLY;
+
+  if ((flags & FileConstants::Open_CreateOnly) == FileConstants::Open_CreateOnly)
+    oflags |= O_CREAT | O_EXCL;
+  else if (flags & FileConstants::Open_Create)
+    oflags |= O_CREAT;
+  if (flags & FileConstants::Open_Truncate)
+    oflags |= O_TRUNC;
+
+  int fd;
+  do
+    fd = ::open(path, oflags, (mode_t)mode);
+  while ((fd < 0) && (errno == EINTR));
+
+  if (fd < 0) {
+    errorCode = AsyncFileError(errno);
+    return InvalidFileHandle;
+  }
+  return (intptr_t)fd;
+}
+
+static void CloseNativeFile(intptr_t handle) {
+  ::close((int)handle);
+}
+
+static bool FlushNativeFile(intptr_t handle) {
+#if defined(OVR_OS_LINUX)
+  return ::fdatasync((int)handle) == 0;
+#else
+  return ::fsync((int)handle) == 0;
+#endif
+}
+
+static int64_t GetNativeFileLength(intptr_t handle) {
+  struct stat fileStat {};
+  if (::fstat((int)handle, &fileStat) != 0)
+    return -1;
+  return (int64_t)fileStat.st_size;
+}
+
+// Blocking positional read or write. pread and pwrite don't move the file offset, so requests
+// on several threads don't interfere.
+static int TransferNativeFile(
+    intptr_t handle,
+    uint8_t* pbuffer,
+    int numBytes,
+    int64_t offset,
+    bool write,
+    int& errorCode) {
+  int total = 0;
+  while (total < numBytes) {
+    ssize_t result = write
+        ? ::pwrite((int)handle, pbuffer + total, (size_t)(numBytes - total), offset + total)
+        : ::pread((int)handle, pbuffer + total, (size_t)(numBytes - total), offset + total);
+    if (result < 0) {
+      if (errno == EINTR)
+        continue;
+      if (total > 0)
+        break;
+      errorCode = AsyncFileError(errno);
+      return -1;
+    }
+    if (result == 0) // End of file.
+      break;
+    total += (int)result;
+  }
+  return total;
+}
+
+#endif // OVR_OS_MS
+
+//-----------------------------------------------------------------------------------
+// ***** AsyncFileBackend
+
+struct AsyncFileRequest {
+  uint64_t Id;
+  void* pUserData;
+  uint8_t* pBuffer;
+  int Size;
+  bool Write;
+  int64_t Offset;
+};
+
+// Runs the requests of an AsyncFile. AsyncFile guarantees that no more than the queue depth
+// the backend was created with are pending at once.
+class AsyncFileBackend {
+ public:
+  virtual ~AsyncFileBackend() {}
+
+  virtual bool Submit(const AsyncFileRequest& request) = 0;
+  virtual bool GetCompletion(AsyncFileCompletion& completion, unsigned delay) = 0;
+};
+
+//-----------------------------------------------------------------------------------
+// ***** ThreadPoolBackend
+//
+// Runs requests as blocking positional I/O on worker threads. A couple of threads are enough
+// to keep a disk busy without adding threads per file.
+
+class ThreadPoolBackend : public AsyncFileBackend {
+ public:
+  enum { MaxThreadCount = 2 };
+
+  ThreadPoolBackend(intptr_t handle, unsigned queueDepth)
+      : Handle(handle),
+        Requests((int)queueDepth),
+        Completions((int)queueDepth),
+        Terminated(false) {
+    unsigned threadCount = Alg::Min(queueDepth, (unsigned)MaxThreadCount);
+    for (unsigned i = 0; i < threadCount; ++i)
+      Threads[ThreadCount++] = std::thread(&ThreadPoolBackend::Run, this);
+  }
+
+  ~ThreadPoolBackend() {
+    {
+      std::lock_guard<std::mutex> lock(QueueMutex);
+      Terminated = true;
+    }
+    RequestCondition.notify_all();
+    for (unsigned i = 0; i < ThreadCount; ++i)
+      Threads[i].join();
+  }
+
+  bool IsValid() const {
+    return ThreadCount != 0;
+  }
+
+  bool Submit(const AsyncFileRequest& request) override {
+    {
+      std::lock_guard<std::mutex> lock(QueueMutex);
+      if (Requests.IsFull())
+        return false;
+      Requests.PushBack(request);
+    }
+    RequestCondition.notify_one();
+    return true;
+  }
+
+  bool GetCompletion(AsyncFileCompletion& completion, unsigned delay) override {
+    std::unique_lock<std::mutex> lock(QueueMutex);
+    if (Completions.IsEmpty() && (delay != 0)) {
+      auto ready = [this] { return !Completions.IsEmpty(); };
+      if (delay == OVR_WAIT_INFINITE)
+        CompletionCondition.wait(lock, ready);
+      else
+        CompletionCondition.wait_for(lock, std::chrono::milliseconds(delay), ready);
+    }
+    if (Completions.IsEmpty())
+      return false;
+    completion = Completions.PopFront();
+    return true;
+  }
+
+ private:
+  void Run() {
+    Thread::SetCurrentThreadName("OVR::AsyncFile");
+
+    std::unique_lock<std::mutex> lock(QueueMutex);
+    for (;;) {
+      RequestCondition.wait(lock, [this] { return Terminated || !Requests.IsEmpty(); });
+      if (Requests.IsEmpty()) // Terminated, and nothing left to do.
+        break;
+
+      AsyncFileRequest request = Requests.PopFront();
+      lock.unlock();
+
+      AsyncFileCompletion completion = {request.Id, request.pUserData, 0, 0};
+      completion.Result = TransferNativeFile(
+          Handle,
+          request.pBuffer,
+          request.Size,
+          request.Offset,
+          request.Write,
+          completion.ErrorCode);
+
+      lock.lock();
+      // Completions can't overflow, as the number of pending requests is limited to its size.
+      Completions.PushBack(completion);
+      CompletionCondition.notify_one();
+    }
+  }
+
+  intptr_t Handle;
+  std::mutex QueueMutex;
+  std::condition_variable RequestCondition;
+  std::condition_variable CompletionCondition;
+  Deque<AsyncFileRequest> Requests;
+  Deque<AsyncFileCompletion> Completions;
+  bool Terminated;
+  std::thread Threads[MaxThreadCount];
+  unsigned ThreadCount = 0;
+};
+
+#if defined(OVR_ASYNCFILE_IO_URING)
+
+//-----------------------------------------------------------------------------------
+// ***** IoUringBackend
+//
+// Hands requests to the kernel through an io_uring submission queue, and reads their results
+// from its completion queue, without any threads of our own. The ring is set up with raw
+// system calls rather than liburing, which isn't available everywhere.
+
+class IoUringBackend : public AsyncFileBackend {
+ public:
+  IoUringBackend(intptr_t handle)
+      : FileDescriptor((int)handle),
+        RingDescriptor(-1),
+        pSqRing(MAP_FAILED),
+        SqRingSize(0),
+        pCqRing(MAP_FAILED),
+        CqRingSize(0),
+        pSqes((io_uring_sqe*)MAP_FAILED),
+        SqesSize(0) {}
+
+  ~IoUringBackend() {
+    if (pSqes != MAP_FAILED)
+      ::munmap(pSqes, SqesSize);
+    if ((pCqRing != MAP_FAILED) && (pCqRing != pSqRing))
+      ::munmap(pCqRing, CqRingSize);
+    if (pSqRing != MAP_FAILED)
+      ::munmap(pSqRing, SqRingSize);
+    if (RingDescriptor >= 0)
+      ::close(RingDescriptor);
+  }
+
+  // Returns false if io_uring isn't supported by the kernel or is disallowed, as it is in some
+  // containers.
+  bool Init(unsigned queueDepth) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    RingDescriptor = (int)::syscall(__NR_io_uring_setup, queueDepth, &params);
+    if (RingDescriptor < 0)
+      return false;
+
+    // IORING_OP_READ and IORING_OP_WRITE arrived in Linux 5.6, along with this feature flag.
+    if (!(params.features & IORING_FEAT_RW_CUR_POS))
+      return false;
+
+    SqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    CqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMap)
+      SqRingSize = CqRingSize = Alg::Max(SqRingSize, CqRingSize);
+
+    pSqRing = ::mmap(
+        nullptr,
+        SqRingSize,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        RingDescriptor,
+        IORING_OFF_SQ_RING);
+    if (pSqRing == MAP_FAILED)
+      return false;
+
+    pCqRing = singleMap ? pSqRing
+                        : ::mmap(
+                              nullptr,
+                              CqRingSize,
+                              PROT_READ | PROT_WRITE,
+                              MAP_SHARED | MAP_POPULATE,
+                              RingDescriptor,
+                              IORING_OFF_CQ_RING);
+    if (pCqRing == MAP_FAILED)
+      return false;
+
+    SqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    pSqes = (io_uring_sqe*)::mmap(
+        nullptr,
+        SqesSize,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE,
+        RingDescriptor,
+        IORING_OFF_SQES);
+    if (pSqes == MAP_FAILED)
+      return false;
+
+    uint8_t* sq = (uint8_t*)pSqRing;
+    pSqTail = (unsigned*)(sq + params.sq_off.tail);
+    SqMask = *(unsigned*)(sq + params.sq_off.ring_mask);
+    pSqArray = (unsigned*)(sq + params.sq_off.array);
+
+    uint8_t* cq = (uint8_t*)pCqRing;
+    pCqHead = (unsigned*)(cq + params.cq_off.head);
+    pCqTail = (unsigned*)(cq + params.cq_off.tail);
+    CqMask = *(unsigned*)(cq + params.cq_off.ring_mask);
+    pCqes = (io_uring_cqe*)(cq + params.cq_off.cqes);
+
+    // The user data of a submission is the index of the slot holding its request.
+    Slots.Resize(queueDepth);
+    FreeSlots.Resize(queueDepth);
+    for (unsigned i = 0; i < queueDepth; ++i)
+      FreeSlots[i] = queueDepth - 1 - i;
+    return true;
+  }
+
+  bool Submit(const AsyncFileRequest& request) override {
+    if (FreeSlots.GetSize() == 0)
+      return false;
+    const unsigned slot = FreeSlots.Back();
+
+    // The kernel consumes submissions during io_uring_enter, so the queue is empty here
+    // and only this thread writes its tail.
+    const unsigned tail = *pSqTail;
+    const unsigned index = tail & SqMask;
+    io_uring_sqe* sqe = &pSqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = request.Write ? IORING_OP_WRITE : IORING_OP_READ;
+    sqe->fd = FileDescriptor;
+    sqe->off = (uint64_t)request.Offset;
+    sqe->addr = (uint64_t)(uintptr_t)request.pBuffer;
+    sqe->len = (uint32_t)request.Size;
+    sqe->user_data = slot;
+    pSqArray[index] = index;
+    __atomic_store_n(pSqTail, tail + 1, __ATOMIC_RELEASE);
+
+    int result;
+    do
+      result = (int)::syscall(__NR_io_uring_enter, RingDescriptor, 1, 0, 0, nullptr, 0);
+    while ((result < 0) && (errno == EINTR));
+
+    if (result != 1) {
+      // Not consumed, so it can be taken back.
+      __atomic_store_n(pSqTail, tail, __ATOMIC_RELEASE);
+      return false;
+    }
+
+    Slots[slot] = request;
+    FreeSlots.PopBack();
+    return true;
+  }
+
+  bool GetCompletion(AsyncFileCompletion& completion, unsigned delay) override {
+    for (;;) {
+      const unsigned head = *pCqHead;
+      if (head != __atomic_load_n(pCqTail, __ATOMIC_ACQUIRE)) {
+        const io_uring_cqe* cqe = &pCqes[head & CqMask];
+        const unsigned slot = (unsigned)cqe->user_data;
+        const int result = cqe->res;
+        __atomic_store_n(pCqHead, head + 1, __ATOMIC_RELEASE);
+
+        completion.RequestId = Slots[slot].Id;
+        completion.pUserData = Slots[slot].pUserData;
+        completion.Result = (result < 0) ? -1 : result;
+        completion.ErrorCode = (result < 0) ? AsyncFileError(-result) : 0;
+        FreeSlots.PushBack(slot);
+        return true;
+      }
+
+      if (delay == 0)
+        return false;
+
+      // The ring descriptor polls readable while the completion queue isn't empty.
+      pollfd ring = {RingDescriptor, POLLIN, 0};
+      int timeout = (delay == OVR_WAIT_INFINITE) ? -1 : (int)Alg::Min(delay, (unsigned)INT_MAX);
+      int result = ::poll(&ring, 1, timeout);
+      if ((result == 0) || ((result < 0) && (errno != EINTR)))
+        delay = 0; // Timed out; check once more.
+    }
+  }
+
+ private:
+  int FileDescriptor;
+  int RingDescriptor;
+  void* pSqRing;
+  size_t SqRingSize;
+  void* pCqRing;
+  size_t CqRingSize;
+  io_uring_sqe* pSqes;
+  size_t SqesSize;
+
+  unsigned* pSqTail;
+  unsigned SqMask;
+  unsigned* pSqArray;
+  unsigned* pCqHead;
+  unsigned* pCqTail;
+  unsigned CqMask;
+  io_uring_cqe* pCqes;
+
+  ArrayPOD<AsyncFileRequest> Slots;
+  ArrayPOD<unsigned> FreeSlots;
+};
+
+#endif // OVR_ASYNCFILE_IO_URING
+
+//-----------------------------------------------------------------------------------
+// ***** AsyncFile
+
+AsyncFile::AsyncFile(
+    const char* pfileName,
+    int flags,
+    int mode,
+    unsigned queueDepth,
+    BackendType backend)
+    : FilePath(pfileName),
+      pBackend(nullptr),
+      Backend(Backend_ThreadPool),
+      Handle(InvalidFileHandle),
+      QueueDepth(Alg::Max(queueDepth, 1u)),
+      PendingCount(0),
+      NextRequestId(1),
+      ErrorCode(0),
+      Valid(false) {
+  Handle = OpenNativeFile(pfileName, flags, mode, ErrorCode);
+  if (Handle == InvalidFileHandle)
+    return;
+
+#if defined(OVR_ASYNCFILE_IO_URING)
+  if (backend != Backend_ThreadPool) {
+    IoUringBackend* ring = new IoUringBackend(Handle);
+    if (ring->Init(QueueDepth)) {
+      pBackend = ring;
+      Backend = Backend_IoUring;
+    } else {
+      delete ring;
+    }
+  }
+#else
+  OVR_UNUSED(backend);
+#endif
+
+  if (!pBackend) {
+    ThreadPoolBackend* pool = new ThreadPoolBackend(Handle, QueueDepth);
+    if (pool->IsValid()) {
+      pBackend = pool;
+    } else {
+      delete pool;
+      CloseNativeFile(Handle);
+      Handle = InvalidFileHandle;
+      ErrorCode = Error_IOError;
+      return;
+    }
+  }
+
+  Valid = true;
+}
+
+AsyncFile::~AsyncFile() {
+  Close();
+}
+
+int64_t AsyncFile::LGetLength() {
+  return Valid ? GetNativeFileLength(Handle) : -1;
+}
+
+uint64_t AsyncFile::SubmitRead(uint8_t* pbuffer, int numBytes, int64_t offset, void* userData) {
+  return Submit(pbuffer, numBytes, offset, userData, false);
+}
+
+uint64_t
+AsyncFile::SubmitWrite(const uint8_t* pbuffer, int numBytes, int64_t offset, void* userData) {
+  return Submit(const_cast<uint8_t*>(pbuffer), numBytes, offset, userData, true);
+}
+
+uint64_t
+AsyncFile::Submit(uint8_t* pbuffer, int numBytes, int64_t offset, void* userData, bool write) {
+  if (!Valid || (numBytes < 0) || (offset < 0) || (PendingCount >= QueueDepth))
+    return 0;
+
+  AsyncFileRequest request = {NextRequestId, userData, pbuffer, numBytes, write, offset};
+  if (!pBackend->Submit(request))
+    return 0;
+
+  ++PendingCount;
+  return NextRequestId++;
+}
+
+bool AsyncFile::GetCompletion(AsyncFileCompletion& completion, unsigned delay) {
+  if (Collected.GetSize() != 0) {
+    completion = Collected[0];
+    Collected.RemoveAt(0);
+    --PendingCount;
+    return true;
+  }
+
+  // With nothing pending, an infinite wait would never end.
+  if (!Valid || (PendingCount == 0))
+    return false;
+
+  if (!pBackend->GetCompletion(completion, delay))
+    return false;
+
+  --PendingCount;
+  return true;
+}
+
+bool AsyncFile::WaitIdle() {
+  AsyncFileCompletion completion;
+  while (Collected.GetSize() < PendingCount) {
+    if (!pBackend->GetCompletion(completion, OVR_WAIT_INFINITE))
+      return false;
+    Collected.PushBack(completion);
+  }
+  return true;
+}
+
+bool AsyncFile::Flush() {
+  if (!Valid || !WaitIdle())
+    return false;
+  return FlushNativeFile(Handle);
+}
+
+bool AsyncFile::Close() {
+  if (!Valid)
+    return false;
+
+  WaitIdle();
+  delete pBackend;
+  pBackend = nullptr;
+  CloseNativeFile(Handle);
+  Handle = InvalidFileHandle;
+  Collected.Clear();
+  PendingCount = 0;
+  Valid = false;
+  return true;
+}
+
+} // namespace OVR
@@ -0,0 +1,156 @@
+/************************************************************************************
+
+Filename    :   OVR_AsyncFile.h   
+Content     :   Asynchronous file I/O with submit/complete semantics
+Created     :   October 18, 2026
+Notes       :
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+
+#ifndef OVR_AsyncFile_h
+#define OVR_AsyncFile_h
+
+#include "OVR_Array.h"
+#include "OVR_File.h"
+#include "OVR_RefCount.h"
+#include "OVR_String.h"
+#include "OVR_Threads.h"
+#include "OVR_Types.h"
+
+namespace OVR {
+
+class AsyncFileBackend;
+
+// Result of a request submitted to an AsyncFile, returned by GetCompletion.
+struct AsyncFileCompletion {
+  uint64_t RequestId; // As returned by SubmitRead or SubmitWrite.
+  void* pUserData; // As passed to SubmitRead or SubmitWrite.
+  int Result; // Bytes transferred, or -1 on error. Reads at the end of the file can be short.
+  int ErrorCode; // FileConstants::Error_* if Result is -1, otherwise 0.
+};
+
+//-----------------------------------------------------------------------------------
+// ***** AsyncFile
+//
+// File with asynchronous positional reads and writes, for callers which can't afford to block
+// on the disk, such as threads writing out recordings. Requests are submitted with the buffer
+// and file offset to use and return immediately; their results are collected later with
+// GetCompletion, in the order they finish, which isn't necessarily the order they were
+// submitted in. Buffers must stay valid and untouched until their request completes.
+//
+// On Linux the requests are handed to the kernel through io_uring. Elsewhere, or where
+// io_uring isn't available, they are run on a small pool of worker threads doing blocking
+// positional I/O. GetBackend tells which one is in use.
+//
+// An AsyncFile is meant to be used from one thread at a time. At most QueueDepth requests
+// can be pending at once; when the queue is full, Submit calls fail until a completion is
+// collected.
+//
+// Example usage:
+//     Ptr<AsyncFile> file = *new AsyncFile(path, File::Open_Write | File::Open_Create);
+//     file->SubmitWrite(block, blockSize, offset, block);
+//     ...
+//     AsyncFileCompletion completion;
+//     while (file->GetCompletion(completion))
+//       ReleaseBlock(completion.pUserData);
+
+class AsyncFile : public RefCountBase<AsyncFile>, public FileConstants {
+ public:
+  enum BackendType {
+    Backend_Default, // io_uring where available, otherwise the thread pool.
+    Backend_IoUring,
+    Backend_ThreadPool
+  };
+
+  enum { DefaultQueueDepth = 32 };
+
+  // pfileName should be encoded as UTF-8 to support international file names. flags are
+  // FileConstants::OpenFlags, and mode is the FileConstants::Modes for a created file.
+  AsyncFile(
+      const char* pfileName,
+      int flags = Open_Read,
+      int mode = Mode_ReadWrite,
+      unsigned queueDepth = DefaultQueueDepth,
+      BackendType backend = Backend_Default);
+  ~AsyncFile(); // Waits for pending requests to finish.
+
+  bool IsValid() const {
+    return Valid;
+  }
+  int GetErrorCode() const {
+    return ErrorCode;
+  }
+  const char* GetFilePath() const {
+    return FilePath.ToCStr();
+  }
+
+  // The backend actually in use. Backend_IoUring requested where it's unavailable falls back
+  // to Backend_ThreadPool.
+  BackendType GetBackend() const {
+    return Backend;
+  }
+
+  int64_t LGetLength();
+
+  // Queues a read of numBytes at offset into pbuffer, or a write of numBytes from pbuffer at
+  // offset. Returns the request id, or 0 if the file isn't valid or the queue is full.
+  uint64_t SubmitRead(uint8_t* pbuffer, int numBytes, int64_t offset, void* userData = nullptr);
+  uint64_t
+  SubmitWrite(const uint8_t* pbuffer, int numBytes, int64_t offset, void* userData = nullptr);
+
+  // Returns a finished request, waiting up to delay milliseconds for one; OVR_WAIT_INFINITE
+  // waits as long as any request is pending. Returns false if none finished in time.
+  bool GetCompletion(AsyncFileCompletion& completion, unsigned delay = 0);
+
+  // Number of requests submitted whose completion hasn't been collected yet.
+  unsigned GetPendingCount() const {
+    return PendingCount;
+  }
+
+  // Waits for all pending requests to finish and commits written data to the disk. The
+  // completions remain to be collected. Returns false if that fails.
+  bool Flush();
+
+  // Waits for all pending requests to finish and closes the file. Uncollected completions are
+  // discarded.
+  bool Close();
+
+ private:
+  uint64_t Submit(uint8_t* pbuffer, int numBytes, int64_t offset, void* userData, bool write);
+  bool WaitIdle();
+
+  String FilePath;
+  AsyncFileBackend* pBackend;
+  BackendType Backend;
+  intptr_t Handle; // File descriptor or HANDLE.
+  unsigned QueueDepth;
+  unsigned PendingCount;
+  uint64_t NextRequestId;
+  ArrayPOD<AsyncFileCompletion> Collected; // Completions collected by Flush.
+  int ErrorCode;
+  bool Valid;
+
+  OVR_NON_COPYABLE(AsyncFile);
+};
+
+} // namespace OVR
+
+#endif // OVR_AsyncFile_h
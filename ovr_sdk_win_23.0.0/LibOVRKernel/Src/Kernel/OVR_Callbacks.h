@@ -39,7 +39,8 @@ namespace OVR {
 // CallbackEmitter
 //
 // Emitter of callbacks.
-// Thread-safety: All public members may be safely called concurrently.
+// Thread-safety: All public members may be safely called concurrently. Call() takes no
+// emitter-wide lock, so calls proceed while listeners are being added or removed.
 template <class DelegateT>
 class CallbackEmitter : public NewOverrideBase {
  public:
@@ -165,7 +166,7 @@ bool CallbackEmitter<DelegateT>::AddListener(CallbackListener<DelegateT>* listen
 
 template <class DelegateT>
 int CallbackEmitter<DelegateT>::GetListenerCount() const {
-  return Emitter->Listeners.GetSizeI();
+  return Emitter->GetListenerCount();
 }
 
 template <class DelegateT>
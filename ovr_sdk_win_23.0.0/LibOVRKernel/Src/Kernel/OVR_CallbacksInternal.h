@@ -33,9 +33,7 @@ limitations under the License.
 #include "OVR_Delegates.h"
 #include "OVR_RefCount.h"
 
-#if !defined(OVR_CC_MSVC) || (OVR_CC_VERSION > 1600) // Newer than VS2010
 #include <atomic>
-#endif
 
 namespace OVR {
 
@@ -51,44 +49,42 @@ class CallbackListener;
 //-----------------------------------------------------------------------------
 // FloatingCallbackEmitter
 //
-// The Call() function is not thread-safe.
-// TBD: Should we add a thread-safe Call() option to constructor?
-
-class CallbackEmitterBase {
- protected:
-  static Lock* GetEmitterLock();
-};
+// Listeners are published to Call() as immutable snapshots, RCU style. Adding or removing a
+// listener builds a new snapshot under the emitter's own lock and swaps it in atomically, so
+// Call() never takes a lock besides each listener's own, and emitters don't contend with one
+// another.
+//
+// A snapshot that has been swapped out may still be iterated by calls already in flight, so
+// it is retired rather than freed. Calls count themselves in ActiveCalls around their use of
+// a snapshot, and retired snapshots are freed by the next writer to see no calls in flight,
+// or by the destructor.
 
 template <class DelegateT>
-class FloatingCallbackEmitter : public CallbackEmitterBase,
-                                public RefCountBase<FloatingCallbackEmitter<DelegateT>> {
+class FloatingCallbackEmitter : public RefCountBase<FloatingCallbackEmitter<DelegateT>> {
   friend class CallbackEmitter<DelegateT>;
 
   FloatingCallbackEmitter()
       : IsShutdown(false),
-#if !defined(OVR_CC_MSVC) || (OVR_CC_VERSION > 1600) // Newer than VS2010
         ListenersExist(false),
-#endif
-        DirtyListenersCache(0) {
-  }
+        Snapshot(nullptr),
+        ActiveCalls(0),
+        RetiredSnapshots(nullptr) {}
 
  public:
   typedef Array<Ptr<FloatingCallbackListener<DelegateT>>> ListenerPtrArray;
 
   ~FloatingCallbackEmitter() {
     OVR_ASSERT(Listeners.GetSizeI() == 0);
-    // ListenersCache will be emptied here.
+    OVR_ASSERT(ActiveCalls.load() == 0);
+    delete Snapshot.load(std::memory_order_relaxed);
+    freeRetiredSnapshots();
   }
 
   bool AddListener(FloatingCallbackListener<DelegateT>* listener);
   bool HasListeners() const {
-#if !defined(OVR_CC_MSVC) || (OVR_CC_VERSION > 1600) // Newer than VS2010
     return ListenersExist.load(std::memory_order_relaxed);
-#else
-    // This code still has a data race
-    return (Listeners.GetSizeI() > 0);
-#endif
   }
+  int GetListenerCount() const;
   void Shutdown();
 
   // Called from the listener object as it is transitioning to canceled state.
@@ -117,54 +113,75 @@ class FloatingCallbackEmitter : public CallbackEmitterBase,
   void Call(Param1& p1, Param2& p2, Param3& p3);
 
  protected:
+  // Immutable copy of Listeners, as seen by Call().
+  struct ListenerSnapshot : public NewOverrideBase {
+    ListenerPtrArray Listeners;
+    ListenerSnapshot* pNextRetired;
+  };
+
+  // Serializes changes to the listeners. Call() doesn't take it.
+  mutable Lock EmitterLock;
+
   // Is the emitter shut down?  This prevents more listeners from being added during shutdown.
   bool IsShutdown;
 
-  // Array of added listeners.
+  // Array of added listeners. Only accessed with EmitterLock held.
   ListenerPtrArray Listeners;
 
-#if !defined(OVR_CC_MSVC) || (OVR_CC_VERSION > 1600) // Newer than VS2010
   std::atomic<bool> ListenersExist;
-#endif
 
-  // Is the cache dirty?  This avoids locking and memory allocation in steady state.
-  std::atomic<uint32_t> DirtyListenersCache = {0};
+  // Current snapshot of Listeners, or null if there are none.
+  std::atomic<ListenerSnapshot*> Snapshot;
 
-  // Cache of listeners used by the Call() function.
-  ListenerPtrArray ListenersCacheForCalls;
+  // Number of Call()s which may be using a snapshot.
+  std::atomic<int> ActiveCalls;
 
-  // Update the ListenersCache array in response to an insertion or removal.
-  // This is how AddListener() insertions get rolled into the listeners array.
-  // This is how RemoveListener() removals get purged from the cache.
-  void updateListenersCache() {
-    if (DirtyListenersCache != 0) {
-      Lock::Locker locker(GetEmitterLock());
+  // Snapshots which have been swapped out, but may still be in use by calls in flight.
+  // Only accessed with EmitterLock held.
+  ListenerSnapshot* RetiredSnapshots;
 
-      // TBD: Should memory allocation be further reduced here?
-      ListenersCacheForCalls = Listeners;
-      DirtyListenersCache = 0;
+  // Publishes a new snapshot of Listeners, after an insertion or removal.
+  // EmitterLock must be held.
+  void noLockPublishSnapshot() {
+    ListenerSnapshot* snapshot = nullptr;
+    if (Listeners.GetSizeI() > 0) {
+      snapshot = new ListenerSnapshot;
+      snapshot->Listeners = Listeners;
+      snapshot->pNextRetired = nullptr;
     }
+
+    // Sequentially consistent, so that a call which starts after the ActiveCalls check below
+    // is ordered after the exchange, and can only see the new snapshot.
+    ListenerSnapshot* oldSnapshot = Snapshot.exchange(snapshot);
+    if (oldSnapshot) {
+      oldSnapshot->pNextRetired = RetiredSnapshots;
+      RetiredSnapshots = oldSnapshot;
+    }
+
+    if (ActiveCalls.load() == 0)
+      freeRetiredSnapshots();
+
+    ListenersExist.store(snapshot != nullptr, std::memory_order_relaxed);
   }
 
-  // Without holding a lock, find and remove the given listener from the array of listeners.
+  void freeRetiredSnapshots() {
+    while (RetiredSnapshots) {
+      ListenerSnapshot* next = RetiredSnapshots->pNextRetired;
+      delete RetiredSnapshots;
+      RetiredSnapshots = next;
+    }
+  }
+
+  // With EmitterLock held, find and remove the given listener from the array of listeners.
   void noLockFindAndRemoveListener(FloatingCallbackListener<DelegateT>* listener) {
     const int count = Listeners.GetSizeI();
     for (int i = 0; i < count; ++i) {
       if (Listeners[i] == listener) {
         Listeners.RemoveAt(i);
-
-        // After removing it from the array, set the dirty flag.
-        // Note: Because the flag is atomic, a portable memory fence is implied.
-        DirtyListenersCache = 1;
-
+        noLockPublishSnapshot();
         break;
       }
     }
-#if !defined(OVR_CC_MSVC) || (OVR_CC_VERSION > 1600) // Newer than VS2010
-    if (Listeners.GetSizeI() < 1) {
-      ListenersExist.store(false, std::memory_order_relaxed);
-    }
-#endif
   }
 };
 
@@ -199,32 +216,31 @@ class FloatingCallbackListener : public RefCountBase<FloatingCallbackListener<De
 template <class DelegateT>
 bool FloatingCallbackEmitter<DelegateT>::AddListener(
     FloatingCallbackListener<DelegateT>* listener) {
-  Lock::Locker locker(GetEmitterLock());
+  Lock::Locker locker(&EmitterLock);
 
   if (IsShutdown) {
     return false;
   }
 
-  // Add the listener to our list
+  // Add the listener to our list, and publish it to Call()
   Listeners.PushBack(listener);
-
-  // After adding it to the array, set the dirty flag.
-  // Note: Because the flag is atomic, a portable memory fence is implied.
-  DirtyListenersCache = 1;
-
-#if !defined(OVR_CC_MSVC) || (OVR_CC_VERSION > 1600) // Newer than VS2010
-  ListenersExist.store(true, std::memory_order_relaxed);
-#endif
+  noLockPublishSnapshot();
 
   return true;
 }
 
+template <class DelegateT>
+int FloatingCallbackEmitter<DelegateT>::GetListenerCount() const {
+  Lock::Locker locker(&EmitterLock);
+  return Listeners.GetSizeI();
+}
+
 // Called from the listener object as it is transitioning to canceled state.
 // The listener's mutex is not held during this call.
 template <class DelegateT>
 void FloatingCallbackEmitter<DelegateT>::OnListenerCancel(
     FloatingCallbackListener<DelegateT>* listener) {
-  Lock::Locker locker(GetEmitterLock());
+  Lock::Locker locker(&EmitterLock);
 
   // If not shut down,
   // Note that if it is shut down then there will be no listeners in the array.
@@ -236,38 +252,36 @@ void FloatingCallbackEmitter<DelegateT>::OnListenerCancel(
 
 template <class DelegateT>
 void FloatingCallbackEmitter<DelegateT>::Shutdown() {
-  Lock::Locker locker(GetEmitterLock());
+  Lock::Locker locker(&EmitterLock);
 
   IsShutdown = true;
 
   Listeners.ClearAndRelease();
-
-  // Note: Because the flag is atomic, a portable memory fence is implied.
-  DirtyListenersCache = 1;
-
-#if !defined(OVR_CC_MSVC) || (OVR_CC_VERSION > 1600) // Newer than VS2010
-  ListenersExist.store(false, std::memory_order_relaxed);
-#endif
+  noLockPublishSnapshot();
 }
 
 //-----------------------------------------------------------------------------
 // Call function
 //
-// (1) Update the cache of listener references, if it has changed.
+// (1) Announce the call, and take the current snapshot of listener references.
 // (2) For each listener,
 //    (a) Hold ListenerLock.
 //    (b) If listener handler is valid, call the handler.
-#define OVR_EMITTER_CALL_BODY(params)                                               \
-  updateListenersCache();                                                           \
-  if (IsShutdown)                                                                   \
-    return; /* Pure optimization.  It is fine if this races. */                     \
-  const int count = ListenersCacheForCalls.GetSizeI();                              \
-  for (int i = 0; i < count; ++i) {                                                 \
-    Lock::Locker locker(&ListenersCacheForCalls[i]->ListenerLock);                  \
-    if (ListenersCacheForCalls[i]->Handler.IsValid()) {                             \
-      ListenersCacheForCalls[i]->Handler params; /* Using a macro for this line. */ \
-    }                                                                               \
-  }
+// (3) Announce the end of the call, after which the snapshot may be freed.
+#define OVR_EMITTER_CALL_BODY(params)                                                  \
+  ActiveCalls.fetch_add(1);                                                            \
+  const ListenerSnapshot* snapshot = Snapshot.load();                                  \
+  if (snapshot) {                                                                      \
+    const int count = snapshot->Listeners.GetSizeI();                                  \
+    for (int i = 0; i < count; ++i) {                                                  \
+      FloatingCallbackListener<DelegateT>* listener = snapshot->Listeners[i].GetPtr(); \
+      Lock::Locker locker(&listener->ListenerLock);                                    \
+      if (listener->Handler.IsValid()) {                                               \
+        listener->Handler params; /* Using a macro for this line. */                   \
+      }                                                                                \
+    }                                                                                  \
+  }                                                                                    \
+  ActiveCalls.fetch_sub(1, std::memory_order_release);
 
 template <class DelegateT>
 void FloatingCallbackEmitter<DelegateT>::Call() {
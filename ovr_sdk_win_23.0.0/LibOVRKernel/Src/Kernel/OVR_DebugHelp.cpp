@@ -99,6 +99,10 @@ struct THREAD_BASIC_INFORMATION {
 #include <execinfo.h>
 #endif
 #include <cxxabi.h>
+#include <dlfcn.h>
+#if defined(OVR_OS_LINUX)
+#include <link.h>
+#endif
 //#include <libunwind.h> // Can't use this until we can ensure that we have an installed version of
 // it.
 #endif
@@ -1711,9 +1715,11 @@ size_t SymbolLookup::GetBacktraceFromThreadHandle(
             &context)) // This is supposed to ensure that the thread really is stopped.
     {
       count = GetBacktrace(addressArray, addressArrayCapacity, skipCount, &context, threadSysId);
-      suspendResult = ::ResumeThread(threadHandle);
-      OVR_ASSERT_AND_UNUSED(suspendResult != (DWORD)-1, suspendResult);
     }
+
+    // The thread must be resumed even if its context couldn't be read.
+    suspendResult = ::ResumeThread(threadHandle);
+    OVR_ASSERT_AND_UNUSED(suspendResult != (DWORD)-1, suspendResult);
   }
 
   return count;
@@ -1753,6 +1759,137 @@ size_t SymbolLookup::GetBacktraceFromThreadSysId(
 #endif
 }
 
+#if (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(OVR_CPU_X86) || defined(OVR_CPU_X86_64) || defined(__aarch64__))
+#define OVR_FRAME_POINTER_BACKTRACE
+
+// A chain is abandoned where a caller's frame is this far above its callee's. Code which uses
+// the frame pointer register for other values can leave anything in it, so this only catches
+// some of those values; the bound on the stack's top is what keeps the walk within the stack.
+static const uintptr_t MaxStackFrameSize = 256 * 1024;
+
+// On x86, x86-64 and AArch64 a frame pointer points to the caller's frame pointer, which is
+// followed by the return address. The stack grows down, so each frame must be above the last,
+// and below stackTop.
+static size_t WalkFramePointers(
+    void* addressArray[],
+    size_t addressArrayCapacity,
+    size_t skipCount,
+    uintptr_t framePointer,
+    uintptr_t stackPointer,
+    uintptr_t stackTop) {
+  size_t frameIndex = 0;
+  uintptr_t minFramePointer = stackPointer;
+
+  while (frameIndex < addressArrayCapacity) {
+    if ((framePointer < minFramePointer) ||
+        ((framePointer - minFramePointer) > MaxStackFrameSize) ||
+        (framePointer > stackTop - (2 * sizeof(void*))) ||
+        (framePointer & (sizeof(void*) - 1)))
+      break;
+
+    const uintptr_t* frame = (const uintptr_t*)framePointer;
+    const uintptr_t returnAddress = frame[1];
+
+    if (returnAddress == 0)
+      break;
+
+    if (skipCount)
+      --skipCount;
+    else
+      addressArray[frameIndex++] = (void*)returnAddress;
+
+    minFramePointer = framePointer + (2 * sizeof(void*));
+    framePointer = frame[0];
+  }
+
+  return frameIndex;
+}
+
+// Returns the top of the current thread's stack, or 0 if it can't be found. It's looked up on
+// the thread's first call, which may allocate memory, and cached.
+static uintptr_t GetCurrentStackTop() {
+  static OVR_THREAD_LOCAL uintptr_t stackTop = 0;
+  static OVR_THREAD_LOCAL bool lookedUp = false;
+
+  if (!lookedUp) {
+    // Set first, as an allocation made by the lookup may capture a backtrace itself.
+    lookedUp = true;
+
+#if defined(OVR_OS_MAC)
+    stackTop = (uintptr_t)pthread_get_stackaddr_np(pthread_self());
+#else
+    pthread_attr_t attr;
+    if (pthread_getattr_np(pthread_self(), &attr) == 0) {
+      void* stackAddr = nullptr;
+      size_t stackSize = 0;
+      if (pthread_attr_getstack(&attr, &stackAddr, &stackSize) == 0)
+        stackTop = (uintptr_t)stackAddr + stackSize;
+      pthread_attr_destroy(&attr);
+    }
+#endif
+  }
+
+  return stackTop;
+}
+#endif
+
+OVR_NO_INLINE size_t SymbolLookup::CaptureBacktrace(
+    void* addressArray[],
+    size_t addressArrayCapacity,
+    size_t skipCount) {
+#if defined(OVR_OS_MS)
+  // The first address RtlCaptureStackBackTrace returns is in this function.
+  return RtlCaptureStackBackTrace(
+      (DWORD)(skipCount + 1), (ULONG)addressArrayCapacity, addressArray, nullptr);
+
+#elif defined(OVR_FRAME_POINTER_BACKTRACE)
+  // Using __builtin_frame_address makes the compiler set up this function's frame pointer,
+  // whatever the compiler options.
+  const uintptr_t framePointer = (uintptr_t)__builtin_frame_address(0);
+  const uintptr_t stackTop = GetCurrentStackTop();
+  if (!stackTop)
+    return 0;
+  return WalkFramePointers(
+      addressArray, addressArrayCapacity, skipCount, framePointer, framePointer, stackTop);
+
+#else
+  OVR_UNUSED(addressArray);
+  OVR_UNUSED(addressArrayCapacity);
+  OVR_UNUSED(skipCount);
+  return 0;
+#endif
+}
+
+size_t SymbolLookup::CaptureBacktraceFromFrame(
+    void* addressArray[],
+    size_t addressArrayCapacity,
+    void* pc,
+    void* framePointer,
+    void* stackPointer,
+    void* stackTop) {
+  size_t frameIndex = 0;
+
+  if (pc && (frameIndex < addressArrayCapacity))
+    addressArray[frameIndex++] = pc;
+
+#if defined(OVR_FRAME_POINTER_BACKTRACE)
+  frameIndex += WalkFramePointers(
+      addressArray + frameIndex,
+      addressArrayCapacity - frameIndex,
+      0,
+      (uintptr_t)framePointer,
+      (uintptr_t)stackPointer,
+      stackTop ? (uintptr_t)stackTop : UINTPTR_MAX);
+#else
+  OVR_UNUSED(framePointer);
+  OVR_UNUSED(stackPointer);
+  OVR_UNUSED(stackTop);
+#endif
+
+  return frameIndex;
+}
+
 // We need to return the required moduleInfoArrayCapacity.
 size_t SymbolLookup::GetModuleInfoArray(
     ModuleInfo* pModuleInfoArray,
@@ -1811,6 +1948,56 @@ size_t SymbolLookup::GetModuleInfoArray(
       }
     }
   }
+#elif defined(OVR_OS_LINUX)
+  struct ModuleListContext {
+    ModuleInfo* pModuleInfoArray;
+    size_t moduleInfoArrayCapacity;
+    size_t moduleCountRequired;
+    size_t moduleCount;
+  } context = {pModuleInfoArray, moduleInfoArrayCapacity, 0, 0};
+
+  dl_iterate_phdr(
+      [](struct dl_phdr_info* info, size_t, void* data) -> int {
+        ModuleListContext* pContext = (ModuleListContext*)data;
+        ++pContext->moduleCountRequired;
+
+        if (pContext->moduleCount >= pContext->moduleInfoArrayCapacity)
+          return 0;
+
+        // The module spans its loadable segments.
+        uint64_t low = UINT64_MAX;
+        uint64_t high = 0;
+        for (int i = 0; i < (int)info->dlpi_phnum; i++) {
+          const ElfW(Phdr)& phdr = info->dlpi_phdr[i];
+          if (phdr.p_type == PT_LOAD) {
+            low = MIN(low, (uint64_t)phdr.p_vaddr);
+            high = MAX(high, (uint64_t)(phdr.p_vaddr + phdr.p_memsz));
+          }
+        }
+        if (low >= high)
+          return 0;
+
+        ModuleInfo& moduleInfo = pContext->pModuleInfoArray[pContext->moduleCount++];
+        moduleInfo = ModuleInfo();
+        moduleInfo.baseAddress = info->dlpi_addr + low;
+        moduleInfo.size = (high - low);
+
+        // The executable is listed first, with an empty name.
+        if (info->dlpi_name && info->dlpi_name[0])
+          OVR_strlcpy(moduleInfo.filePath, info->dlpi_name, OVR_ARRAY_COUNT(moduleInfo.filePath));
+        else
+          GetCurrentProcessFilePath(moduleInfo.filePath, OVR_ARRAY_COUNT(moduleInfo.filePath));
+
+        OVR_strlcpy(
+            moduleInfo.name,
+            GetFileNameFromPath(moduleInfo.filePath),
+            OVR_ARRAY_COUNT(moduleInfo.name));
+        return 0;
+      },
+      &context);
+
+  moduleCountRequired = context.moduleCountRequired;
+  moduleCount = context.moduleCount;
 #else
   OVR_UNUSED(pModuleInfoArray);
   OVR_UNUSED(moduleInfoArrayCapacity);
@@ -2172,14 +2359,32 @@ bool SymbolLookup::LookupSymbols(
   }
 
 #else
-  // We can use libunwind's unw_get_proc_name to try to get function name info. It can work
-  // regardless of relocation.
-  // Use backtrace_symbols and addr2line. Need to watch out for module load-time relocation.
-  // Ned to pass the -rdynamic flag to the linker. It will cause the linker to out in the link
-  // tables the name of all the none static functions in your code, not just the exported ones.
-  OVR_UNUSED(addressArray);
-  OVR_UNUSED(pSymbolInfoArray);
-  OVR_UNUSED(arraySize);
+  // dladdr finds only the symbols in the dynamic symbol tables. The executable's functions are
+  // in its table only if it was linked with -rdynamic. Source file and line info would need the
+  // debug info to be read, as addr2line does.
+  for (size_t i = 0; i < arraySize; i++) {
+    SymbolInfo& symbolInfo = pSymbolInfoArray[i];
+    Dl_info dlInfo;
+
+    symbolInfo.address = addressArray[i];
+    symbolInfo.pModuleInfo = GetModuleInfoForAddress(addressArray[i]);
+
+    if (dladdr((void*)(uintptr_t)addressArray[i], &dlInfo) && dlInfo.dli_sname) {
+      // __cxa_demangle allocates memory.
+      int status = -1;
+      char* demangledName = AllowMemoryAllocation
+          ? abi::__cxa_demangle(dlInfo.dli_sname, nullptr, nullptr, &status)
+          : nullptr;
+
+      OVR_strlcpy(
+          symbolInfo.function,
+          ((status == 0) && demangledName) ? demangledName : dlInfo.dli_sname,
+          OVR_ARRAY_COUNT(symbolInfo.function));
+      symbolInfo.functionOffset = (int32_t)(addressArray[i] - (uintptr_t)dlInfo.dli_saddr);
+      free(demangledName);
+      success = true;
+    }
+  }
 #endif
 
   return success;
@@ -2209,6 +2414,167 @@ const ModuleInfo& SymbolLookup::GetModuleInfoForCurrentModule() {
   return currentModuleInfo;
 }
 
+//-----------------------------------------------------------------------------
+// StackTraceTable
+
+static uint32_t HashStackTrace(void* const addressArray[], size_t frameCount) {
+  uint64_t hash = 0x9E3779B97F4A7C15ull ^ frameCount;
+
+  for (size_t i = 0; i < frameCount; ++i) {
+    hash ^= (uint64_t)(uintptr_t)addressArray[i];
+    hash *= 0xFF51AFD7ED558CCDull;
+    hash ^= (hash >> 32);
+  }
+
+  return (uint32_t)hash;
+}
+
+StackTraceTable::StackTraceTable(size_t maxTraceCount, size_t maxFrameCount)
+    : Slots(nullptr),
+      SlotMask(0),
+      Frames(nullptr),
+      FrameCapacity(0),
+      FramesUsed(0),
+      MaxTraceCount(0),
+      TraceCount(0),
+      DroppedCount(0) {
+  // Ids are 32 bit, and at most half the slots are used so that probe sequences stay short.
+  maxFrameCount = Alg::Min(maxFrameCount, (size_t)UINT32_MAX - 1);
+  size_t slotCount = 16;
+  while (slotCount < (maxTraceCount * 2))
+    slotCount *= 2;
+
+  // SafeMMapAlloc doesn't go through the Allocator, which may be tracking allocations with us.
+  Slots = (std::atomic<uint32_t>*)SafeMMapAlloc(slotCount * sizeof(std::atomic<uint32_t>));
+  Frames = (uintptr_t*)SafeMMapAlloc(maxFrameCount * sizeof(uintptr_t));
+
+  if (!Slots || !Frames) {
+    if (Slots)
+      SafeMMapFree(Slots, slotCount * sizeof(std::atomic<uint32_t>));
+    if (Frames)
+      SafeMMapFree(Frames, maxFrameCount * sizeof(uintptr_t));
+    Slots = nullptr;
+    Frames = nullptr;
+    return;
+  }
+
+  for (size_t i = 0; i < slotCount; ++i)
+    new (&Slots[i]) std::atomic<uint32_t>(0);
+
+  SlotMask = (slotCount - 1);
+  FrameCapacity = maxFrameCount;
+  MaxTraceCount = maxTraceCount;
+}
+
+StackTraceTable::~StackTraceTable() {
+  if (Frames) {
+    SafeMMapFree(Slots, (SlotMask + 1) * sizeof(std::atomic<uint32_t>));
+    SafeMMapFree(Frames, FrameCapacity * sizeof(uintptr_t));
+  }
+}
+
+uint32_t StackTraceTable::Add(void* const addressArray[], size_t frameCount) {
+  if (!Frames || !frameCount)
+    return 0;
+
+  if (frameCount > MaxFramesPerTrace)
+    frameCount = MaxFramesPerTrace;
+
+  const uint32_t hash = HashStackTrace(addressArray, frameCount);
+  const uintptr_t header = (((uintptr_t)hash << 16) | frameCount);
+  uint32_t newId = 0; // Our stored copy of the trace, once we find an empty slot.
+
+  for (size_t i = (hash & SlotMask), probeCount = 0; probeCount <= SlotMask;
+       i = ((i + 1) & SlotMask), ++probeCount) {
+    uint32_t id = Slots[i].load(std::memory_order_acquire);
+
+    if (id == 0) {
+      if (newId == 0) {
+        newId = Store(header, addressArray, frameCount);
+
+        if (newId == 0) {
+          DroppedCount.fetch_add(1, std::memory_order_relaxed);
+          return 0;
+        }
+      }
+
+      if (Slots[i].compare_exchange_strong(
+              id, newId, std::memory_order_acq_rel, std::memory_order_acquire))
+        return newId;
+
+      // Another thread filled the slot first, and id is now its trace.
+    }
+
+    if (Matches(id, header, addressArray, frameCount)) {
+      if (newId) // Another thread added the same trace first, so our copy is left unused.
+        TraceCount.fetch_sub(1, std::memory_order_relaxed);
+      return id;
+    }
+  }
+
+  DroppedCount.fetch_add(1, std::memory_order_relaxed);
+  return 0;
+}
+
+uint32_t StackTraceTable::Store(uintptr_t header, void* const addressArray[], size_t frameCount) {
+  const size_t size = (frameCount + 1);
+
+  // Checked before reserving so that FramesUsed doesn't keep growing once the table is full.
+  if ((FramesUsed.load(std::memory_order_relaxed) + size) > FrameCapacity)
+    return 0;
+
+  if (TraceCount.fetch_add(1, std::memory_order_relaxed) >= MaxTraceCount) {
+    TraceCount.fetch_sub(1, std::memory_order_relaxed);
+    return 0;
+  }
+
+  const size_t start = FramesUsed.fetch_add(size, std::memory_order_relaxed);
+
+  if ((start + size) > FrameCapacity) {
+    TraceCount.fetch_sub(1, std::memory_order_relaxed);
+    return 0;
+  }
+
+  // Published to other threads by the compare_exchange in Add.
+  Frames[start] = header;
+  for (size_t i = 0; i < frameCount; ++i)
+    Frames[start + 1 + i] = (uintptr_t)addressArray[i];
+
+  return (uint32_t)(start + 1);
+}
+
+bool StackTraceTable::Matches(
+    uint32_t id,
+    uintptr_t header,
+    void* const addressArray[],
+    size_t frameCount) const {
+  const uintptr_t* trace = &Frames[id - 1];
+
+  if (trace[0] != header)
+    return false;
+
+  for (size_t i = 0; i < frameCount; ++i) {
+    if (trace[i + 1] != (uintptr_t)addressArray[i])
+      return false;
+  }
+
+  return true;
+}
+
+size_t StackTraceTable::GetTrace(uint32_t id, void* addressArray[], size_t addressArrayCapacity)
+    const {
+  if (!Frames || (id == 0) || (id > FrameCapacity))
+    return 0;
+
+  const uintptr_t* trace = &Frames[id - 1];
+  const size_t frameCount = Alg::Min((size_t)(trace[0] & 0xffff), addressArrayCapacity);
+
+  for (size_t i = 0; i < frameCount; ++i)
+    addressArray[i] = (void*)trace[i + 1];
+
+  return frameCount;
+}
+
 ExceptionInfo::ExceptionInfo()
     : time(),
       timeVal(0),
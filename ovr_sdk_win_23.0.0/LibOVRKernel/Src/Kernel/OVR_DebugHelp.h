@@ -32,6 +32,7 @@ limitations under the License.
 
 #include <stdio.h>
 #include <time.h>
+#include <atomic>
 
 #if defined(OVR_OS_WIN32) || defined(OVR_OS_WIN64)
 #include "OVR_Win32_IncludeWindows.h"
@@ -378,6 +379,32 @@ class SymbolLookup {
       size_t skipCount = 0,
       OVR::ThreadSysId threadSysId = OVR_THREADSYSID_INVALID);
 
+  // Retrieves the current thread's backtrace as raw addresses, for later symbolization.
+  // Unlike GetBacktrace, this doesn't lock, allocate memory or require Initialize, so it may be
+  // called from signal handlers and on hot paths such as allocation tracking. The exception is
+  // a thread's first call outside of Windows, which looks up the thread's stack.
+  // On Windows this uses the unwind tables, via RtlCaptureStackBackTrace. Elsewhere it follows
+  // the frame pointer chain within the thread's stack, so the trace is only reliable up to the
+  // first caller which was compiled without frame pointers (see -fno-omit-frame-pointer).
+  // Returns the number written, which will be <= addressArrayCapacity.
+  static size_t CaptureBacktrace(
+      void* addressArray[],
+      size_t addressArrayCapacity,
+      size_t skipCount = 0);
+
+  // Like CaptureBacktrace, but follows the frame pointer chain from the given registers of the
+  // current thread, such as those saved in a signal handler's context. pc is written as the
+  // first address, and is the only one written where frame pointers can't be followed.
+  // If stackTop is given, the chain is only followed below it, which should be the top of the
+  // stack containing stackPointer, so that a corrupt chain can't lead outside of the stack.
+  static size_t CaptureBacktraceFromFrame(
+      void* addressArray[],
+      size_t addressArrayCapacity,
+      void* pc,
+      void* framePointer,
+      void* stackPointer,
+      void* stackTop = nullptr);
+
   enum ModuleSort { ModuleSortNone = 0, ModuleSortByAddress, ModuleSortByName };
 
   // Gets a list of the modules (e.g. DLLs) present in the current process.
@@ -451,6 +478,75 @@ class SymbolLookup {
   ModuleInfo currentModuleInfo;
 };
 
+//-----------------------------------------------------------------------------
+// StackTraceTable
+//
+// Stores backtraces as raw addresses, once for each distinct trace, and identifies them by
+// 32 bit ids. All memory is reserved on construction and adding a trace is lock-free, so it's
+// safe in signal handlers and cheap enough to do on every allocation. Symbol lookup is left
+// until a report is made, when each trace needs to be symbolized only once however many times
+// it was recorded. Traces are never removed; when the table is full, Add returns 0.
+//
+// Example usage:
+//     void* addressArray[64];
+//     size_t frameCount = SymbolLookup::CaptureBacktrace(addressArray, 64);
+//     uint32_t traceId = table.Add(addressArray, frameCount);
+//     ...
+//     frameCount = table.GetTrace(traceId, addressArray, 64);
+
+class StackTraceTable {
+ public:
+  enum { MaxFramesPerTrace = 0xffff };
+
+  // Reserves space for up to maxTraceCount traces with up to maxFrameCount frames in total.
+  StackTraceTable(size_t maxTraceCount = 65536, size_t maxFrameCount = 1048576);
+  ~StackTraceTable();
+
+  // Returns false if the memory couldn't be reserved, in which case Add always returns 0.
+  bool IsValid() const {
+    return (Frames != nullptr);
+  }
+
+  // Returns the id of the given trace, adding it if it isn't already present. Returns 0 if
+  // frameCount is 0 or the table is full. Traces longer than MaxFramesPerTrace are truncated.
+  uint32_t Add(void* const addressArray[], size_t frameCount);
+
+  // Copies the addresses of the trace with the given id to addressArray.
+  // Returns the number written, which will be <= addressArrayCapacity, or 0 for id 0.
+  size_t GetTrace(uint32_t id, void* addressArray[], size_t addressArrayCapacity) const;
+
+  // Returns the number of distinct traces stored.
+  size_t GetTraceCount() const {
+    return TraceCount.load(std::memory_order_relaxed);
+  }
+
+  // Returns the number of Add calls which failed because the table was full.
+  size_t GetDroppedCount() const {
+    return DroppedCount.load(std::memory_order_relaxed);
+  }
+
+ protected:
+  uint32_t Store(uintptr_t header, void* const addressArray[], size_t frameCount);
+  bool Matches(uint32_t id, uintptr_t header, void* const addressArray[], size_t frameCount)
+      const;
+
+  // Open addressed hash table of trace ids, or 0 for empty slots.
+  std::atomic<uint32_t>* Slots;
+  size_t SlotMask;
+
+  // Each trace is a header of (hash << 16 | frameCount) followed by its addresses. A trace's id
+  // is the index of its header plus one.
+  uintptr_t* Frames;
+  size_t FrameCapacity;
+  std::atomic<size_t> FramesUsed;
+
+  size_t MaxTraceCount;
+  std::atomic<size_t> TraceCount;
+  std::atomic<size_t> DroppedCount;
+
+  OVR_NON_COPYABLE(StackTraceTable);
+};
+
 // ExceptionInfo
 // We need to be careful to avoid data types that can allocate memory while we are
 // handling an exception, as the memory system may be corrupted at that point in time.
@@ -34,7 +34,7 @@ limitations under the License.
 
     Declare a delegate with a void (int) signature, also known as a
     function that returns void and has one parameter that is an int:
-        typedef Delegate1<void, int> MyDelegate;
+        typedef Delegate<void(int)> MyDelegate;
         MyDelegate d;
 
     Point the delegate to a member function:
@@ -49,16 +49,21 @@ limitations under the License.
         d.SetFree<&FreeFunctionX>();
         d = MyDelegate::FromFree<&FreeFunctionX>();
 
-    Invoke the function via the delegate (works for all 3 cases):
+    Point the delegate to a lambda or other function object, which is copied into it:
+        d = [this, scale](int x) { Total += x * scale; };
+
+    Invoke the function via the delegate (works for all cases):
         d(1000);
 
     By default the delegates are uninitialized.
-    To clear an array of delegates quickly just zero the memory.
 
-    This implementation is nicer than FastDelegates in my opinion
-    because it is simple and easy to read.  It is a little slower
-    for virtual functions, but the size of the delegate is small,
-    and it will only get better as compilers improve.
+    Function objects of up to InlineSize bytes are stored inside the delegate, so creating
+    and copying delegates doesn't allocate memory unless the captures are larger than that,
+    where std::function allocates for anything beyond two pointers or so. Calling any kind of
+    delegate is a single indirect call.
+
+    Delegate0 to Delegate3 are the older per-arity names, kept as aliases:
+        Delegate1<void, int> is Delegate<void(int)>.
 */
 
 #ifndef OVR_Delegates_h
@@ -66,351 +71,239 @@ limitations under the License.
 
 #include "OVR_Types.h"
 
-namespace OVR {
-
-template <class ret_type>
-class Delegate0 {
-  typedef ret_type (*StubPointer)(void*);
-  typedef Delegate0<ret_type> this_type;
-
-  void* _object;
-  StubPointer _stub;
-
-  inline Delegate0(void* object, StubPointer stub) {
-    _object = object;
-    _stub = stub;
-  }
-
-  // Stubs
-
-  template <ret_type (*F)()>
-  static inline ret_type FreeStub(void* /*object*/) {
-    return (F)();
-  }
+#include <string.h>
+#include <new>
+#include <type_traits>
+#include <utility>
 
-  template <class T, ret_type (T::*F)()>
-  static inline ret_type MemberStub(void* object) {
-    T* p = static_cast<T*>(object);
-    return (p->*F)();
-  }
+namespace OVR {
 
-  template <class T, ret_type (T::*F)() const>
-  static inline ret_type ConstMemberStub(void* object) {
-    T* p = static_cast<T*>(object);
-    return (p->*F)();
-  }
+template <class Signature>
+class Delegate;
 
+template <class ret_type, class... arg_types>
+class Delegate<ret_type(arg_types...)> {
  public:
-  inline Delegate0() : _object(0), _stub(0) {}
-
-  // Function invocation
-
-  inline ret_type operator()() const {
-    return (*_stub)(_object);
-  }
-
-  // Use stub pointer as a validity flag and equality checker
-
-  inline bool operator==(const this_type& rhs) const {
-    return _object == rhs._object && _stub == rhs._stub;
-  }
-
-  inline bool operator!=(const this_type& rhs) const {
-    return _object != rhs._object || _stub != rhs._stub;
-  }
-
-  inline bool IsValid() const {
-    return _stub != 0;
-  }
-
-  inline bool operator!() const {
-    return _stub == 0;
-  }
-
-  inline void Invalidate() {
-    _stub = 0;
-  }
-
-  // Delegate creation from a function
-
-  template <ret_type (*F)()>
-  static inline this_type FromFree() {
-    return this_type(0, &FreeStub<F>);
-  }
-
-  template <class T, ret_type (T::*F)()>
-  static inline this_type FromMember(T* object) {
-    return this_type(object, &MemberStub<T, F>);
-  }
+  // Function objects up to this size, which are nothrow move constructible and need no more
+  // than pointer alignment, are stored inline. Larger ones are allocated on the heap.
+  enum { InlineSize = 32 };
 
-  template <class T, ret_type (T::*F)() const>
-  static inline this_type FromConstMember(T const* object) {
-    return this_type(const_cast<T*>(object), &ConstMemberStub<T, F>);
-  }
+ private:
+  typedef Delegate<ret_type(arg_types...)> this_type;
+  typedef ret_type (*StubPointer)(void*, arg_types...);
 
-  // In-place assignment to a different function
-
-  template <ret_type (*F)()>
-  inline void SetFree() {
-    *this = FromFree<F>();
-  }
+  // Copies, moves or destroys a stored function object. Null for the delegates which store
+  // only trivially copyable data, which are then copied as plain bytes.
+  enum ManageOperation { Manage_Copy, Manage_Move, Manage_Destroy };
+  typedef void (*ManagerPointer)(ManageOperation, void* dest, void* source);
 
-  template <class T, ret_type (T::*F)()>
-  inline void SetMember(T* object) {
-    *this = FromMember<T, F>(object);
-  }
+  // Holds either the function object itself or a pointer to the object or function object,
+  // and is copied as raw bytes when there's no manager.
+  struct Storage {
+    alignas(void*) unsigned char Bytes[InlineSize];
+  };
 
-  template <class T, ret_type (T::*F)() const>
-  inline void SetConstMember(T const* object) {
-    *this = FromConstMember<T, F>(object);
+  static inline void*& ObjectOf(void* storage) {
+    return *static_cast<void**>(storage);
   }
-};
-
-template <class ret_type, class arg1_type>
-class Delegate1 {
-  typedef ret_type (*StubPointer)(void*, arg1_type);
-  typedef Delegate1<ret_type, arg1_type> this_type;
 
-  void* _object;
+  Storage _storage;
   StubPointer _stub;
+  ManagerPointer _manager;
 
-  inline Delegate1(void* object, StubPointer stub) {
-    _object = object;
-    _stub = stub;
-  }
-
-  // Stubs
-
-  template <ret_type (*F)(arg1_type)>
-  static inline ret_type FreeStub(void* /*object*/, arg1_type a1) {
-    return (F)(a1);
-  }
-
-  template <class T, ret_type (T::*F)(arg1_type)>
-  static inline ret_type MemberStub(void* object, arg1_type a1) {
-    T* p = static_cast<T*>(object);
-    return (p->*F)(a1);
-  }
-
-  template <class T, ret_type (T::*F)(arg1_type) const>
-  static inline ret_type ConstMemberStub(void* object, arg1_type a1) {
-    T* p = static_cast<T*>(object);
-    return (p->*F)(a1);
-  }
-
- public:
-  inline Delegate1() : _object(0), _stub(0) {}
-
-  // Function invocation
-
-  inline ret_type operator()(arg1_type a1) const {
-    return (*_stub)(_object, a1);
-  }
-
-  // Use stub pointer as a validity flag and equality checker
-
-  inline bool operator==(const this_type& rhs) const {
-    return _object == rhs._object && _stub == rhs._stub;
-  }
-
-  inline bool operator!=(const this_type& rhs) const {
-    return _object != rhs._object || _stub != rhs._stub;
-  }
-
-  inline bool IsValid() const {
-    return _stub != 0;
-  }
+  template <class F>
+  struct IsInline {
+    enum {
+      value = (sizeof(F) <= sizeof(Storage)) && (alignof(F) <= alignof(Storage)) &&
+          std::is_nothrow_move_constructible<F>::value
+    };
+  };
 
-  inline bool operator!() const {
-    return _stub == 0;
-  }
-
-  inline void Invalidate() {
-    _stub = 0;
-  }
-
-  // Delegate creation from a function
-
-  template <ret_type (*F)(arg1_type)>
-  static inline this_type FromFree() {
-    return this_type(0, &FreeStub<F>);
-  }
-
-  template <class T, ret_type (T::*F)(arg1_type)>
-  static inline this_type FromMember(T* object) {
-    return this_type(object, &MemberStub<T, F>);
-  }
-
-  template <class T, ret_type (T::*F)(arg1_type) const>
-  static inline this_type FromConstMember(T const* object) {
-    return this_type(const_cast<T*>(object), &ConstMemberStub<T, F>);
-  }
-
-  // In-place assignment to a different function
-
-  template <ret_type (*F)(arg1_type)>
-  inline void SetFree() {
-    *this = FromFree<F>();
-  }
-
-  template <class T, ret_type (T::*F)(arg1_type)>
-  inline void SetMember(T* object) {
-    *this = FromMember<T, F>(object);
-  }
-
-  template <class T, ret_type (T::*F)(arg1_type) const>
-  inline void SetConstMember(T const* object) {
-    *this = FromConstMember<T, F>(object);
-  }
-};
-
-template <class ret_type, class arg1_type, class arg2_type>
-class Delegate2 {
-  typedef ret_type (*StubPointer)(void*, arg1_type, arg2_type);
-  typedef Delegate2<ret_type, arg1_type, arg2_type> this_type;
-
-  void* _object;
-  StubPointer _stub;
-
-  inline Delegate2(void* object, StubPointer stub) {
-    _object = object;
-    _stub = stub;
+  inline Delegate(void* object, StubPointer stub) : _stub(stub), _manager(nullptr) {
+    memset(&_storage, 0, sizeof(_storage));
+    new (&_storage) void*(object);
   }
 
   // Stubs
 
-  template <ret_type (*F)(arg1_type, arg2_type)>
-  static inline ret_type FreeStub(void* /*object*/, arg1_type a1, arg2_type a2) {
-    return (F)(a1, a2);
-  }
-
-  template <class T, ret_type (T::*F)(arg1_type, arg2_type)>
-  static inline ret_type MemberStub(void* object, arg1_type a1, arg2_type a2) {
-    T* p = static_cast<T*>(object);
-    return (p->*F)(a1, a2);
-  }
-
-  template <class T, ret_type (T::*F)(arg1_type, arg2_type) const>
-  static inline ret_type ConstMemberStub(void* object, arg1_type a1, arg2_type a2) {
-    T* p = static_cast<T*>(object);
-    return (p->*F)(a1, a2);
-  }
+  template <ret_type (*F)(arg_types...)>
+  static inline ret_type FreeStub(void* /*storage*/, arg_types... args) {
+    return (F)(std::forward<arg_types>(args)...);
+  }
+
+  template <class T, ret_type (T::*F)(arg_types...)>
+  static inline ret_type MemberStub(void* storage, arg_types... args) {
+    T* p = static_cast<T*>(ObjectOf(storage));
+    return (p->*F)(std::forward<arg_types>(args)...);
+  }
+
+  template <class T, ret_type (T::*F)(arg_types...) const>
+  static inline ret_type ConstMemberStub(void* storage, arg_types... args) {
+    T* p = static_cast<T*>(ObjectOf(storage));
+    return (p->*F)(std::forward<arg_types>(args)...);
+  }
+
+  template <class F>
+  static inline ret_type InlineStub(void* storage, arg_types... args) {
+    return (*static_cast<F*>(storage))(std::forward<arg_types>(args)...);
+  }
+
+  template <class F>
+  static inline ret_type HeapStub(void* storage, arg_types... args) {
+    F* f = static_cast<F*>(ObjectOf(storage));
+    return (*f)(std::forward<arg_types>(args)...);
+  }
+
+  template <class F>
+  static void InlineManager(ManageOperation operation, void* dest, void* source) {
+    switch (operation) {
+      case Manage_Copy:
+        new (dest) F(*static_cast<const F*>(source));
+        break;
+      case Manage_Move:
+        new (dest) F(std::move(*static_cast<F*>(source)));
+        static_cast<F*>(source)->~F();
+        break;
+      case Manage_Destroy:
+        static_cast<F*>(dest)->~F();
+        break;
+    }
+  }
+
+  template <class F>
+  static void HeapManager(ManageOperation operation, void* dest, void* source) {
+    switch (operation) {
+      case Manage_Copy:
+        new (dest) void*(new F(*static_cast<const F*>(ObjectOf(source))));
+        break;
+      case Manage_Move:
+        new (dest) void*(ObjectOf(source));
+        break;
+      case Manage_Destroy:
+        delete static_cast<F*>(ObjectOf(dest));
+        break;
+    }
+  }
+
+  template <class F>
+  void assignFunction(F&& f, std::true_type /*isInline*/) {
+    typedef typename std::decay<F>::type FunctionType;
+    new (&_storage) FunctionType(std::forward<F>(f));
+    _stub = &InlineStub<FunctionType>;
+    _manager = std::is_trivially_copyable<FunctionType>::value
+        ? nullptr
+        : &InlineManager<FunctionType>;
+  }
+
+  template <class F>
+  void assignFunction(F&& f, std::false_type /*isInline*/) {
+    typedef typename std::decay<F>::type FunctionType;
+    new (&_storage) void*(new FunctionType(std::forward<F>(f)));
+    _stub = &HeapStub<FunctionType>;
+    _manager = &HeapManager<FunctionType>;
+  }
+
+  void copyFrom(const this_type& other) {
+    if (other._manager) {
+      memset(&_storage, 0, sizeof(_storage));
+      other._manager(Manage_Copy, &_storage, const_cast<Storage*>(&other._storage));
+    } else {
+      memcpy(&_storage, &other._storage, sizeof(_storage));
+    }
+    _stub = other._stub;
+    _manager = other._manager;
+  }
+
+  void moveFrom(this_type& other) {
+    if (other._manager) {
+      memset(&_storage, 0, sizeof(_storage));
+      other._manager(Manage_Move, &_storage, &other._storage);
+    } else {
+      memcpy(&_storage, &other._storage, sizeof(_storage));
+    }
+    _stub = other._stub;
+    _manager = other._manager;
+    other._stub = nullptr;
+    other._manager = nullptr;
+  }
+
+  template <class F>
+  struct IsFunctionObject {
+    enum {
+      value = !std::is_same<typename std::decay<F>::type, this_type>::value
+    };
+  };
 
  public:
-  inline Delegate2() : _object(0), _stub(0) {}
-
-  // Function invocation
-
-  inline ret_type operator()(arg1_type a1, arg2_type a2) const {
-    return (*_stub)(_object, a1, a2);
+  inline Delegate() : _stub(nullptr), _manager(nullptr) {
+    memset(&_storage, 0, sizeof(_storage));
   }
 
-  // Use stub pointer as a validity flag and equality checker
-
-  inline bool operator==(const this_type& rhs) const {
-    return _object == rhs._object && _stub == rhs._stub;
+  // Stores a copy of a lambda or other function object, which is called with the delegate's
+  // arguments and must return something convertible to ret_type.
+  template <
+      class F,
+      typename std::enable_if<IsFunctionObject<F>::value, int>::type = 0>
+  inline Delegate(F&& f) : _stub(nullptr), _manager(nullptr) {
+    memset(&_storage, 0, sizeof(_storage));
+    assignFunction(
+        std::forward<F>(f),
+        std::integral_constant<bool, IsInline<typename std::decay<F>::type>::value>());
   }
 
-  inline bool operator!=(const this_type& rhs) const {
-    return _object != rhs._object || _stub != rhs._stub;
+  inline Delegate(const this_type& other) {
+    copyFrom(other);
   }
 
-  inline bool IsValid() const {
-    return _stub != 0;
+  inline Delegate(this_type&& other) {
+    moveFrom(other);
   }
 
-  inline bool operator!() const {
-    return _stub == 0;
-  }
-
-  inline void Invalidate() {
-    _stub = 0;
-  }
-
-  // Delegate creation from a function
-
-  template <ret_type (*F)(arg1_type, arg2_type)>
-  static inline this_type FromFree() {
-    return this_type(0, &FreeStub<F>);
-  }
-
-  template <class T, ret_type (T::*F)(arg1_type, arg2_type)>
-  static inline this_type FromMember(T* object) {
-    return this_type(object, &MemberStub<T, F>);
+  inline ~Delegate() {
+    if (_manager)
+      _manager(Manage_Destroy, &_storage, nullptr);
   }
 
-  template <class T, ret_type (T::*F)(arg1_type, arg2_type) const>
-  static inline this_type FromConstMember(T const* object) {
-    return this_type(const_cast<T*>(object), &ConstMemberStub<T, F>);
+  inline this_type& operator=(const this_type& other) {
+    if (this != &other) {
+      Invalidate();
+      copyFrom(other);
+    }
+    return *this;
   }
 
-  // In-place assignment to a different function
-
-  template <ret_type (*F)(arg1_type, arg2_type)>
-  inline void SetFree() {
-    *this = FromFree<F>();
+  inline this_type& operator=(this_type&& other) {
+    if (this != &other) {
+      Invalidate();
+      moveFrom(other);
+    }
+    return *this;
   }
 
-  template <class T, ret_type (T::*F)(arg1_type, arg2_type)>
-  inline void SetMember(T* object) {
-    *this = FromMember<T, F>(object);
+  template <
+      class F,
+      typename std::enable_if<IsFunctionObject<F>::value, int>::type = 0>
+  inline this_type& operator=(F&& f) {
+    return *this = this_type(std::forward<F>(f));
   }
 
-  template <class T, ret_type (T::*F)(arg1_type, arg2_type) const>
-  inline void SetConstMember(T const* object) {
-    *this = FromConstMember<T, F>(object);
-  }
-};
-
-template <class ret_type, class arg1_type, class arg2_type, class arg3_type>
-class Delegate3 {
-  typedef ret_type (*StubPointer)(void*, arg1_type, arg2_type, arg3_type);
-  typedef Delegate3<ret_type, arg1_type, arg2_type, arg3_type> this_type;
-
-  void* _object;
-  StubPointer _stub;
-
-  inline Delegate3(void* object, StubPointer stub) {
-    _object = object;
-    _stub = stub;
-  }
-
-  // Stubs
-
-  template <ret_type (*F)(arg1_type, arg2_type, arg3_type)>
-  static inline ret_type FreeStub(void* /*object*/, arg1_type a1, arg2_type a2, arg3_type a3) {
-    return (F)(a1, a2, a3);
-  }
-
-  template <class T, ret_type (T::*F)(arg1_type, arg2_type, arg3_type)>
-  static inline ret_type MemberStub(void* object, arg1_type a1, arg2_type a2, arg3_type a3) {
-    T* p = static_cast<T*>(object);
-    return (p->*F)(a1, a2, a3);
-  }
-
-  template <class T, ret_type (T::*F)(arg1_type, arg2_type, arg3_type) const>
-  static inline ret_type ConstMemberStub(void* object, arg1_type a1, arg2_type a2, arg3_type a3) {
-    T* p = static_cast<T*>(object);
-    return (p->*F)(a1, a2, a3);
-  }
-
- public:
-  inline Delegate3() : _object(0), _stub(0) {}
-
   // Function invocation
 
-  inline ret_type operator()(arg1_type a1, arg2_type a2, arg3_type a3) const {
-    return (*_stub)(_object, a1, a2, a3);
+  inline ret_type operator()(arg_types... args) const {
+    return (*_stub)(const_cast<Storage*>(&_storage), std::forward<arg_types>(args)...);
   }
 
-  // Use stub pointer as a validity flag and equality checker
+  // Use stub pointer as a validity flag and equality checker.
+  // Equality compares the stored bytes, so it's reliable only for delegates of plain functions
+  // and member functions. Delegates holding function objects, even copies of one another, may
+  // compare unequal, as stored objects may be on the heap or contain padding.
 
   inline bool operator==(const this_type& rhs) const {
-    return _object == rhs._object && _stub == rhs._stub;
+    return _stub == rhs._stub && memcmp(&_storage, &rhs._storage, sizeof(_storage)) == 0;
   }
 
   inline bool operator!=(const this_type& rhs) const {
-    return _object != rhs._object || _stub != rhs._stub;
+    return !(*this == rhs);
   }
 
   inline bool IsValid() const {
@@ -421,47 +314,59 @@ class Delegate3 {
     return _stub == 0;
   }
 
+  // Clears the delegate, destroying any function object it holds.
   inline void Invalidate() {
-    _stub = 0;
+    if (_manager)
+      _manager(Manage_Destroy, &_storage, nullptr);
+    memset(&_storage, 0, sizeof(_storage));
+    _stub = nullptr;
+    _manager = nullptr;
   }
 
   // Delegate creation from a function
 
-  template <ret_type (*F)(arg1_type, arg2_type, arg3_type)>
+  template <ret_type (*F)(arg_types...)>
   static inline this_type FromFree() {
     return this_type(0, &FreeStub<F>);
   }
 
-  template <class T, ret_type (T::*F)(arg1_type, arg2_type, arg3_type)>
+  template <class T, ret_type (T::*F)(arg_types...)>
   static inline this_type FromMember(T* object) {
     return this_type(object, &MemberStub<T, F>);
   }
 
-  template <class T, ret_type (T::*F)(arg1_type, arg2_type, arg3_type) const>
+  template <class T, ret_type (T::*F)(arg_types...) const>
   static inline this_type FromConstMember(T const* object) {
     return this_type(const_cast<T*>(object), &ConstMemberStub<T, F>);
   }
 
   // In-place assignment to a different function
 
-  template <ret_type (*F)(arg1_type, arg2_type, arg3_type)>
+  template <ret_type (*F)(arg_types...)>
   inline void SetFree() {
     *this = FromFree<F>();
   }
 
-  template <class T, ret_type (T::*F)(arg1_type, arg2_type, arg3_type)>
+  template <class T, ret_type (T::*F)(arg_types...)>
   inline void SetMember(T* object) {
     *this = FromMember<T, F>(object);
   }
 
-  template <class T, ret_type (T::*F)(arg1_type, arg2_type, arg3_type) const>
+  template <class T, ret_type (T::*F)(arg_types...) const>
   inline void SetConstMember(T const* object) {
     *this = FromConstMember<T, F>(object);
   }
 };
 
-// Add more here if needed, but keep in mind that a short, simple interface
-// is rewarded by making the delegates faster...
+// Per-arity names
+template <class ret_type>
+using Delegate0 = Delegate<ret_type()>;
+template <class ret_type, class arg1_type>
+using Delegate1 = Delegate<ret_type(arg1_type)>;
+template <class ret_type, class arg1_type, class arg2_type>
+using Delegate2 = Delegate<ret_type(arg1_type, arg2_type)>;
+template <class ret_type, class arg1_type, class arg2_type, class arg3_type>
+using Delegate3 = Delegate<ret_type(arg1_type, arg2_type, arg3_type)>;
 
 } // namespace OVR
 
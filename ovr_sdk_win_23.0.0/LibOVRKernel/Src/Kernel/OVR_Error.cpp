@@ -178,6 +178,23 @@ OVRError::OVRError(ovrResult code, const char* pFormat, ...) : OVRError(code) {
   va_end(argList);
 }
 
+OVRError::OVRError(const OVRErrorValue& errorValue) : OVRError(errorValue.GetCode()) {
+  SetSysCode(errorValue.GetSysCodeType(), errorValue.GetSysCode());
+
+  const OVRErrorSite* pSite = errorValue.GetSite();
+
+  if (pSite) { // Fill in what MakeError would have, as of now.
+    OVRTime = Timer::GetSeconds();
+    ClockTime = std::chrono::system_clock::now();
+    SetDescription(pSite->Description);
+    SetSource(pSite->SourceFilePath, pSite->SourceFileLine);
+
+    void* addressArray[32];
+    size_t n = errorValue.GetBacktrace(addressArray, OVR_ARRAY_COUNT(addressArray));
+    Backtrace.Append(addressArray, n);
+  }
+}
+
 OVRError::OVRError(const OVRError& ovrError) {
   operator=(ovrError);
 }
@@ -415,6 +432,64 @@ OVRError::AddressArray OVRError::GetBacktrace() const {
   return Backtrace;
 }
 
+//-----------------------------------------------------------------------------
+// OVRErrorValue
+
+#if defined(OVR_ERROR_ENABLE_BACKTRACES)
+// Backtraces of OVRErrorValues are stored here, so that errors made repeatedly from the same
+// place share one copy. It's never destroyed, as errors may be made during static destruction.
+static StackTraceTable& GetErrorBacktraceTable() {
+  alignas(StackTraceTable) static char tableStorage[sizeof(StackTraceTable)];
+  static StackTraceTable* errorBacktraceTable = new (tableStorage) StackTraceTable(4096, 65536);
+  return *errorBacktraceTable;
+}
+#endif
+
+// Sites for OVRErrorValues converted from OVRErrors, which keep only the sys code type.
+static const OVRErrorSite SysCodeTypeSites[] = {{nullptr, nullptr, 0, ovrSysErrorCodeType::None},
+                                                {nullptr, nullptr, 0, ovrSysErrorCodeType::OS},
+                                                {nullptr, nullptr, 0, ovrSysErrorCodeType::ALVR},
+                                                {nullptr, nullptr, 0, ovrSysErrorCodeType::NVAPI},
+                                                {nullptr, nullptr, 0, ovrSysErrorCodeType::NVENC},
+                                                {nullptr, nullptr, 0, ovrSysErrorCodeType::Vulkan},
+                                                {nullptr, nullptr, 0, ovrSysErrorCodeType::OpenGL}};
+
+OVRErrorValue::OVRErrorValue(ovrResult code, ovrSysErrorCode sysCode, const OVRErrorSite* pSite)
+    : Code(code), SysCode(sysCode), BacktraceId(0), Site(pSite) {
+#if defined(OVR_ERROR_ENABLE_BACKTRACES)
+  // Only the raw addresses are captured here, which is much cheaper than GetBacktrace.
+  void* addressArray[32];
+  size_t n = SymbolLookup::CaptureBacktrace(addressArray, OVR_ARRAY_COUNT(addressArray), 1);
+  BacktraceId = GetErrorBacktraceTable().Add(addressArray, n);
+#endif
+}
+
+OVRErrorValue::OVRErrorValue(const OVRError& ovrError)
+    : Code(ovrError.GetCode()),
+      SysCode(ovrError.GetSysCode()),
+      BacktraceId(0),
+      Site(nullptr) {
+  const size_t sysCodeTypeIndex = (size_t)ovrError.GetSysCodeType();
+
+  if ((SysCode != ovrSysErrorCodeSuccess) &&
+      (sysCodeTypeIndex < OVR_ARRAY_COUNT(SysCodeTypeSites)))
+    Site = &SysCodeTypeSites[sysCodeTypeIndex];
+}
+
+size_t OVRErrorValue::GetBacktrace(void* addressArray[], size_t addressArrayCapacity) const {
+#if defined(OVR_ERROR_ENABLE_BACKTRACES)
+  if (BacktraceId)
+    return GetErrorBacktraceTable().GetTrace(BacktraceId, addressArray, addressArrayCapacity);
+#else
+  OVR_UNUSED2(addressArray, addressArrayCapacity);
+#endif
+  return 0;
+}
+
+OVRError OVRErrorValue::ToOVRError() const {
+  return OVRError(*this);
+}
+
 void LogError(OVRError& ovrError) {
   // If not already logged,
   if (!ovrError.IsAlreadyLogged()) {
@@ -380,6 +380,55 @@ namespace OVR {
     return OVR_MAKE_SYS_ERROR_F((errorCode), (sysErrorCode), __VA_ARGS__); \
   }
 
+/// -----------------------------------------------------------------------------
+/// ***** OVR_MAKE_ERROR_VALUE, OVR_MAKE_SYS_ERROR_VALUE
+///
+/// Declaration:
+///   OVRErrorValue OVR_MAKE_ERROR_VALUE(ovrResult r, const char* description);
+///   OVRErrorValue OVR_MAKE_SYS_ERROR_VALUE(ovrResult r, ovrSysErrorCode sysCode,
+///                                          const char* description);
+///
+/// Makes an OVRErrorValue, for paths which may produce and discard errors at a high rate, such
+/// as polling a disconnected device. The description must be a string literal, as it's stored
+/// with the file and line in a static OVRErrorSite for the call site. Unlike OVR_MAKE_ERROR,
+/// nothing is formatted, logged or asserted, and the last error isn't set. An error which
+/// needs reporting can be converted to an OVRError, which fills in the rest.
+///
+/// Example usage:
+///      OVRErrorValue PollDevice()
+///      {
+///          if(!Device)
+///              return OVR_MAKE_ERROR_VALUE(ovrError_NoHmd, "Device is not connected.");
+///          ...
+///      }
+///
+///      OVRErrorValue err = PollDevice();
+///      if(err.Failed() && ShouldReport(err))
+///      {
+///          OVRError error = err; // Fills in the description, time and backtrace.
+///          OVR_LOG_ERROR(error);
+///      }
+///
+#define OVR_MAKE_ERROR_VALUE(errorCode, pDescription) \
+  OVR_MAKE_SYS_ERROR_VALUE_T(                         \
+      (errorCode), OVR::ovrSysErrorCodeType::None, OVR::ovrSysErrorCodeSuccess, (pDescription))
+
+#define OVR_MAKE_SYS_ERROR_VALUE(errorCode, sysErrorCode, pDescription) \
+  OVR_MAKE_SYS_ERROR_VALUE_T(                                           \
+      (errorCode), OVR::ovrSysErrorCodeType::OS, (sysErrorCode), (pDescription))
+
+// The lambda gives each call site its own OVRErrorSite. As all of its members are constants,
+// it's initialized at compile time, with no guard to check at run time.
+#define OVR_MAKE_SYS_ERROR_VALUE_T(errorCode, sysErrorCodeType, sysErrorCode, pDescription) \
+  OVR::OVRErrorValue(                                                                     \
+      (errorCode),                                                                        \
+      (sysErrorCode),                                                                     \
+      []() -> const OVR::OVRErrorSite* {                                                  \
+        static const OVR::OVRErrorSite site = {                                           \
+            (pDescription), OVR_FILE, OVR_LINE, (sysErrorCodeType)};                      \
+        return &site;                                                                     \
+      }())
+
 /// -----------------------------------------------------------------------------
 /// ***** ovrSysErrorCodeType
 ///
@@ -418,6 +467,96 @@ const ovrSysErrorCode ovrSysErrorCodeNone = 0;
 // SysClockTime is a C++11 equivalent to C time_t.
 typedef std::chrono::time_point<std::chrono::system_clock> SysClockTime;
 
+class OVRError;
+
+/// -----------------------------------------------------------------------------
+/// ***** OVRErrorSite
+///
+/// Static description of a place where an OVRErrorValue is made. Instances are made by the
+/// OVR_MAKE_ERROR_VALUE macros and must outlive any error which refers to them.
+///
+struct OVRErrorSite {
+  const char* Description; /// Unlocalized error description.
+  const char* SourceFilePath; /// The __FILE__ of the site, or null in release builds.
+  int SourceFileLine; /// The __LINE__ of the site, or 0 in release builds.
+  ovrSysErrorCodeType SysCodeType; /// The error space of the sys code.
+};
+
+/// -----------------------------------------------------------------------------
+/// ***** OVRErrorValue
+///
+/// Compact error value holding only codes, a pointer to the static OVRErrorSite it was made at,
+/// and in builds with error backtraces, the id of its backtrace. Making one allocates nothing
+/// and builds no strings, so it's suited to errors which are mostly discarded. Descriptions,
+/// error strings and symbolized backtraces are produced when it's converted to an OVRError,
+/// which can be done implicitly, as in returning an OVRErrorValue from a function which returns
+/// an OVRError. The time of the OVRError is that of the conversion.
+///
+/// An OVRError converts back to an OVRErrorValue with its codes only, as its description and
+/// other strings have no static storage to refer to.
+///
+class OVRErrorValue {
+ public:
+  OVRErrorValue() : Code(ovrSuccess), SysCode(ovrSysErrorCodeSuccess), BacktraceId(0), Site() {}
+
+  OVRErrorValue(ovrResult code) // Intentionally not explicit.
+      : Code(code), SysCode(ovrSysErrorCodeSuccess), BacktraceId(0), Site() {}
+
+  // Records the backtrace in builds with error backtraces (see OVR_ERROR_ENABLE_BACKTRACES).
+  OVRErrorValue(ovrResult code, ovrSysErrorCode sysCode, const OVRErrorSite* pSite);
+
+  OVRErrorValue(const OVRError& ovrError); // Intentionally not explicit.
+
+  bool Succeeded() const {
+    return Code >= ovrSuccess;
+  }
+  bool Failed() const {
+    return !Succeeded();
+  }
+
+  ovrResult GetCode() const {
+    return Code;
+  }
+  operator ovrResult() const {
+    return Code;
+  }
+
+  ovrSysErrorCodeType GetSysCodeType() const {
+    return Site ? Site->SysCodeType : ovrSysErrorCodeType::None;
+  }
+  ovrSysErrorCode GetSysCode() const {
+    return SysCode;
+  }
+
+  // Returns the site the error was made at, or null if it wasn't made by OVR_MAKE_ERROR_VALUE.
+  const OVRErrorSite* GetSite() const {
+    return Site;
+  }
+
+  // Returns the description, or an empty string if there is none.
+  const char* GetDescription() const {
+    return (Site && Site->Description) ? Site->Description : "";
+  }
+
+  // Returns the backtrace's id in the table of error backtraces, or 0 if none was recorded.
+  uint32_t GetBacktraceId() const {
+    return BacktraceId;
+  }
+
+  // Copies the addresses of the backtrace to addressArray.
+  // Returns the number written, which will be <= addressArrayCapacity.
+  size_t GetBacktrace(void* addressArray[], size_t addressArrayCapacity) const;
+
+  // Builds the full OVRError. Same as converting to OVRError.
+  OVRError ToOVRError() const;
+
+ protected:
+  ovrResult Code;
+  ovrSysErrorCode SysCode;
+  uint32_t BacktraceId;
+  const OVRErrorSite* Site;
+};
+
 /// -----------------------------------------------------------------------------
 /// ***** OVRError
 ///
@@ -439,6 +578,7 @@ class OVRError {
   OVRError();
   OVRError(ovrResult code); // Intentionally not explicit.
   OVRError(ovrResult code, const char* pFormat, ...);
+  OVRError(const OVRErrorValue& errorValue); // Intentionally not explicit.
 
   OVRError(const OVRError& OVRError);
   OVRError(OVRError&& OVRError);
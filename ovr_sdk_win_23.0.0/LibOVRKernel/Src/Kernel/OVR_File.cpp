@@ -31,34 +31,52 @@ limitations under the License.
 #include <stdio.h>
 
 #include "OVR_File.h"
+#include "OVR_Deque.h"
+#include "OVR_Threads.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#if defined(OVR_OS_LINUX)
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/sendfile.h>
+#include <unistd.h>
+#endif
 
 namespace OVR {
 
 // Buffered file adds buffering to an existing file
-// FILEBUFFER_SIZE defines the size of internal buffer, while
-// FILEBUFFER_TOLERANCE controls the amount of data we'll effectively try to buffer
-#define FILEBUFFER_SIZE (8192 - 8)
-#define FILEBUFFER_TOLERANCE 4096
+// BufferSize defines the size of internal buffer, while
+// GetBufferTolerance() controls the amount of data we'll effectively try to buffer
 
 // ** Constructor/Destructor
 
 // Hidden constructor
 // Not supposed to be used
 BufferedFile::BufferedFile() : DelegatedFile(0) {
-  pBuffer = (uint8_t*)OVR_ALLOC(FILEBUFFER_SIZE);
+  BufferSize = DefaultBufferSize;
+  pBuffer = (uint8_t*)OVR_ALLOC(BufferSize);
   BufferMode = NoBuffer;
   FilePos = 0;
   Pos = 0;
   DataSize = 0;
+  pWriteBehind = NULL;
+  pReadAhead = NULL;
 }
 
 // Takes another file as source
-BufferedFile::BufferedFile(File* pfile) : DelegatedFile(pfile) {
-  pBuffer = (uint8_t*)OVR_ALLOC(FILEBUFFER_SIZE);
+BufferedFile::BufferedFile(File* pfile, unsigned bufferSize) : DelegatedFile(pfile) {
+  BufferSize = Alg::Max(bufferSize, 1u);
+  pBuffer = (uint8_t*)OVR_ALLOC(BufferSize);
   BufferMode = NoBuffer;
   FilePos = pfile->LTell();
   Pos = 0;
   DataSize = 0;
+  pWriteBehind = NULL;
+  pReadAhead = NULL;
 }
 
 // Destructor
@@ -66,6 +84,8 @@ BufferedFile::~BufferedFile() {
   // Flush in case there's data
   if (pFile)
     FlushBuffer();
+  SetWriteBehind(false);
+  SetReadAhead(false);
   // Get rid of buffer
   if (pBuffer)
     OVR_FREE(pBuffer);
@@ -89,6 +109,301 @@ bool    BufferedFile::VCopy(const Object &source)
 }
 */
 
+// ***** Write-behind
+
+// Full write buffers waiting for the write-behind thread, which writes them to the file in
+// order. Buffers are recycled through FreeBuffers, so once the queue has filled up no more
+// are allocated.
+struct BufferedFile::WriteBehindQueue {
+  struct QueuedBuffer {
+    uint8_t* pData;
+    unsigned Size;
+  };
+
+  File* pFile;
+  std::mutex QueueMutex;
+  std::condition_variable QueueCondition; // Signaled whenever the queue changes.
+  Deque<QueuedBuffer> Queue;
+  ArrayPOD<uint8_t*> FreeBuffers;
+  bool Writing; // The thread is writing a buffer it took from the queue.
+  std::atomic<bool> Failed; // Checked by Write without taking the lock.
+  bool Terminated;
+  std::thread WriteThread;
+
+  WriteBehindQueue(File* pfile, unsigned maxQueuedBuffers)
+      : pFile(pfile),
+        Queue((int)maxQueuedBuffers),
+        Writing(false),
+        Failed(false),
+        Terminated(false) {
+    WriteThread = std::thread(&WriteBehindQueue::Run, this);
+  }
+
+  ~WriteBehindQueue() {
+    {
+      std::lock_guard<std::mutex> lock(QueueMutex);
+      Terminated = true;
+    }
+    QueueCondition.notify_all();
+    WriteThread.join();
+
+    for (size_t i = 0; i < FreeBuffers.GetSize(); ++i)
+      OVR_FREE(FreeBuffers[i]);
+  }
+
+  void Run() {
+    Thread::SetCurrentThreadName("OVR::WriteBehind");
+
+    std::unique_lock<std::mutex> lock(QueueMutex);
+    for (;;) {
+      QueueCondition.wait(lock, [this] { return Terminated || !Queue.IsEmpty(); });
+      if (Queue.IsEmpty()) // Terminated, and everything is written.
+        break;
+
+      QueuedBuffer buffer = Queue.PopFront();
+      Writing = true;
+      lock.unlock();
+
+      // After a failure the rest is discarded, as the file would have a gap anyway.
+      bool written = !Failed && (pFile->Write(buffer.pData, (int)buffer.Size) == (int)buffer.Size);
+
+      lock.lock();
+      if (!written)
+        Failed = true;
+      FreeBuffers.PushBack(buffer.pData);
+      Writing = false;
+      QueueCondition.notify_all();
+    }
+  }
+};
+
+bool BufferedFile::SetWriteBehind(bool enable, unsigned maxQueuedBuffers) {
+  if (enable == (pWriteBehind != NULL))
+    return true;
+
+  if (enable) {
+    if (!pFile || !pFile->IsWritable() || !pBuffer)
+      return false;
+    // Write out what's buffered, and switch to tracking the file position ourselves.
+    FlushBuffer();
+    if (BufferMode != ReadBuffer)
+      FilePos = pFile->LTell();
+    pWriteBehind = new WriteBehindQueue(pFile, Alg::Max(maxQueuedBuffers, 1u));
+    return true;
+  }
+
+  if (BufferMode == WriteBuffer)
+    FlushBuffer();
+  bool result = DrainWriteBehind();
+  delete pWriteBehind;
+  pWriteBehind = NULL;
+  return result;
+}
+
+void BufferedFile::QueueBuffer() {
+  OVR_ASSERT(pWriteBehind && (BufferMode == WriteBuffer));
+  if (Pos == 0)
+    return;
+
+  uint8_t* pnewBuffer = NULL;
+  {
+    std::unique_lock<std::mutex> lock(pWriteBehind->QueueMutex);
+    pWriteBehind->QueueCondition.wait(lock, [this] { return !pWriteBehind->Queue.IsFull(); });
+
+    WriteBehindQueue::QueuedBuffer buffer = {pBuffer, Pos};
+    pWriteBehind->Queue.PushBack(buffer);
+    if (pWriteBehind->FreeBuffers.GetSize() != 0) {
+      pnewBuffer = pWriteBehind->FreeBuffers.Back();
+      pWriteBehind->FreeBuffers.PopBack();
+    }
+  }
+  pWriteBehind->QueueCondition.notify_all();
+
+  if (!pnewBuffer)
+    pnewBuffer = (uint8_t*)OVR_ALLOC(BufferSize);
+  // If that fails, wait for the buffer just queued to come back.
+  if (!pnewBuffer) {
+    DrainWriteBehind();
+    pnewBuffer = pWriteBehind->FreeBuffers.Back();
+    pWriteBehind->FreeBuffers.PopBack();
+  }
+
+  pBuffer = pnewBuffer;
+  FilePos += Pos;
+  Pos = 0;
+}
+
+bool BufferedFile::DrainWriteBehind() {
+  if (!pWriteBehind)
+    return true;
+
+  std::unique_lock<std::mutex> lock(pWriteBehind->QueueMutex);
+  pWriteBehind->QueueCondition.wait(
+      lock, [this] { return pWriteBehind->Queue.IsEmpty() && !pWriteBehind->Writing; });
+  return !pWriteBehind->Failed;
+}
+
+// ***** Read-ahead
+
+// The read-ahead thread reads into a spare buffer, which LoadBuffer swaps with the consumed
+// one before starting the next read. Only one read is in flight at a time, so the underlying
+// file is never used by both threads at once as long as the main thread waits for it first.
+struct BufferedFile::ReadAheadState {
+  File* pFile;
+  std::mutex StateMutex;
+  std::condition_variable StateCondition;
+  uint8_t* pData;
+  unsigned Size; // Bytes requested.
+  int Result; // Bytes read, or -1.
+  bool Requested; // A read has been requested and hasn't finished.
+  bool Pending; // A read was started and its data hasn't been taken or dropped. Main thread only.
+  bool Terminated;
+  std::thread ReadThread;
+
+  ReadAheadState(File* pfile, uint8_t* pdata)
+      : pFile(pfile),
+        pData(pdata),
+        Size(0),
+        Result(0),
+        Requested(false),
+        Pending(false),
+        Terminated(false) {
+    ReadThread = std::thread(&ReadAheadState::Run, this);
+  }
+
+  ~ReadAheadState() {
+    {
+      std::lock_guard<std::mutex> lock(StateMutex);
+      Terminated = true;
+    }
+    StateCondition.notify_all();
+    ReadThread.join();
+    OVR_FREE(pData);
+  }
+
+  void Run() {
+    Thread::SetCurrentThreadName("OVR::ReadAhead");
+
+    std::unique_lock<std::mutex> lock(StateMutex);
+    for (;;) {
+      StateCondition.wait(lock, [this] { return Terminated || Requested; });
+      if (Terminated)
+        break;
+
+      lock.unlock();
+      int result = pFile->Read(pData, (int)Size);
+      lock.lock();
+
+      Result = result;
+      Requested = false;
+      StateCondition.notify_all();
+    }
+  }
+
+  void Start(unsigned size) {
+    OVR_ASSERT(!Pending);
+    {
+      std::lock_guard<std::mutex> lock(StateMutex);
+      Size = size;
+      Requested = true;
+    }
+    StateCondition.notify_all();
+    Pending = true;
+  }
+
+  // Returns the number of bytes read ahead, once the read has finished.
+  unsigned Wait() {
+    if (!Pending)
+      return 0;
+    std::unique_lock<std::mutex> lock(StateMutex);
+    StateCondition.wait(lock, [this] { return !Requested; });
+    return (Result > 0) ? (unsigned)Result : 0;
+  }
+};
+
+bool BufferedFile::SetReadAhead(bool enable) {
+  if (enable == (pReadAhead != NULL))
+    return true;
+
+  if (enable) {
+    if (!pFile || !pBuffer)
+      return false;
+    uint8_t* pdata = (uint8_t*)OVR_ALLOC(BufferSize);
+    if (!pdata)
+      return false;
+    pReadAhead = new ReadAheadState(pFile, pdata);
+    return true;
+  }
+
+  // Put the file position back where the reader is
+  unsigned readAhead = DiscardReadAhead();
+  if (readAhead > 0)
+    FilePos = pFile->LSeek(-(int64_t)readAhead, Seek_Cur);
+  delete pReadAhead;
+  pReadAhead = NULL;
+  return true;
+}
+
+unsigned BufferedFile::WaitReadAhead() {
+  return pReadAhead ? pReadAhead->Wait() : 0;
+}
+
+unsigned BufferedFile::DiscardReadAhead() {
+  if (!pReadAhead)
+    return 0;
+  unsigned readAhead = pReadAhead->Wait();
+  pReadAhead->Pending = false;
+  return readAhead;
+}
+
+bool BufferedFile::SetBufferSize(unsigned bufferSize) {
+  if (bufferSize == 0)
+    return false;
+  if (pBuffer && (bufferSize == BufferSize))
+    return true;
+
+  // Write out or drop what's buffered, and get the threads idle
+  FlushBuffer();
+  DrainWriteBehind();
+  unsigned readAhead = DiscardReadAhead();
+  if (readAhead > 0)
+    FilePos = pFile->LSeek(-(int64_t)readAhead, Seek_Cur);
+
+  uint8_t* pnewBuffer = (uint8_t*)OVR_ALLOC(bufferSize);
+  if (!pnewBuffer)
+    return false;
+  uint8_t* pnewReadAheadBuffer = NULL;
+  if (pReadAhead) {
+    pnewReadAheadBuffer = (uint8_t*)OVR_ALLOC(bufferSize);
+    if (!pnewReadAheadBuffer) {
+      OVR_FREE(pnewBuffer);
+      return false;
+    }
+  }
+
+  if (pBuffer)
+    OVR_FREE(pBuffer);
+  pBuffer = pnewBuffer;
+  BufferSize = bufferSize;
+
+  if (pReadAhead) {
+    OVR_FREE(pReadAhead->pData);
+    pReadAhead->pData = pnewReadAheadBuffer;
+  }
+
+  // The write-behind thread is idle with all its buffers free; they're reallocated as needed
+  if (pWriteBehind) {
+    std::lock_guard<std::mutex> lock(pWriteBehind->QueueMutex);
+    for (size_t i = 0; i < pWriteBehind->FreeBuffers.GetSize(); ++i)
+      OVR_FREE(pWriteBehind->FreeBuffers[i]);
+    pWriteBehind->FreeBuffers.Clear();
+  }
+
+  Pos = 0;
+  DataSize = 0;
+  return true;
+}
+
 // Initializes buffering to a certain mode
 bool BufferedFile::SetBufferMode(BufferModeType mode) {
   if (!pBuffer)
@@ -113,18 +428,26 @@ bool BufferedFile::SetBufferMode(BufferModeType mode) {
 void BufferedFile::FlushBuffer() {
   switch (BufferMode) {
     case WriteBuffer:
+      if (pWriteBehind) {
+        // Let the write-behind thread write it, and wait for it to catch up
+        QueueBuffer();
+        DrainWriteBehind();
+        break;
+      }
       // Write data in buffer
       FilePos += pFile->Write(pBuffer, Pos);
       Pos = 0;
       break;
 
-    case ReadBuffer:
-      // Seek back & reset buffer data
-      if ((DataSize - Pos) > 0)
-        FilePos = pFile->LSeek(-(int)(DataSize - Pos), Seek_Cur);
+    case ReadBuffer: {
+      // Seek back & reset buffer data, including what was read ahead of it
+      int64_t unread = (int64_t)(DataSize - Pos) + DiscardReadAhead();
+      if (unread > 0)
+        FilePos = pFile->LSeek(-unread, Seek_Cur);
       DataSize = 0;
       Pos = 0;
       break;
+    }
     default:
       // not handled!
       break;
@@ -137,8 +460,22 @@ void BufferedFile::LoadBuffer() {
     // We should only reload once all of pre-loaded buffer is consumed.
     OVR_ASSERT(Pos == DataSize);
 
+    if (pReadAhead) {
+      // Take the buffer the read-ahead thread filled, and have it fill the one just consumed
+      if (!pReadAhead->Pending)
+        pReadAhead->Start(BufferSize);
+      DataSize = DiscardReadAhead();
+      Alg::Swap(pBuffer, pReadAhead->pData);
+      Pos = 0;
+      FilePos += DataSize;
+      // A short read means the end of the file
+      if (DataSize == BufferSize)
+        pReadAhead->Start(BufferSize);
+      return;
+    }
+
     // WARNING: Right now LoadBuffer() assumes the buffer's empty
-    int sz = pFile->Read(pBuffer, FILEBUFFER_SIZE);
+    int sz = pFile->Read(pBuffer, BufferSize);
     DataSize = sz < 0 ? 0 : (unsigned)sz;
     Pos = 0;
     FilePos += DataSize;
@@ -154,6 +491,9 @@ void BufferedFile::LoadBuffer() {
 int BufferedFile::Tell() {
   if (BufferMode == ReadBuffer)
     return int(FilePos - DataSize + Pos);
+  // The underlying file lags behind while buffers are queued for write-behind
+  if (pWriteBehind && (BufferMode == WriteBuffer))
+    return int(FilePos + Pos);
 
   int pos = pFile->Tell();
   // Adjust position based on buffer mode & data
@@ -168,6 +508,8 @@ int BufferedFile::Tell() {
 int64_t BufferedFile::LTell() {
   if (BufferMode == ReadBuffer)
     return FilePos - DataSize + Pos;
+  if (pWriteBehind && (BufferMode == WriteBuffer))
+    return int64_t(FilePos + Pos);
 
   int64_t pos = pFile->LTell();
   if (pos != -1) {
@@ -179,6 +521,8 @@ int64_t BufferedFile::LTell() {
 }
 
 int BufferedFile::GetLength() {
+  DrainWriteBehind();
+  WaitReadAhead();
   int len = pFile->GetLength();
   // If writing through buffer, file length may actually be bigger
   if ((len != -1) && (BufferMode == WriteBuffer)) {
@@ -189,6 +533,8 @@ int BufferedFile::GetLength() {
   return len;
 }
 int64_t BufferedFile::LGetLength() {
+  DrainWriteBehind();
+  WaitReadAhead();
   int64_t len = pFile->LGetLength();
   // If writing through buffer, file length may actually be bigger
   if ((len != -1) && (BufferMode == WriteBuffer)) {
@@ -222,12 +568,30 @@ bool    BufferedFile::Stat(FileStats *pfs)
 */
 
 int BufferedFile::Write(const uint8_t* psourceBuffer, int numBytes) {
+  if (pWriteBehind && ((BufferMode == WriteBuffer) || SetBufferMode(WriteBuffer))) {
+    if (pWriteBehind->Failed)
+      return -1;
+
+    // Even large writes go through the buffers, so that they don't block on the disk
+    int remaining = numBytes;
+    while (remaining > 0) {
+      unsigned copyBytes = Alg::Min((unsigned)remaining, BufferSize - Pos);
+      memcpy(pBuffer + Pos, psourceBuffer, copyBytes);
+      Pos += copyBytes;
+      psourceBuffer += copyBytes;
+      remaining -= (int)copyBytes;
+      if (Pos == BufferSize)
+        QueueBuffer();
+    }
+    return numBytes;
+  }
+
   if ((BufferMode == WriteBuffer) || SetBufferMode(WriteBuffer)) {
     // If not data space in buffer, flush
-    if ((FILEBUFFER_SIZE - (int)Pos) < numBytes) {
+    if ((int)(BufferSize - Pos) < numBytes) {
       FlushBuffer();
       // If bigger then tolerance, just write directly
-      if (numBytes > FILEBUFFER_TOLERANCE) {
+      if (numBytes > (int)GetBufferTolerance()) {
         int sz = pFile->Write(psourceBuffer, numBytes);
         if (sz > 0)
           FilePos += sz;
@@ -262,9 +626,25 @@ int BufferedFile::Read(uint8_t* pdestBuffer, int numBytes) {
     pdestBuffer += readBytes;
     Pos = DataSize;
 
+    // Keep going through the buffers so that the read-ahead keeps up
+    if (pReadAhead) {
+      while (numBytes > 0) {
+        LoadBuffer();
+        if (DataSize == 0)
+          break;
+        unsigned copyBytes = Alg::Min((unsigned)numBytes, DataSize);
+        memcpy(pdestBuffer, pBuffer, copyBytes);
+        Pos = copyBytes;
+        numBytes -= (int)copyBytes;
+        pdestBuffer += copyBytes;
+        readBytes += (int)copyBytes;
+      }
+      return readBytes;
+    }
+
     // Don't reload buffer if more then tolerance
     // (No major advantage, and we don't want to write a loop)
-    if (numBytes > FILEBUFFER_TOLERANCE) {
+    if (numBytes > (int)GetBufferTolerance()) {
       numBytes = pFile->Read(pdestBuffer, numBytes);
       if (numBytes > 0) {
         FilePos += numBytes;
@@ -285,7 +665,7 @@ int BufferedFile::Read(uint8_t* pdestBuffer, int numBytes) {
 
     /*
     // Alternative Read implementation. The one above is probably better
-    // due to FILEBUFFER_TOLERANCE.
+    // due to the buffer tolerance.
     int     total = 0;
 
     do {
@@ -324,7 +704,16 @@ int BufferedFile::SkipBytes(int numBytes) {
   }
 
   if (numBytes) {
-    numBytes = pFile->SkipBytes(numBytes);
+    // The underlying file is past what was read ahead, so skip that much less
+    int readAhead = (int)DiscardReadAhead();
+    if (readAhead >= numBytes) {
+      FilePos = pFile->LSeek(numBytes - readAhead, Seek_Cur);
+      Pos = DataSize = 0;
+      return skippedBytes + numBytes;
+    }
+    numBytes = pFile->SkipBytes(numBytes - readAhead);
+    if (numBytes != -1)
+      numBytes += readAhead;
     // Make sure we return the actual number skipped, or error
     if (numBytes != -1) {
       skippedBytes += numBytes;
@@ -337,7 +726,8 @@ int BufferedFile::SkipBytes(int numBytes) {
 }
 
 int BufferedFile::BytesAvailable() {
-  int available = pFile->BytesAvailable();
+  DrainWriteBehind();
+  int available = (int)WaitReadAhead() + pFile->BytesAvailable();
   // Adjust available size based on buffers
   switch (BufferMode) {
     case ReadBuffer:
@@ -356,7 +746,8 @@ int BufferedFile::BytesAvailable() {
 
 bool BufferedFile::Flush() {
   FlushBuffer();
-  return pFile->Flush();
+  bool written = DrainWriteBehind();
+  return pFile->Flush() && written;
 }
 
 // Seeking could be optimized better..
@@ -410,6 +801,8 @@ int BufferedFile::Seek(int offset, int origin) {
   FlushBuffer();
   */
 
+  // The underlying file may be elsewhere if it read ahead, but the seek is absolute by now
+  DiscardReadAhead();
   FilePos = pFile->Seek(offset, origin);
   return int(FilePos);
 }
@@ -460,20 +853,27 @@ int64_t BufferedFile::LSeek(int64_t offset, int origin) {
       FlushBuffer();
       */
 
+  DiscardReadAhead();
   FilePos = pFile->LSeek(offset, origin);
   return FilePos;
 }
 
 int BufferedFile::CopyFromStream(File* pstream, int byteSize) {
+  // Copy within the kernel if both sides are system files
+  int copied = KernelCopyFromStream(this, pstream, byteSize);
+  if (copied >= 0)
+    return copied;
+
   // We can't rely on overridden Write()
   // because delegation doesn't override virtual pointers
   // So, just re-implement
-  uint8_t* buff = new uint8_t[0x4000];
+  const int buffSize = 0x4000;
+  uint8_t* buff = new uint8_t[buffSize];
   int count = 0;
   int szRequest, szRead, szWritten;
 
   while (byteSize) {
-    szRequest = (byteSize > int(sizeof(buff))) ? int(sizeof(buff)) : byteSize;
+    szRequest = (byteSize > buffSize) ? buffSize : byteSize;
 
     szRead = pstream->Read(buff, szRequest);
     szWritten = 0;
@@ -499,12 +899,14 @@ bool BufferedFile::Close() {
       break;
     case ReadBuffer:
       // No need to seek back on close
+      DiscardReadAhead();
       BufferMode = NoBuffer;
       break;
     default:
       break;
   }
-  return pFile->Close();
+  bool written = DrainWriteBehind();
+  return pFile->Close() && written;
 }
 
 // ***** Global path helpers
@@ -518,4 +920,71 @@ const char* OVR_CDECL GetShortFilename(const char* purl) {
   return purl;
 }
 
+int KernelCopyFromStream(File* pdest, File* psource, int byteSize) {
+#if defined(OVR_OS_LINUX)
+  const int sourceFd = psource->GetFileDescriptor();
+  const int destFd = pdest->GetFileDescriptor();
+  if ((sourceFd < 0) || (destFd < 0) || (byteSize <= 0))
+    return -1;
+
+  // Writes to an append mode descriptor always go to its end, which copy_file_range refuses
+  // and sendfile would do regardless of destOffset.
+  const int destFlags = ::fcntl(destFd, F_GETFL);
+  if ((destFlags < 0) || (destFlags & O_APPEND))
+    return -1;
+
+  // Both sides are copied at explicit offsets, as their descriptors' own positions don't
+  // account for data buffered in user space. pdest must be flushed so that its data lands
+  // before the copied data, and psource if it's being written too.
+  if (!pdest->Flush() || (psource->IsWritable() && !psource->Flush()))
+    return -1;
+  loff_t sourceOffset = psource->LTell();
+  loff_t destOffset = pdest->LTell();
+  if ((sourceOffset < 0) || (destOffset < 0))
+    return -1;
+
+  bool useSendfile = false;
+  int count = 0;
+  while (count < byteSize) {
+    ssize_t result;
+    if (!useSendfile) {
+      result = ::copy_file_range(
+          sourceFd, &sourceOffset, destFd, &destOffset, (size_t)(byteSize - count), 0);
+      // Older kernels don't support it, or not across file systems
+      if ((result < 0) && (count == 0) &&
+          ((errno == ENOSYS) || (errno == EXDEV) || (errno == EINVAL) || (errno == EOPNOTSUPP))) {
+        useSendfile = true;
+        if (::lseek(destFd, destOffset, SEEK_SET) < 0)
+          return -1;
+        continue;
+      }
+    } else {
+      // sendfile writes at the descriptor's position
+      result = ::sendfile(destFd, sourceFd, &sourceOffset, (size_t)(byteSize - count));
+      if (result > 0)
+        destOffset += result;
+    }
+
+    if (result < 0) {
+      if (errno == EINTR)
+        continue;
+      if (count == 0) // Nothing was copied, so the caller can copy through a buffer instead.
+        return -1;
+      break;
+    }
+    if (result == 0) // End of the source file.
+      break;
+    count += (int)result;
+  }
+
+  // Move both files past the copied data
+  psource->LSeek(sourceOffset, File::Seek_Set);
+  pdest->LSeek(destOffset, File::Seek_Set);
+  return count;
+#else
+  OVR_UNUSED3(pdest, psource, byteSize);
+  return -1;
+#endif
+}
+
 } // namespace OVR
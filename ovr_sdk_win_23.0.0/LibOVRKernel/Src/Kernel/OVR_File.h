@@ -146,6 +146,13 @@ class File : public RefCountBase<File>, public FileConstants {
   // Useful if any other function failed
   virtual int GetErrorCode() = 0;
 
+  // Returns the OS file descriptor the file is read and written through, or -1 if there's
+  // none. Data buffered in user space isn't reflected in it, so users must Flush first and
+  // work with explicit offsets from LTell rather than the descriptor's own position.
+  virtual int GetFileDescriptor() {
+    return -1;
+  }
+
   // ** Stream implementation & I/O
 
   // Blocking write, will write in the given number of bytes to the stream
@@ -453,6 +460,10 @@ class DelegatedFile : public File {
     return pFile->GetErrorCode();
   }
 
+  virtual int GetFileDescriptor() {
+    return pFile->GetFileDescriptor();
+  }
+
   // ** Stream implementation & I/O
   virtual int Write(const uint8_t* pbuffer, int numBytes) {
     return pFile->Write(pbuffer, numBytes);
@@ -504,6 +515,7 @@ class BufferedFile : public DelegatedFile {
 
   // Buffer & the mode it's in
   uint8_t* pBuffer;
+  unsigned BufferSize;
   BufferModeType BufferMode;
   // Position in buffer
   unsigned Pos;
@@ -521,17 +533,73 @@ class BufferedFile : public DelegatedFile {
   // WARNING: Right now LoadBuffer() assumes the buffer's empty
   void LoadBuffer();
 
+  // Write-behind thread and its queue of full buffers, if enabled
+  struct WriteBehindQueue;
+  WriteBehindQueue* pWriteBehind;
+  // Hands the write buffer to the write-behind thread and takes an empty one
+  void QueueBuffer();
+  // Waits for the write-behind thread to write out all queued buffers
+  bool DrainWriteBehind();
+
+  // Read-ahead thread and its spare buffer, if enabled
+  struct ReadAheadState;
+  ReadAheadState* pReadAhead;
+  // Waits for any read ahead to finish, and returns the number of bytes read ahead of FilePos
+  unsigned WaitReadAhead();
+  // Waits for any read ahead to finish and drops its data. Returns the number of bytes read
+  // ahead, which the caller must seek back over unless it's seeking elsewhere anyway
+  unsigned DiscardReadAhead();
+
+  // Reads larger than this bypass the buffer, unless reading ahead
+  unsigned GetBufferTolerance() const {
+    return BufferSize / 2;
+  }
+
   // Hidden constructor
   BufferedFile();
   BufferedFile(const BufferedFile&)
-      : DelegatedFile(), pBuffer(NULL), BufferMode(NoBuffer), Pos(0), DataSize(0), FilePos(0) {}
+      : DelegatedFile(),
+        pBuffer(NULL),
+        BufferSize(0),
+        BufferMode(NoBuffer),
+        Pos(0),
+        DataSize(0),
+        FilePos(0),
+        pWriteBehind(NULL),
+        pReadAhead(NULL) {}
 
  public:
+  enum { DefaultBufferSize = 8192 - 8 };
+
   // Constructor
   // - takes another file as source
-  BufferedFile(File* pfile);
+  BufferedFile(File* pfile, unsigned bufferSize = DefaultBufferSize);
   ~BufferedFile();
 
+  // Changes the buffer size, writing out or dropping what's buffered first. Large buffers
+  // cut the number of system calls for big sequential reads and writes. Returns false if the
+  // new buffer can't be allocated, in which case the old one is kept.
+  bool SetBufferSize(unsigned bufferSize);
+  unsigned GetBufferSize() const {
+    return BufferSize;
+  }
+
+  // Enables or disables read-ahead. With it enabled, a background thread reads the next
+  // buffer's worth of the file into a second buffer while the current one is being consumed,
+  // so that sequential reads overlap with the disk. Reads larger than the buffer are served
+  // through it too, rather than directly, to keep the read-ahead going. Seeking or writing
+  // drops the data read ahead.
+  // The underlying file must not be used directly while read-ahead is enabled.
+  bool SetReadAhead(bool enable);
+
+  // Enables or disables write-behind. With it enabled, full write buffers are handed to a
+  // background thread which writes them to the underlying file, so that Write only blocks on
+  // the disk when maxQueuedBuffers are already waiting. Calls which need the underlying file
+  // to be up to date, such as Flush, Seek, Read and Close, wait for the queue to drain.
+  // After a background write fails, Write returns -1 and Flush and Close return false.
+  // The underlying file must not be used directly while write-behind is enabled.
+  bool SetWriteBehind(bool enable, unsigned maxQueuedBuffers = 4);
+
   // ** Overridden functions
 
   // We override all the functions that can possibly
@@ -685,11 +753,121 @@ class MemoryFile : public File {
   bool Valid;
 };
 
+//-----------------------------------------------------------------------------------
+// ***** Mapped File
+
+// Read-only file which maps the whole file into memory instead of reading it through a
+// buffer. Read, Seek and SkipBytes are pointer arithmetic on the mapping, and GetData gives
+// consumers such as parsers direct access to the contents without any copy. The access
+// pattern is passed on to the OS as a hint for read-ahead.
+//
+// The mapping reflects later changes to the file by other processes, and truncating the file
+// while it's mapped can fault on access, so this is meant for files which aren't being
+// written, such as calibration data, recordings and assets.
+
+class MappedFile : public File {
+ public:
+  enum AccessPattern {
+    Access_Normal,
+    Access_Sequential, // Read mostly front to back; pages are read ahead aggressively.
+    Access_Random // Read-ahead is disabled.
+  };
+
+  // pfileName should be encoded as UTF-8 to support international file names.
+  MappedFile(const char* pfileName, AccessPattern pattern = Access_Sequential);
+  MappedFile(const String& fileName, AccessPattern pattern = Access_Sequential);
+  ~MappedFile();
+
+  // The contents of the file, valid until it's closed. Not null-terminated.
+  const uint8_t* GetData() const {
+    return pData;
+  }
+  size_t GetDataSize() const {
+    return (size_t)DataSize;
+  }
+
+  // ** File interface
+
+  const char* GetFilePath() {
+    return FilePath.ToCStr();
+  }
+
+  bool IsValid() {
+    return Valid;
+  }
+  bool IsWritable() {
+    return false;
+  }
+
+  int Tell() {
+    return (int)Pos;
+  }
+  int64_t LTell() {
+    return (int64_t)Pos;
+  }
+
+  int GetLength() {
+    return (int)DataSize;
+  }
+  int64_t LGetLength() {
+    return (int64_t)DataSize;
+  }
+
+  int GetErrorCode() {
+    return ErrorCode;
+  }
+
+  int Write(const uint8_t* pbuffer, int numBytes) {
+    OVR_UNUSED2(pbuffer, numBytes);
+    return -1;
+  }
+
+  int Read(uint8_t* pbuffer, int numBytes);
+  int SkipBytes(int numBytes);
+
+  int BytesAvailable() {
+    return (int)Alg::Min(DataSize - Pos, (uint64_t)INT_MAX);
+  }
+
+  bool Flush() {
+    return true;
+  }
+
+  int Seek(int offset, int origin = Seek_Set) {
+    return (int)LSeek(offset, origin);
+  }
+  int64_t LSeek(int64_t offset, int origin = Seek_Set);
+
+  int CopyFromStream(File* pstream, int byteSize) {
+    OVR_UNUSED2(pstream, byteSize);
+    return -1;
+  }
+
+  bool Close();
+
+ private:
+  void Open(AccessPattern pattern);
+
+  String FilePath;
+  const uint8_t* pData;
+  uint64_t DataSize;
+  uint64_t Pos;
+  int ErrorCode;
+  bool Valid;
+};
+
 // ***** Global path helpers
 
 // Find trailing short filename in a path.
 const char* OVR_CDECL GetShortFilename(const char* purl);
 
+// Copies byteSize bytes from the current position of psource to the current position of
+// pdest within the kernel, where both have file descriptors and the OS supports it
+// (copy_file_range, or sendfile). Both positions are advanced past the copied data.
+// Returns the number of bytes copied, or -1 without copying anything if the files or the OS
+// don't support it; CopyFromStream implementations then copy through a buffer instead.
+int KernelCopyFromStream(File* pdest, File* psource, int byteSize);
+
 } // namespace OVR
 
 #endif
@@ -167,6 +167,7 @@ class FILEFile : public File {
 
   //  virtual bool        Stat(FileStats *pfs);
   virtual int GetErrorCode();
+  virtual int GetFileDescriptor();
 
   // ** Stream implementation & I/O
   virtual int Write(const uint8_t* pbuffer, int numBytes);
@@ -318,6 +319,16 @@ int FILEFile::GetErrorCode() {
   return ErrorCode;
 }
 
+int FILEFile::GetFileDescriptor() {
+  if (!Opened || !fs)
+    return -1;
+#if defined(OVR_OS_MS)
+  return _fileno(fs);
+#else
+  return fileno(fs);
+#endif
+}
+
 // ** Stream implementation & I/O
 int FILEFile::Write(const uint8_t* pbuffer, int numBytes) {
   if (LastOp && LastOp != Open_Write)
@@ -442,12 +453,18 @@ int64_t FILEFile::LSeek(int64_t offset, int origin) {
 }
 
 int FILEFile::CopyFromStream(File* pstream, int byteSize) {
-  uint8_t* buff = new uint8_t[0x4000];
+  // Copy within the kernel if both sides are system files
+  int copied = KernelCopyFromStream(this, pstream, byteSize);
+  if (copied >= 0)
+    return copied;
+
+  const int buffSize = 0x4000;
+  uint8_t* buff = new uint8_t[buffSize];
   int count = 0;
   int szRequest, szRead, szWritten;
 
   while (byteSize) {
-    szRequest = (byteSize > int(sizeof(buff))) ? int(sizeof(buff)) : byteSize;
+    szRequest = (byteSize > buffSize) ? buffSize : byteSize;
 
     szRead = pstream->Read(buff, szRequest);
     szWritten = 0;
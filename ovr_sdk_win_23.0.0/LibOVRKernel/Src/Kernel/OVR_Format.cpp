@@ -0,0 +1,851 @@
+/************************************************************************************
+
+Filename    :   OVR_Format.cpp
+Content     :   Allocation-free, type-safe "{}" string formatting
+Created     :   October 18, 2026
+Notes       :   The floating point conversion is Grisu2, from Florian Loitsch's "Printing
+                Floating-Point Numbers Quickly and Accurately with Integers" (PLDI 2010).
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+#include "OVR_Format.h"
+#include "OVR_Allocator.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <limits>
+
+namespace OVR {
+
+//-----------------------------------------------------------------------------------
+// ***** Integer conversion
+
+static const char DigitPairs[201] =
+    "00010203040506070809101112131415161718192021222324"
+    "25262728293031323334353637383940414243444546474849"
+    "50515253545556575859606162636465666768697071727374"
+    "75767778798081828384858687888990919293949596979899";
+
+static size_t CountDigits(uint64_t value) {
+  size_t count = 1;
+  for (;;) {
+    if (value < 10)
+      return count;
+    if (value < 100)
+      return count + 1;
+    if (value < 1000)
+      return count + 2;
+    if (value < 10000)
+      return count + 3;
+    value /= 10000;
+    count += 4;
+  }
+}
+
+size_t FormatInteger(char* buffer, uint64_t value) {
+  const size_t length = CountDigits(value);
+  char* p = buffer + length;
+
+  // Two digits per division.
+  while (value >= 100) {
+    const size_t i = (size_t)(value % 100) * 2;
+    value /= 100;
+    *--p = DigitPairs[i + 1];
+    *--p = DigitPairs[i];
+  }
+
+  if (value >= 10) {
+    const size_t i = (size_t)value * 2;
+    *--p = DigitPairs[i + 1];
+    *--p = DigitPairs[i];
+  } else {
+    *--p = (char)('0' + value);
+  }
+
+  return length;
+}
+
+size_t FormatInteger(char* buffer, int64_t value) {
+  if (value < 0) {
+    buffer[0] = '-';
+    return 1 + FormatInteger(buffer + 1, 0 - (uint64_t)value);
+  }
+  return FormatInteger(buffer, (uint64_t)value);
+}
+
+static size_t FormatHex(char* buffer, uint64_t value, bool upperCase) {
+  const char* digits = upperCase ? "0123456789ABCDEF" : "0123456789abcdef";
+  size_t length = 1;
+  while ((length < 16) && (value >> (length * 4)))
+    ++length;
+
+  for (size_t i = length; i > 0; --i, value >>= 4)
+    buffer[i - 1] = digits[value & 15];
+
+  return length;
+}
+
+//-----------------------------------------------------------------------------------
+// ***** Floating point conversion (Grisu2)
+//
+// The value and the boundaries of its rounding interval are scaled by a cached power of ten
+// so that the binary exponent lands in [Alpha, Gamma], at which point the integral part of
+// the upper boundary fits in 32 bits and the digits can be generated with integer
+// arithmetic. Digit generation stops as soon as the digits are within the (conservatively
+// narrowed) rounding interval, so the result always reads back as the same value, and is the
+// shortest such string in all but a tiny fraction of cases.
+
+namespace {
+
+struct DiyFp {
+  uint64_t F;
+  int E;
+};
+
+// Returns a - b for two numbers with the same exponent.
+DiyFp DiyFpSub(const DiyFp& a, const DiyFp& b) {
+  OVR_ASSERT((a.E == b.E) && (a.F >= b.F));
+  DiyFp result = {a.F - b.F, a.E};
+  return result;
+}
+
+// Returns the upper 64 bits of the 128 bit product, rounded.
+DiyFp DiyFpMul(const DiyFp& a, const DiyFp& b) {
+  const uint64_t aLo = a.F & 0xFFFFFFFFu;
+  const uint64_t aHi = a.F >> 32;
+  const uint64_t bLo = b.F & 0xFFFFFFFFu;
+  const uint64_t bHi = b.F >> 32;
+
+  const uint64_t p0 = aLo * bLo;
+  const uint64_t p1 = aLo * bHi;
+  const uint64_t p2 = aHi * bLo;
+  const uint64_t p3 = aHi * bHi;
+
+  uint64_t middle = (p0 >> 32) + (p1 & 0xFFFFFFFFu) + (p2 & 0xFFFFFFFFu);
+  middle += uint64_t(1) << 31;
+
+  DiyFp result = {p3 + (p1 >> 32) + (p2 >> 32) + (middle >> 32), a.E + b.E + 64};
+  return result;
+}
+
+DiyFp DiyFpNormalize(DiyFp x) {
+  OVR_ASSERT(x.F != 0);
+  while ((x.F >> 63) == 0) {
+    x.F <<= 1;
+    x.E--;
+  }
+  return x;
+}
+
+DiyFp DiyFpNormalizeTo(const DiyFp& x, int e) {
+  OVR_ASSERT((x.E >= e) && ((x.E - e) < 64));
+  DiyFp result = {x.F << (x.E - e), e};
+  return result;
+}
+
+// The value and the boundaries m- and m+ of the interval of real numbers which round to it,
+// with m+ normalized and m- given the same exponent as m+.
+struct FloatBoundaries {
+  DiyFp W;
+  DiyFp Minus;
+  DiyFp Plus;
+};
+
+// value must be finite and positive.
+template <typename FloatType, typename BitsType>
+FloatBoundaries ComputeBoundaries(FloatType value) {
+  const int Precision = std::numeric_limits<FloatType>::digits; // Including the hidden bit.
+  const int Bias = std::numeric_limits<FloatType>::max_exponent - 1 + (Precision - 1);
+  const int MinExponent = 1 - Bias;
+  const uint64_t HiddenBit = uint64_t(1) << (Precision - 1);
+
+  BitsType bits;
+  memcpy(&bits, &value, sizeof(bits));
+  const uint64_t exponentBits = uint64_t(bits) >> (Precision - 1);
+  const uint64_t fractionBits = uint64_t(bits) & (HiddenBit - 1);
+
+  DiyFp v;
+  if (exponentBits == 0) {
+    v.F = fractionBits;
+    v.E = MinExponent;
+  } else {
+    v.F = fractionBits + HiddenBit;
+    v.E = (int)exponentBits - Bias;
+  }
+
+  // The gap to the next lower float is half as large when v is a power of two, unless v
+  // is the smallest normalized number.
+  const bool lowerBoundaryIsCloser = (fractionBits == 0) && (exponentBits > 1);
+
+  DiyFp plus = {(v.F << 1) + 1, v.E - 1};
+  DiyFp minus;
+  if (lowerBoundaryIsCloser) {
+    minus.F = (v.F << 2) - 1;
+    minus.E = v.E - 2;
+  } else {
+    minus.F = (v.F << 1) - 1;
+    minus.E = v.E - 1;
+  }
+
+  FloatBoundaries result;
+  result.Plus = DiyFpNormalize(plus);
+  result.Minus = DiyFpNormalizeTo(minus, result.Plus.E);
+  result.W = DiyFpNormalize(v);
+  return result;
+}
+
+struct CachedPower {
+  uint64_t F;
+  int E;
+  int K; // Decimal exponent.
+};
+
+// Normalized 10^K for K = -300, -292, ..., 324, rounded to 64 bits.
+// This covers every binary exponent that a normalized double's boundaries can have.
+const CachedPower CachedPowers[] = {
+      {0xAB70FE17C79AC6CA, -1060, -300},
+      {0xFF77B1FCBEBCDC4F, -1034, -292},
+      {0xBE5691EF416BD60C, -1007, -284},
+      {0x8DD01FAD907FFC3C, -980, -276},
+      {0xD3515C2831559A83, -954, -268},
+      {0x9D71AC8FADA6C9B5, -927, -260},
+      {0xEA9C227723EE8BCB, -901, -252},
+      {0xAECC49914078536D, -874, -244},
+      {0x823C12795DB6CE57, -847, -236},
+      {0xC21094364DFB5637, -821, -228},
+      {0x9096EA6F3848984F, -794, -220},
+      {0xD77485CB25823AC7, -768, -212},
+      {0xA086CFCD97BF97F4, -741, -204},
+      {0xEF340A98172AACE5, -715, -196},
+      {0xB23867FB2A35B28E, -688, -188},
+      {0x84C8D4DFD2C63F3B, -661, -180},
+      {0xC5DD44271AD3CDBA, -635, -172},
+      {0x936B9FCEBB25C996, -608, -164},
+      {0xDBAC6C247D62A584, -582, -156},
+      {0xA3AB66580D5FDAF6, -555, -148},
+      {0xF3E2F893DEC3F126, -529, -140},
+      {0xB5B5ADA8AAFF80B8, -502, -132},
+      {0x87625F056C7C4A8B, -475, -124},
+      {0xC9BCFF6034C13053, -449, -116},
+      {0x964E858C91BA2655, -422, -108},
+      {0xDFF9772470297EBD, -396, -100},
+      {0xA6DFBD9FB8E5B88F, -369, -92},
+      {0xF8A95FCF88747D94, -343, -84},
+      {0xB94470938FA89BCF, -316, -76},
+      {0x8A08F0F8BF0F156B, -289, -68},
+      {0xCDB02555653131B6, -263, -60},
+      {0x993FE2C6D07B7FAC, -236, -52},
+      {0xE45C10C42A2B3B06, -210, -44},
+      {0xAA242499697392D3, -183, -36},
+      {0xFD87B5F28300CA0E, -157, -28},
+      {0xBCE5086492111AEB, -130, -20},
+      {0x8CBCCC096F5088CC, -103, -12},
+      {0xD1B71758E219652C, -77, -4},
+      {0x9C40000000000000, -50, 4},
+      {0xE8D4A51000000000, -24, 12},
+      {0xAD78EBC5AC620000, 3, 20},
+      {0x813F3978F8940984, 30, 28},
+      {0xC097CE7BC90715B3, 56, 36},
+      {0x8F7E32CE7BEA5C70, 83, 44},
+      {0xD5D238A4ABE98068, 109, 52},
+      {0x9F4F2726179A2245, 136, 60},
+      {0xED63A231D4C4FB27, 162, 68},
+      {0xB0DE65388CC8ADA8, 189, 76},
+      {0x83C7088E1AAB65DB, 216, 84},
+      {0xC45D1DF942711D9A, 242, 92},
+      {0x924D692CA61BE758, 269, 100},
+      {0xDA01EE641A708DEA, 295, 108},
+      {0xA26DA3999AEF774A, 322, 116},
+      {0xF209787BB47D6B85, 348, 124},
+      {0xB454E4A179DD1877, 375, 132},
+      {0x865B86925B9BC5C2, 402, 140},
+      {0xC83553C5C8965D3D, 428, 148},
+      {0x952AB45CFA97A0B3, 455, 156},
+      {0xDE469FBD99A05FE3, 481, 164},
+      {0xA59BC234DB398C25, 508, 172},
+      {0xF6C69A72A3989F5C, 534, 180},
+      {0xB7DCBF5354E9BECE, 561, 188},
+      {0x88FCF317F22241E2, 588, 196},
+      {0xCC20CE9BD35C78A5, 614, 204},
+      {0x98165AF37B2153DF, 641, 212},
+      {0xE2A0B5DC971F303A, 667, 220},
+      {0xA8D9D1535CE3B396, 694, 228},
+      {0xFB9B7CD9A4A7443C, 720, 236},
+      {0xBB764C4CA7A44410, 747, 244},
+      {0x8BAB8EEFB6409C1A, 774, 252},
+      {0xD01FEF10A657842C, 800, 260},
+      {0x9B10A4E5E9913129, 827, 268},
+      {0xE7109BFBA19C0C9D, 853, 276},
+      {0xAC2820D9623BF429, 880, 284},
+      {0x80444B5E7AA7CF85, 907, 292},
+      {0xBF21E44003ACDD2D, 933, 300},
+      {0x8E679C2F5E44FF8F, 960, 308},
+      {0xD433179D9C8CB841, 986, 316},
+      {0x9E19DB92B4E31BA9, 1013, 324},
+};
+
+const int CachedPowersMinK = -300;
+const int CachedPowersStepK = 8;
+
+const int Alpha = -60;
+const int Gamma = -32;
+
+// Returns the cached power c = 2^c.E * c.F such that Alpha <= e + c.E + 64 <= Gamma.
+const CachedPower& GetCachedPower(int e) {
+  // k = ceil((Alpha - e - 1) * log10(2)). 78913 / 2^18 is a close enough log10(2).
+  const int f = Alpha - e - 1;
+  const int k = (f * 78913) / (1 << 18) + ((f > 0) ? 1 : 0);
+  const int index = (k - CachedPowersMinK + (CachedPowersStepK - 1)) / CachedPowersStepK;
+  OVR_ASSERT((index >= 0) && (index < (int)OVR_ARRAY_COUNT(CachedPowers)));
+
+  const CachedPower& cached = CachedPowers[index];
+  OVR_ASSERT((Alpha <= (e + cached.E + 64)) && ((e + cached.E + 64) <= Gamma));
+  return cached;
+}
+
+// Returns the number of decimal digits in n, and the largest power of ten <= n.
+int FindLargestPow10(uint32_t n, uint32_t& pow10) {
+  static const uint32_t Powers[] = {
+      1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+  int digits = 10;
+  while ((digits > 1) && (n < Powers[digits - 1]))
+    --digits;
+  pow10 = Powers[digits - 1];
+  return digits;
+}
+
+// Moves the last digit towards w while the result stays within the rounding interval.
+void Grisu2Round(
+    char* digits,
+    int length,
+    uint64_t dist,
+    uint64_t delta,
+    uint64_t rest,
+    uint64_t tenK) {
+  while ((rest < dist) && ((delta - rest) >= tenK) &&
+         (((rest + tenK) < dist) || ((dist - rest) > (rest + tenK - dist)))) {
+    digits[length - 1]--;
+    rest += tenK;
+  }
+}
+
+// Generates the digits of a number in (mMinus, mPlus) as close to w as possible.
+// On return, the value is digits * 10^decimalExponent.
+int Grisu2DigitGen(char* digits, int& decimalExponent, DiyFp mMinus, DiyFp w, DiyFp mPlus) {
+  OVR_ASSERT((mPlus.E >= Alpha) && (mPlus.E <= Gamma));
+
+  uint64_t delta = DiyFpSub(mPlus, mMinus).F;
+  uint64_t dist = DiyFpSub(mPlus, w).F;
+
+  // Split mPlus into its integral part p1 and fractional part p2, using one = 2^-e.
+  const int shift = -mPlus.E;
+  const uint64_t one = uint64_t(1) << shift;
+  uint32_t p1 = (uint32_t)(mPlus.F >> shift);
+  uint64_t p2 = mPlus.F & (one - 1);
+  OVR_ASSERT(p1 > 0);
+
+  int length = 0;
+  uint32_t pow10;
+  int n = FindLargestPow10(p1, pow10);
+
+  while (n > 0) {
+    const uint32_t d = p1 / pow10;
+    p1 %= pow10;
+    digits[length++] = (char)('0' + d);
+    --n;
+
+    const uint64_t rest = (uint64_t(p1) << shift) + p2;
+    if (rest <= delta) {
+      decimalExponent += n;
+      Grisu2Round(digits, length, dist, delta, rest, uint64_t(pow10) << shift);
+      return length;
+    }
+
+    pow10 /= 10;
+  }
+
+  // The integral part was not enough; continue with the fractional part.
+  int m = 0;
+  for (;;) {
+    p2 *= 10;
+    const uint64_t d = p2 >> shift;
+    p2 &= one - 1;
+    digits[length++] = (char)('0' + d);
+    ++m;
+
+    delta *= 10;
+    dist *= 10;
+    if (p2 <= delta)
+      break;
+  }
+
+  decimalExponent -= m;
+  Grisu2Round(digits, length, dist, delta, p2, one);
+  return length;
+}
+
+int Grisu2(char* digits, int& decimalExponent, const FloatBoundaries& boundaries) {
+  const CachedPower& cached = GetCachedPower(boundaries.Plus.E);
+  const DiyFp c = {cached.F, cached.E};
+
+  const DiyFp w = DiyFpMul(boundaries.W, c);
+  const DiyFp wMinus = DiyFpMul(boundaries.Minus, c);
+  const DiyFp wPlus = DiyFpMul(boundaries.Plus, c);
+
+  // The products can be off by one ulp, so narrow the interval to stay inside it.
+  const DiyFp mMinus = {wMinus.F + 1, wMinus.E};
+  const DiyFp mPlus = {wPlus.F - 1, wPlus.E};
+
+  decimalExponent = -cached.K;
+  return Grisu2DigitGen(digits, decimalExponent, mMinus, w, mPlus);
+}
+
+// Writes digits * 10^decimalExponent in plain notation if the decimal exponent of the
+// result is in [-4, 15), and in scientific notation otherwise.
+size_t WriteDecimal(char* buffer, const char* digits, int length, int decimalExponent) {
+  const int point = length + decimalExponent; // Position of the decimal point in the digits.
+  char* p = buffer;
+
+  if ((length <= point) && (point <= 15)) {
+    // 123e2 -> 12300
+    memcpy(p, digits, length);
+    memset(p + length, '0', point - length);
+    p += point;
+  } else if ((0 < point) && (point <= 15)) {
+    // 123e-1 -> 12.3
+    memcpy(p, digits, point);
+    p[point] = '.';
+    memcpy(p + point + 1, digits + point, length - point);
+    p += length + 1;
+  } else if ((-4 < point) && (point <= 0)) {
+    // 123e-5 -> 0.00123
+    p[0] = '0';
+    p[1] = '.';
+    memset(p + 2, '0', -point);
+    memcpy(p + 2 - point, digits, length);
+    p += 2 - point + length;
+  } else {
+    // 123e20 -> 1.23e+22
+    *p++ = digits[0];
+    if (length > 1) {
+      *p++ = '.';
+      memcpy(p, digits + 1, length - 1);
+      p += length - 1;
+    }
+
+    int exponent = point - 1;
+    *p++ = 'e';
+    *p++ = (exponent < 0) ? '-' : '+';
+    if (exponent < 0)
+      exponent = -exponent;
+
+    if (exponent >= 100) {
+      *p++ = (char)('0' + exponent / 100);
+      exponent %= 100;
+    }
+    *p++ = DigitPairs[exponent * 2];
+    *p++ = DigitPairs[exponent * 2 + 1];
+  }
+
+  return (size_t)(p - buffer);
+}
+
+template <typename FloatType, typename BitsType>
+size_t FormatFloatingPointImpl(char* buffer, FloatType value) {
+  if (value != value) {
+    memcpy(buffer, "nan", 3);
+    return 3;
+  }
+
+  size_t signLength = 0;
+  if (signbit(value)) {
+    buffer[signLength++] = '-';
+    value = -value;
+  }
+
+  if (value > std::numeric_limits<FloatType>::max()) {
+    memcpy(buffer + signLength, "inf", 3);
+    return signLength + 3;
+  }
+
+  if (value == 0) {
+    buffer[signLength] = '0';
+    return signLength + 1;
+  }
+
+  char digits[20];
+  int decimalExponent;
+  const int length =
+      Grisu2(digits, decimalExponent, ComputeBoundaries<FloatType, BitsType>(value));
+  return signLength + WriteDecimal(buffer + signLength, digits, length, decimalExponent);
+}
+
+} // namespace
+
+size_t FormatFloatingPoint(char* buffer, double value) {
+  return FormatFloatingPointImpl<double, uint64_t>(buffer, value);
+}
+
+size_t FormatFloatingPoint(char* buffer, float value) {
+  return FormatFloatingPointImpl<float, uint32_t>(buffer, value);
+}
+
+//-----------------------------------------------------------------------------------
+// ***** FormatBufferBase
+
+FormatBufferBase::~FormatBufferBase() {
+  if (pData != pInlineData)
+    OVR_FREE(pData);
+}
+
+bool FormatBufferBase::Grow(size_t extra) {
+  const size_t required = Size + extra;
+  if (required < Size) // Overflow
+    return false;
+  if (required <= Capacity)
+    return true;
+
+  size_t newCapacity = Capacity * 2;
+  if (newCapacity < required)
+    newCapacity = required;
+
+  char* newData = (char*)OVR_ALLOC(newCapacity + 1);
+  OVR_ASSERT(newData != nullptr);
+  if (!newData)
+    return false;
+
+  memcpy(newData, pData, Size + 1);
+  if (pData != pInlineData)
+    OVR_FREE(pData);
+
+  pData = newData;
+  Capacity = newCapacity;
+  return true;
+}
+
+void FormatBufferBase::AppendChars(char c, size_t count) {
+  char* dest = GetAppendBuffer(count);
+  if (dest) {
+    memset(dest, c, count);
+    CommitAppend(count);
+  }
+}
+
+void FormatBufferBase::AppendString(const char* str, size_t size) {
+  if (!str)
+    return;
+  if (size == StringIsNullTerminated)
+    size = OVR_strlen(str);
+
+  char* dest = GetAppendBuffer(size);
+  if (dest) {
+    memcpy(dest, str, size);
+    CommitAppend(size);
+  }
+}
+
+void FormatBufferBase::AppendFormatV(const char* format, va_list argList) {
+  va_list argListSaved;
+  va_copy(argListSaved, argList);
+  const int requiredStrlen = vsnprintf(pData + Size, Capacity - Size + 1, format, argListSaved);
+  va_end(argListSaved);
+
+  if (requiredStrlen < 0) { // If there was a printf format error...
+    pData[Size] = 0;
+    return;
+  }
+
+  if ((size_t)requiredStrlen > (Capacity - Size)) { // If the output was truncated...
+    char* dest = GetAppendBuffer((size_t)requiredStrlen);
+    if (!dest) {
+      pData[Size] = 0;
+      return;
+    }
+
+    va_copy(argListSaved, argList);
+    vsnprintf(dest, (size_t)requiredStrlen + 1, format, argListSaved);
+    va_end(argListSaved);
+  }
+
+  CommitAppend((size_t)requiredStrlen);
+}
+
+void FormatBufferBase::AppendFormat(const char* format, ...) {
+  va_list argList;
+  va_start(argList, format);
+  AppendFormatV(format, argList);
+  va_end(argList);
+}
+
+//-----------------------------------------------------------------------------------
+// ***** FormatArgsTo
+
+namespace {
+
+struct FormatSpec {
+  size_t Width;
+  int Precision; // -1 if not specified.
+  char Type; // 0 if not specified.
+  bool ZeroPad;
+};
+
+// Parses the part of a placeholder between the braces.
+FormatSpec ParseFormatSpec(const char* spec, const char* specEnd) {
+  FormatSpec result = {0, -1, 0, false};
+
+  if ((spec == specEnd) || (*spec++ != ':')) {
+    OVR_ASSERT_M(spec == specEnd, "Format placeholder spec must start with ':'");
+    return result;
+  }
+
+  if ((spec < specEnd) && (*spec == '0')) {
+    result.ZeroPad = true;
+    ++spec;
+  }
+  while ((spec < specEnd) && (*spec >= '0') && (*spec <= '9'))
+    result.Width = (result.Width * 10) + (*spec++ - '0');
+
+  if ((spec < specEnd) && (*spec == '.')) {
+    result.Precision = 0;
+    ++spec;
+    while ((spec < specEnd) && (*spec >= '0') && (*spec <= '9'))
+      result.Precision = (result.Precision * 10) + (*spec++ - '0');
+  }
+
+  if (spec < specEnd)
+    result.Type = *spec++;
+
+  OVR_ASSERT_M(spec == specEnd, "Invalid format placeholder spec");
+  return result;
+}
+
+void FormatNumber(
+    FormatBufferBase& buffer,
+    size_t (*format)(char*, uint64_t, bool),
+    uint64_t value,
+    bool flag) {
+  char* dest = buffer.GetAppendBuffer(FormatNumberCapacity);
+  if (dest)
+    buffer.CommitAppend(format(dest, value, flag));
+}
+
+void FormatFloatWithPrintf(FormatBufferBase& buffer, double value, const FormatSpec& spec) {
+  char printfFormat[] = "%.*g";
+  if ((spec.Type == 'f') || (spec.Type == 'e') || (spec.Type == 'g'))
+    printfFormat[3] = spec.Type;
+  else
+    OVR_ASSERT_M(spec.Type == 0, "Invalid format type for a floating point argument");
+
+  const int precision = (spec.Precision >= 0) ? spec.Precision : 6;
+  const size_t start = buffer.GetSize();
+
+  char local[64];
+  const int requiredStrlen = snprintf(local, sizeof(local), printfFormat, precision, value);
+  if (requiredStrlen < 0)
+    return;
+
+  if ((size_t)requiredStrlen < sizeof(local)) {
+    buffer.AppendString(local, (size_t)requiredStrlen);
+  } else {
+    char* dest = buffer.GetAppendBuffer((size_t)requiredStrlen);
+    if (!dest)
+      return;
+    snprintf(dest, (size_t)requiredStrlen + 1, printfFormat, precision, value);
+    buffer.CommitAppend((size_t)requiredStrlen);
+  }
+
+  // printf writes the locale's decimal point, which isn't necessarily '.'.
+  char* written = const_cast<char*>(buffer.ToCStr()) + start;
+  for (char* p = written; *p; ++p) {
+    if ((*p == ',') || (*p == '\'')) {
+      *p = '.';
+      break;
+    }
+  }
+}
+
+size_t FormatDecimalUInt(char* dest, uint64_t value, bool) {
+  return FormatInteger(dest, value);
+}
+
+size_t FormatHexUInt(char* dest, uint64_t value, bool upperCase) {
+  return FormatHex(dest, value, upperCase);
+}
+
+size_t FormatPointer(char* dest, uint64_t value, bool upperCase) {
+  dest[0] = '0';
+  dest[1] = 'x';
+  return 2 + FormatHex(dest + 2, value, upperCase);
+}
+
+void FormatIntegerArg(
+    FormatBufferBase& buffer,
+    uint64_t magnitude,
+    bool negative,
+    const FormatSpec& spec) {
+  if (negative)
+    buffer.AppendChar('-');
+
+  if ((spec.Type == 'x') || (spec.Type == 'X')) {
+    FormatNumber(buffer, FormatHexUInt, magnitude, spec.Type == 'X');
+  } else {
+    OVR_ASSERT_M((spec.Type == 0) || (spec.Type == 'd'), "Invalid format type for an integer");
+    FormatNumber(buffer, FormatDecimalUInt, magnitude, false);
+  }
+}
+
+void FormatOneArg(FormatBufferBase& buffer, const FormatArg& arg, const FormatSpec& spec) {
+  const size_t start = buffer.GetSize();
+  bool numeric = true;
+
+  switch (arg.Type) {
+    case FormatArg::TypeBool:
+      buffer.AppendString(arg.Int ? "true" : "false");
+      numeric = false;
+      break;
+
+    case FormatArg::TypeChar:
+      buffer.AppendChar((char)arg.Int);
+      numeric = false;
+      break;
+
+    case FormatArg::TypeInt:
+      FormatIntegerArg(
+          buffer,
+          (arg.Int < 0) ? (0 - (uint64_t)arg.Int) : (uint64_t)arg.Int,
+          arg.Int < 0,
+          spec);
+      break;
+
+    case FormatArg::TypeUInt:
+      FormatIntegerArg(buffer, arg.UInt, false, spec);
+      break;
+
+    case FormatArg::TypeFloat:
+    case FormatArg::TypeDouble:
+      if ((spec.Type == 0) && (spec.Precision < 0)) {
+        char* dest = buffer.GetAppendBuffer(FormatNumberCapacity);
+        if (dest) {
+          buffer.CommitAppend(
+              (arg.Type == FormatArg::TypeFloat) ? FormatFloatingPoint(dest, arg.Float)
+                                                 : FormatFloatingPoint(dest, arg.Double));
+        }
+      } else {
+        FormatFloatWithPrintf(
+            buffer, (arg.Type == FormatArg::TypeFloat) ? (double)arg.Float : arg.Double, spec);
+      }
+      break;
+
+    case FormatArg::TypeString:
+      buffer.AppendString(arg.Str.pData, arg.Str.Size);
+      numeric = false;
+      break;
+
+    case FormatArg::TypePointer:
+      FormatNumber(buffer, FormatPointer, (uint64_t)(uintptr_t)arg.Pointer, spec.Type == 'X');
+      break;
+
+    case FormatArg::TypeNone:
+      break;
+  }
+
+  // Right-align to the requested width.
+  const size_t written = buffer.GetSize() - start;
+  if (spec.Width > written) {
+    const size_t padding = spec.Width - written;
+    char* dest = buffer.GetAppendBuffer(padding);
+    if (!dest)
+      return;
+
+    char* value = dest - written;
+    size_t prefixLength = 0;
+    char padChar = ' ';
+
+    if (spec.ZeroPad && numeric) {
+      padChar = '0';
+      if ((written > 0) && ((value[0] == '-') || (value[0] == '+')))
+        prefixLength = 1;
+      if ((arg.Type == FormatArg::TypePointer) && (written >= 2))
+        prefixLength = 2; // After the "0x"
+    }
+
+    memmove(value + prefixLength + padding, value + prefixLength, written - prefixLength);
+    memset(value + prefixLength, padChar, padding);
+    buffer.CommitAppend(padding);
+  }
+}
+
+} // namespace
+
+void FormatArgsTo(
+    FormatBufferBase& buffer,
+    const char* format,
+    const FormatArg* args,
+    size_t argCount) {
+  size_t argIndex = 0;
+  const char* p = format ? format : "";
+
+  while (*p) {
+    const char* literal = p;
+    while (*p && (*p != '{') && (*p != '}'))
+      ++p;
+    if (p != literal)
+      buffer.AppendString(literal, (size_t)(p - literal));
+    if (!*p)
+      break;
+
+    if (p[1] == p[0]) { // "{{" or "}}"
+      buffer.AppendChar(*p);
+      p += 2;
+      continue;
+    }
+
+    if (*p == '}') {
+      OVR_FAIL_M("Unmatched '}' in format string");
+      buffer.AppendChar('}');
+      ++p;
+      continue;
+    }
+
+    const char* specEnd = p + 1;
+    while (*specEnd && (*specEnd != '}'))
+      ++specEnd;
+
+    if (!*specEnd) {
+      OVR_FAIL_M("Unmatched '{' in format string");
+      buffer.AppendString(p);
+      break;
+    }
+
+    if (argIndex < argCount) {
+      FormatOneArg(buffer, args[argIndex++], ParseFormatSpec(p + 1, specEnd));
+    } else {
+      OVR_FAIL_M("Format string has more placeholders than arguments");
+      buffer.AppendString(p, (size_t)(specEnd + 1 - p));
+    }
+
+    p = specEnd + 1;
+  }
+
+  OVR_ASSERT_M(argIndex == argCount, "Format string has fewer placeholders than arguments");
+}
+
+} // namespace OVR
@@ -0,0 +1,364 @@
+/************************************************************************************
+
+Filename    :   OVR_Format.h
+Content     :   Allocation-free, type-safe "{}" string formatting
+Created     :   October 18, 2026
+Notes       :
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+#ifndef OVR_Format_h
+#define OVR_Format_h
+
+#include <stdarg.h>
+#include <cstddef>
+#include <string>
+#include <type_traits>
+#include "OVR_String.h"
+#include "OVR_Types.h"
+
+namespace OVR {
+
+//-----------------------------------------------------------------------------------
+// ***** Number conversion
+//
+// These write the number without a terminating null and return the number of chars written.
+// The buffer must have at least FormatNumberCapacity chars of space.
+//
+// The floating point versions write a decimal string which reads back as exactly the same
+// value, and which is the shortest such string for all but a small fraction of values
+// (Grisu2). It is in plain notation for decimal exponents in [-4, 15) and in scientific
+// notation otherwise: "0.1", "-2.5", "1000000", "1e+21", "5e-324".
+// The output doesn't depend on the C locale. NaN and infinity are written as "nan" and "inf".
+// A float is written with the digits needed to read it back as a float, so 0.1f is "0.1".
+
+enum { FormatNumberCapacity = 32 };
+
+size_t FormatInteger(char* buffer, int64_t value);
+size_t FormatInteger(char* buffer, uint64_t value);
+size_t FormatFloatingPoint(char* buffer, double value);
+size_t FormatFloatingPoint(char* buffer, float value);
+
+//-----------------------------------------------------------------------------------
+// ***** FormatBufferBase
+//
+// The growable char buffer written by FormatTo. The storage starts out as the fixed-capacity
+// array owned by the derived FormatBuffer<N> (normally on the stack), and moves to the heap
+// only if the output doesn't fit in it. The contents are always null-terminated.
+//
+// If a heap allocation fails the buffer keeps what it had and further output is dropped.
+
+class FormatBufferBase {
+ public:
+  const char* ToCStr() const {
+    return pData;
+  }
+  operator const char*() const {
+    return pData;
+  }
+
+  size_t GetSize() const {
+    return Size;
+  }
+  bool IsEmpty() const {
+    return Size == 0;
+  }
+
+  // Returns true if the output outgrew the inline storage.
+  bool IsHeapAllocated() const {
+    return pData != pInlineData;
+  }
+
+  // Sets the size to 0. The storage is retained.
+  void Clear() {
+    Size = 0;
+    pData[0] = 0;
+  }
+
+  void AppendChar(char c) {
+    if ((Size < Capacity) || Grow(1)) {
+      pData[Size++] = c;
+      pData[Size] = 0;
+    }
+  }
+
+  void AppendChars(char c, size_t count);
+  void AppendString(const char* str, size_t size = StringIsNullTerminated);
+  void AppendString(const std::string& str) {
+    AppendString(str.data(), str.size());
+  }
+
+  // printf-style append. In the common case this is a single vsnprintf call directly into
+  // the buffer, with a second call only if the output didn't fit.
+  void AppendFormatV(const char* format, va_list argList);
+  void AppendFormat(const char* format, ...);
+
+  // Direct write access to the end of the buffer. GetAppendBuffer returns space for at least
+  // size chars plus a terminating null, or nullptr if it couldn't be allocated. CommitAppend
+  // then adds the given number of chars (<= size) that were written there.
+  char* GetAppendBuffer(size_t size) {
+    if ((size <= (Capacity - Size)) || Grow(size))
+      return pData + Size;
+    return nullptr;
+  }
+
+  void CommitAppend(size_t size) {
+    OVR_ASSERT(size <= (Capacity - Size));
+    Size += size;
+    pData[Size] = 0;
+  }
+
+ protected:
+  FormatBufferBase(char* inlineData, size_t inlineSize)
+      : pData(inlineData), pInlineData(inlineData), Size(0), Capacity(inlineSize - 1) {
+    pData[0] = 0;
+  }
+
+  ~FormatBufferBase();
+
+ private:
+  bool Grow(size_t extra);
+
+  FormatBufferBase(const FormatBufferBase&) = delete;
+  FormatBufferBase& operator=(const FormatBufferBase&) = delete;
+
+  char* pData;
+  char* pInlineData;
+  size_t Size;
+  size_t Capacity; // Not including the terminating null.
+};
+
+//-----------------------------------------------------------------------------------
+// ***** FormatBuffer
+//
+// FormatBufferBase with N chars (including the terminating null) of inline storage.
+//
+// Example usage:
+//     FormatBuffer<> buffer;
+//     OVR_FMT(buffer, "Sensor {} at {} Hz", sensorIndex, rate);
+//     puts(buffer.ToCStr());
+
+template <size_t N = 256>
+class FormatBuffer : public FormatBufferBase {
+ public:
+  static_assert(N > 1, "FormatBuffer needs space for at least one char");
+
+  FormatBuffer() : FormatBufferBase(InlineData, N) {}
+
+ private:
+  char InlineData[N];
+};
+
+//-----------------------------------------------------------------------------------
+// ***** FormatArg
+//
+// A type-erased reference to one argument of FormatTo. The set of constructors is the set of
+// types which can be formatted; anything else is a compile error instead of undefined
+// behavior at runtime as with printf.
+
+class FormatArg {
+ public:
+  enum ArgType {
+    TypeNone,
+    TypeBool,
+    TypeChar,
+    TypeInt,
+    TypeUInt,
+    TypeFloat,
+    TypeDouble,
+    TypeString,
+    TypePointer
+  };
+
+  FormatArg() : Type(TypeNone) {}
+  FormatArg(bool value) : Type(TypeBool) {
+    Int = value;
+  }
+  FormatArg(char value) : Type(TypeChar) {
+    Int = value;
+  }
+  FormatArg(signed char value) : Type(TypeInt) {
+    Int = value;
+  }
+  FormatArg(unsigned char value) : Type(TypeUInt) {
+    UInt = value;
+  }
+  FormatArg(short value) : Type(TypeInt) {
+    Int = value;
+  }
+  FormatArg(unsigned short value) : Type(TypeUInt) {
+    UInt = value;
+  }
+  FormatArg(int value) : Type(TypeInt) {
+    Int = value;
+  }
+  FormatArg(unsigned int value) : Type(TypeUInt) {
+    UInt = value;
+  }
+  FormatArg(long value) : Type(TypeInt) {
+    Int = value;
+  }
+  FormatArg(unsigned long value) : Type(TypeUInt) {
+    UInt = value;
+  }
+  FormatArg(long long value) : Type(TypeInt) {
+    Int = value;
+  }
+  FormatArg(unsigned long long value) : Type(TypeUInt) {
+    UInt = value;
+  }
+  FormatArg(float value) : Type(TypeFloat) {
+    Float = value;
+  }
+  FormatArg(double value) : Type(TypeDouble) {
+    Double = value;
+  }
+  FormatArg(const char* value) : Type(TypeString) {
+    Str.pData = value ? value : "";
+    Str.Size = OVR_strlen(Str.pData);
+  }
+  FormatArg(const std::string& value) : Type(TypeString) {
+    Str.pData = value.data();
+    Str.Size = value.size();
+  }
+  FormatArg(const void* value) : Type(TypePointer) {
+    Pointer = value;
+  }
+
+  // Wide strings would need a conversion; use UCSStringToUTF8String first.
+  FormatArg(const wchar_t* value) = delete;
+
+  ArgType Type;
+  union {
+    int64_t Int;
+    uint64_t UInt;
+    float Float;
+    double Double;
+    const void* Pointer;
+    struct {
+      const char* pData;
+      size_t Size;
+    } Str;
+  };
+};
+
+//-----------------------------------------------------------------------------------
+// ***** FormatTo
+//
+// Appends format to the buffer, with each "{}" replaced by the next argument.
+// "{{" and "}}" write a literal brace. A placeholder can have a spec after a colon:
+//     {:8}     Minimum width of 8, right-aligned with spaces.
+//     {:08}    Minimum width of 8, padded with zeros after any sign.
+//     {:x}     Integers and pointers in lower case hex. {:X} for upper case.
+//     {:.3f}   Floating point with printf-style precision and type (f, e or g).
+//
+// With no spec, integers are written in decimal, floating point numbers with the shortest
+// round-trip representation (see FormatFloatingPoint), bools as "true" or "false", and
+// pointers in hex with a "0x" prefix.
+//
+// A placeholder without an argument is written as-is, and extra arguments are ignored; both
+// assert in debug builds. Use the OVR_FMT macro to check the count at compile time instead.
+
+void FormatArgsTo(
+    FormatBufferBase& buffer,
+    const char* format,
+    const FormatArg* args,
+    size_t argCount);
+
+template <typename... Args>
+FormatBufferBase& FormatTo(FormatBufferBase& buffer, const char* format, const Args&... args) {
+  // One extra element so that the array isn't empty when there are no arguments.
+  const FormatArg argArray[sizeof...(Args) + 1] = {FormatArg(args)...};
+  FormatArgsTo(buffer, format, argArray, sizeof...(Args));
+  return buffer;
+}
+
+// Returns the formatted result as a std::string. Output up to 255 chars long is formatted
+// on the stack, so the only allocation is the one made by the std::string, if any.
+template <typename... Args>
+std::string FormatString(const char* format, const Args&... args) {
+  FormatBuffer<> buffer;
+  FormatTo(buffer, format, args...);
+  return std::string(buffer.ToCStr(), buffer.GetSize());
+}
+
+//-----------------------------------------------------------------------------------
+// ***** Compile-time format checking
+//
+// OVR_FMT(buffer, format, args...) and OVR_FMT_STRING(format, args...) are FormatTo and
+// FormatString with a static_assert that the format is a literal whose number of
+// placeholders matches the number of arguments, and which has no unmatched braces.
+//
+// Example usage:
+//     std::string s = OVR_FMT_STRING("{} of {} frames dropped", dropped, total);
+
+const size_t FormatPlaceholderError = size_t(-1);
+
+constexpr size_t FormatPlaceholderCount(const char* format, size_t count = 0);
+
+constexpr size_t FormatPlaceholderSpecEnd(const char* format, size_t count) {
+  return ((*format == 0) || (*format == '{'))
+      ? FormatPlaceholderError
+      : (*format == '}') ? FormatPlaceholderCount(format + 1, count)
+                         : FormatPlaceholderSpecEnd(format + 1, count);
+}
+
+// Returns the number of placeholders in the format, or FormatPlaceholderError if it has an
+// unmatched brace. Note that this recurses once per char, so compilers limit it to formats
+// of a few hundred chars.
+constexpr size_t FormatPlaceholderCount(const char* format, size_t count) {
+  return (*format == 0) ? count
+      : (*format == '{')
+      ? ((format[1] == '{') ? FormatPlaceholderCount(format + 2, count)
+                            : FormatPlaceholderSpecEnd(format + 1, count + 1))
+      : (*format == '}')
+      ? ((format[1] == '}') ? FormatPlaceholderCount(format + 2, count) : FormatPlaceholderError)
+      : FormatPlaceholderCount(format + 1, count);
+}
+
+// Only used in unevaluated context, to get the argument count.
+template <typename... Args>
+std::integral_constant<size_t, sizeof...(Args)> FormatArgCount(const char*, const Args&...);
+
+template <size_t PlaceholderCount, size_t ArgCount>
+inline void FormatCheck() {
+  static_assert(
+      PlaceholderCount != FormatPlaceholderError, "Format string has an unmatched brace.");
+  static_assert(
+      PlaceholderCount == ArgCount, "Format placeholder count doesn't match argument count.");
+}
+
+} // namespace OVR
+
+// The extra expansion is needed for MSVC, which otherwise passes __VA_ARGS__ as one argument.
+#define OVR_FMT_EXPAND_(x) x
+#define OVR_FMT_FIRST_(first, ...) first
+#define OVR_FMT_FORMAT_(...) OVR_FMT_EXPAND_(OVR_FMT_FIRST_(__VA_ARGS__, 0))
+
+#define OVR_FMT_CHECK_(...)                                                  \
+  OVR::FormatCheck<                                                          \
+      OVR::FormatPlaceholderCount(OVR_FMT_FORMAT_(__VA_ARGS__)),             \
+      decltype(OVR::FormatArgCount(__VA_ARGS__))::value>()
+
+#define OVR_FMT(buffer, ...) (OVR_FMT_CHECK_(__VA_ARGS__), OVR::FormatTo(buffer, __VA_ARGS__))
+
+#define OVR_FMT_STRING(...) (OVR_FMT_CHECK_(__VA_ARGS__), OVR::FormatString(__VA_ARGS__))
+
+#endif // OVR_Format_h
@@ -923,6 +923,7 @@ struct HashNode {
   // Note: No default constructor is necessary.
   HashNode(const HashNode& src) : First(src.First), Second(src.Second) {}
   HashNode(const NodeRef& src) : First(*src.pFirst), Second(*src.pSecond) {}
+  HashNode& operator=(const HashNode& src) = default;
   void operator=(const NodeRef& src) {
     First = *src.pFirst;
     Second = *src.pSecond;
@@ -57,6 +57,8 @@ limitations under the License.
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include "OVR_Array.h"
+#include "OVR_Hash.h"
 #include "OVR_SysFile.h"
 
 namespace OVR {
@@ -144,12 +146,56 @@ const char* AssignError(const char** perror, const char* errorMessage) {
   return 0;
 }
 
+//-----------------------------------------------------------------------------
+// ***** JSONItemIndex
+
+// A child's name, referring to the child's own Name rather than a copy of it. It stays valid
+// until the Name is changed, which is why renaming a child requires UpdateIndex.
+struct JSONNameKey {
+  const char* pName;
+  size_t Size;
+
+  bool operator==(const JSONNameKey& other) const {
+    return (Size == other.Size) && (memcmp(pName, other.pName, Size) == 0);
+  }
+
+  struct HashFunctor {
+    size_t operator()(const JSONNameKey& key) const {
+      return String::BernsteinHashFunction(key.pName, key.Size);
+    }
+  };
+};
+
+// The children of a node by position and by name. Names maps each name to the first child
+// with that name, which is the one a linear search finds. Arrays have no Names, as their
+// elements are unnamed.
+struct JSONItemIndex {
+  ArrayPOD<JSON*> Items;
+  Hash<JSONNameKey, JSON*, JSONNameKey::HashFunctor> Names;
+  bool HasNames;
+};
+
+// Nodes with fewer children than this are searched linearly, which is about as fast.
+static const unsigned JSONIndexMinItems = 8;
+
+static void AddToIndex(JSONItemIndex* index, JSON* item) {
+  index->Items.PushBack(item);
+
+  if (index->HasNames) {
+    JSONNameKey name = {item->Name.ToCStr(), item->Name.GetSize()};
+    if (!index->Names.Get(name))
+      index->Names.Add(name, item);
+  }
+}
+
 //-----------------------------------------------------------------------------
 // ***** JSON Node class
 
-JSON::JSON(JSONItemType itemType) : Type(itemType), dValue(0.) {}
+JSON::JSON(JSONItemType itemType) : pIndex(nullptr), Type(itemType), dValue(0.) {}
 
 JSON::~JSON() {
+  delete pIndex;
+
   JSON* child = Children.GetFirst();
   while (!Children.IsNull(child)) {
     child->RemoveNode();
@@ -158,6 +204,33 @@ JSON::~JSON() {
   }
 }
 
+void JSON::UpdateIndex() {
+  delete pIndex;
+  pIndex = nullptr;
+
+  unsigned count = 0;
+  for (JSON* child = Children.GetFirst(); !Children.IsNull(child); child = child->GetNext()) {
+    if (++count == JSONIndexMinItems)
+      break;
+  }
+  if (count < JSONIndexMinItems)
+    return;
+
+  pIndex = new JSONItemIndex;
+  pIndex->HasNames = (Type != JSON_Array);
+  for (JSON* child = Children.GetFirst(); !Children.IsNull(child); child = child->GetNext())
+    AddToIndex(pIndex, child);
+}
+
+void JSON::PushBackChild(JSON* item) {
+  Children.PushBack(item);
+
+  if (pIndex)
+    AddToIndex(pIndex, item);
+  else
+    UpdateIndex(); // Builds the index once there are enough children.
+}
+
 //-----------------------------------------------------------------------------
 // Parse the input text to generate a number, and populate the result into item
 // Returns the text position after the parsed number
@@ -598,8 +671,10 @@ const char* JSON::parseArray(const char* buff, const char** perror) {
       return AssignError(perror, "Error: Failed to allocate memory");
   }
 
-  if (*buff == ']')
+  if (*buff == ']') {
+    UpdateIndex();
     return buff + 1; // end of array
+  }
 
   return AssignError(perror, "Syntax Error: Missing ending bracket");
 }
@@ -734,8 +809,10 @@ const char* JSON::parseObject(const char* buff, const char** perror) {
       return 0;
   }
 
-  if (*buff == '}')
+  if (*buff == '}') {
+    UpdateIndex();
     return buff + 1; // end of array
+  }
 
   return AssignError(perror, "Syntax Error: Missing closing brace");
 }
@@ -887,6 +964,9 @@ char* JSON::PrintObject(int depth, bool fmt) {
 // Returns the number of child items in the object
 // Counts the number of items in the object.
 unsigned JSON::GetItemCount() const {
+  if (pIndex)
+    return (unsigned)pIndex->Items.GetSize();
+
   unsigned count = 0;
   for (const JSON* p = Children.GetFirst(); !Children.IsNull(p); p = Children.GetNext(p)) {
     count++;
@@ -895,6 +975,9 @@ unsigned JSON::GetItemCount() const {
 }
 
 JSON* JSON::GetItemByIndex(unsigned index) {
+  if (pIndex)
+    return (index < pIndex->Items.GetSize()) ? pIndex->Items[index] : nullptr;
+
   unsigned i = 0;
   JSON* child = 0;
 
@@ -916,6 +999,12 @@ JSON* JSON::GetItemByIndex(unsigned index) {
 
 // Returns the child item with the given name or NULL if not found
 JSON* JSON::GetItemByName(const char* name) {
+  if (pIndex && pIndex->HasNames) {
+    JSONNameKey key = {name, strlen(name)};
+    JSON** item = pIndex->Names.Get(key);
+    return item ? *item : nullptr;
+  }
+
   JSON* child = 0;
 
   if (!Children.IsEmpty()) {
@@ -938,7 +1027,7 @@ JSON* JSON::GetItemByName(const char* name) {
 void JSON::AddItem(const char* string, JSON* item) {
   if (item) {
     item->Name = string;
-    Children.PushBack(item);
+    PushBackChild(item);
   }
 }
 
@@ -985,6 +1074,16 @@ void JSON::ReplaceItem(unsigned int index, JSON* new_item)
 void JSON::RemoveLast() {
   JSON* child = Children.GetLast();
   if (!Children.IsNull(child)) {
+    if (pIndex) {
+      pIndex->Items.PopBack();
+
+      // If the names map to this child, it has no earlier namesake to map to instead.
+      JSONNameKey name = {child->Name.ToCStr(), child->Name.GetSize()};
+      JSON** first = pIndex->Names.Get(name);
+      if (first && (*first == child))
+        pIndex->Names.Remove(name);
+    }
+
     child->RemoveNode();
     child->Release();
   }
@@ -1065,7 +1164,7 @@ String JSON::GetStringByName(const char* name, const String& defValue) {
 // Adds an element to an array object type
 void JSON::AddArrayElement(JSON* item) {
   if (item) {
-    Children.PushBack(item);
+    PushBackChild(item);
   }
 }
 
@@ -1077,20 +1176,22 @@ void JSON::InsertArrayElement(int index, JSON* item) {
 
   if (index == 0) {
     Children.PushFront(item);
-    return;
-  }
+  } else {
+    JSON* iter = Children.GetFirst();
+    int i = 0;
+    while (iter && i < index) {
+      iter = Children.GetNext(iter);
+      i++;
+    }
 
-  JSON* iter = Children.GetFirst();
-  int i = 0;
-  while (iter && i < index) {
-    iter = Children.GetNext(iter);
-    i++;
+    if (iter)
+      iter->InsertNodeBefore(item);
+    else
+      Children.PushBack(item);
   }
 
-  if (iter)
-    iter->InsertNodeBefore(item);
-  else
-    Children.PushBack(item);
+  // Inserts are rare enough that shifting the index isn't worth it.
+  UpdateIndex();
 }
 
 // Returns the size of an array
@@ -1130,7 +1231,7 @@ JSON* JSON::Copy() {
 
   JSON* child = Children.GetFirst();
   while (!Children.IsNull(child)) {
-    copy->Children.PushBack(child->Copy());
+    copy->PushBackChild(child->Copy());
     child = Children.GetNext(child);
   }
 
@@ -1199,4 +1300,391 @@ String JSON::Stringify(bool fmt) {
   return copy;
 }
 
+//-----------------------------------------------------------------------------
+// ***** Binary serialization
+//
+// CBOR data items start with a byte holding the major type in the top 3 bits and, in the low
+// 5 bits, either a small argument (the value, length or count) or how many big endian bytes
+// of argument follow it.
+
+enum CBORMajorType {
+  CBOR_UnsignedInt = 0,
+  CBOR_NegativeInt = 1,
+  CBOR_ByteString = 2,
+  CBOR_TextString = 3,
+  CBOR_Array = 4,
+  CBOR_Map = 5,
+  CBOR_Tag = 6,
+  CBOR_Simple = 7
+};
+
+enum {
+  CBOR_False = 0xF4,
+  CBOR_True = 0xF5,
+  CBOR_Null = 0xF6,
+  CBOR_Undefined = 0xF7,
+  CBOR_Half = 0xF9,
+  CBOR_Float = 0xFA,
+  CBOR_Double = 0xFB,
+  CBOR_Break = 0xFF,
+  CBOR_Indefinite = 31, // Argument bits for items whose length is ended by a break.
+  CBOR_SelfDescribeTag = 55799, // Marks a file as CBOR; written by SaveBinary.
+  CBOR_MaxDepth = 512
+};
+
+static void StoreBigEndian(uint8_t* p, uint64_t value, size_t size) {
+  for (size_t i = size; i-- > 0; value >>= 8)
+    p[i] = (uint8_t)value;
+}
+
+static uint64_t LoadBigEndian(const uint8_t* p, size_t size) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < size; i++)
+    value = (value << 8) | p[i];
+  return value;
+}
+
+// Buffered writer of CBOR items to a file.
+class CBORFileWriter {
+ public:
+  CBORFileWriter(File* file) : pFile(file), Used(0), Failed(false) {}
+
+  void WriteHead(CBORMajorType major, uint64_t argument) {
+    // Arguments of 24 and over follow the initial byte in 1, 2, 4 or 8 bytes, whose count is
+    // encoded as 24 to 27.
+    uint8_t head[9];
+    size_t argumentSize = 0;
+    uint8_t argumentBits = (uint8_t)argument;
+
+    if (argument >= 24) {
+      argumentBits = 24;
+      argumentSize = 1;
+      while ((argumentSize < 8) && (argument >> (argumentSize * 8))) {
+        argumentSize *= 2;
+        argumentBits++;
+      }
+    }
+
+    head[0] = (uint8_t)((major << 5) | argumentBits);
+    StoreBigEndian(head + 1, argument, argumentSize);
+    WriteBytes(head, 1 + argumentSize);
+  }
+
+  void WriteBytes(const void* data, size_t size) {
+    if ((Used + size) > sizeof(Buffer)) {
+      Flush();
+      if (size > sizeof(Buffer)) {
+        if (pFile->Write((const uint8_t*)data, (int)size) != (int)size)
+          Failed = true;
+        return;
+      }
+    }
+    memcpy(Buffer + Used, data, size);
+    Used += size;
+  }
+
+  void WriteString(const String& str) {
+    WriteHead(CBOR_TextString, str.GetSize());
+    WriteBytes(str.ToCStr(), str.GetSize());
+  }
+
+  void WriteNumber(double d) {
+    // Integral values are written as integers, unless they're -0.
+    if ((floor(d) == d) && (fabs(d) < 9223372036854775808.0) && ((d != 0.) || !signbit(d))) {
+      const int64_t i = (int64_t)d;
+      if (i >= 0)
+        WriteHead(CBOR_UnsignedInt, (uint64_t)i);
+      else
+        WriteHead(CBOR_NegativeInt, (uint64_t)(-1 - i));
+      return;
+    }
+
+    uint8_t bytes[9];
+    const float f = (float)d;
+    if (((double)f == d) || (d != d)) {
+      uint32_t bits;
+      memcpy(&bits, &f, sizeof(bits));
+      bytes[0] = CBOR_Float;
+      StoreBigEndian(bytes + 1, bits, 4);
+      WriteBytes(bytes, 5);
+    } else {
+      uint64_t bits;
+      memcpy(&bits, &d, sizeof(bits));
+      bytes[0] = CBOR_Double;
+      StoreBigEndian(bytes + 1, bits, 8);
+      WriteBytes(bytes, 9);
+    }
+  }
+
+  void WriteValue(JSON* json) {
+    uint8_t simple = CBOR_Null;
+
+    switch (json->Type) {
+      case JSON_Bool:
+        simple = ((int)json->dValue != 0) ? CBOR_True : CBOR_False;
+        break;
+      case JSON_Number:
+        WriteNumber(json->dValue);
+        return;
+      case JSON_String:
+        WriteString(json->Value);
+        return;
+      case JSON_Array:
+      case JSON_Object:
+        WriteHead((json->Type == JSON_Array) ? CBOR_Array : CBOR_Map, json->GetItemCount());
+        for (JSON* item = json->GetFirstItem(); item; item = json->GetNextItem(item)) {
+          if (json->Type == JSON_Object)
+            WriteString(item->Name);
+          WriteValue(item);
+        }
+        return;
+      default:
+        break;
+    }
+
+    WriteBytes(&simple, 1);
+  }
+
+  bool Flush() {
+    if (Used && !Failed && (pFile->Write(Buffer, (int)Used) != (int)Used))
+      Failed = true;
+    Used = 0;
+    return !Failed;
+  }
+
+ private:
+  File* pFile;
+  size_t Used;
+  bool Failed;
+  uint8_t Buffer[4096];
+};
+
+// Reads the head of the item at data. Returns the data after it, or null if the data ends
+// first or the head is malformed. Indefinite length items have an argument of 0.
+static const uint8_t*
+ReadCBORHead(const uint8_t* data, const uint8_t* end, uint8_t& initial, uint64_t& argument) {
+  if (data >= end)
+    return nullptr;
+
+  initial = *data++;
+  const uint8_t argumentBits = initial & 31;
+
+  if (argumentBits < 24) {
+    argument = argumentBits;
+  } else if (argumentBits <= 27) {
+    const size_t size = (size_t)1 << (argumentBits - 24);
+    if ((size_t)(end - data) < size)
+      return nullptr;
+    argument = LoadBigEndian(data, size);
+    data += size;
+  } else if (argumentBits == CBOR_Indefinite) {
+    argument = 0;
+  } else {
+    return nullptr; // Reserved.
+  }
+
+  return data;
+}
+
+// Converts an IEEE half precision float.
+static double HalfToDouble(uint16_t half) {
+  const int exponent = (half >> 10) & 0x1F;
+  const int mantissa = half & 0x3FF;
+  double value;
+
+  if (exponent == 0)
+    value = ldexp((double)mantissa, -24);
+  else if (exponent != 31)
+    value = ldexp((double)(mantissa + 1024), exponent - 25);
+  else
+    value = mantissa ? NAN : INFINITY;
+
+  return (half & 0x8000) ? -value : value;
+}
+
+//-----------------------------------------------------------------------------
+// Parses the CBOR item at data into this node. Returns the data after it, or 0 on error.
+const uint8_t*
+JSON::parseBinaryValue(const uint8_t* data, const uint8_t* end, int depth, const char** perror) {
+  if (depth >= CBOR_MaxDepth)
+    return (const uint8_t*)AssignError(perror, "Binary Error: Nesting too deep");
+
+  uint8_t initial;
+  uint64_t argument;
+  int major;
+
+  // Skip any tags (semantic annotations) on the item.
+  do {
+    data = ReadCBORHead(data, end, initial, argument);
+    if (!data)
+      return (const uint8_t*)AssignError(perror, "Binary Error: Unexpected end of data");
+    major = initial >> 5;
+  } while (major == CBOR_Tag);
+
+  const bool indefinite = ((initial & 31) == CBOR_Indefinite);
+
+  if (indefinite && ((major < CBOR_ByteString) || (major == CBOR_Simple)))
+    return (const uint8_t*)AssignError(perror, "Binary Error: Invalid item");
+
+  switch (major) {
+    case CBOR_UnsignedInt:
+      Type = JSON_Number;
+      dValue = (double)argument;
+      return data;
+
+    case CBOR_NegativeInt:
+      Type = JSON_Number;
+      dValue = -1. - (double)argument;
+      return data;
+
+    case CBOR_ByteString:
+    case CBOR_TextString:
+      Type = JSON_String;
+      Value.Clear();
+
+      // Indefinite length strings are a sequence of definite length chunks.
+      for (;;) {
+        if (indefinite) {
+          if ((data < end) && (*data == CBOR_Break))
+            return data + 1;
+
+          uint8_t chunkInitial;
+          data = ReadCBORHead(data, end, chunkInitial, argument);
+          if (!data || ((chunkInitial >> 5) != major) || ((chunkInitial & 31) == CBOR_Indefinite))
+            return (const uint8_t*)AssignError(perror, "Binary Error: Invalid string");
+        }
+
+        if ((uint64_t)(end - data) < argument)
+          return (const uint8_t*)AssignError(perror, "Binary Error: Unexpected end of data");
+
+        Value.AppendString((const char*)data, (size_t)argument);
+        data += argument;
+
+        if (!indefinite)
+          return data;
+      }
+
+    case CBOR_Array:
+    case CBOR_Map:
+      Type = (major == CBOR_Array) ? JSON_Array : JSON_Object;
+
+      for (uint64_t i = 0; indefinite || (i < argument); i++) {
+        if (indefinite && (data < end) && (*data == CBOR_Break)) {
+          UpdateIndex();
+          return data + 1;
+        }
+
+        JSON* child = new JSON();
+        Children.PushBack(child);
+
+        if (major == CBOR_Map) {
+          data = child->parseBinaryValue(data, end, depth + 1, perror);
+          if (!data)
+            return 0;
+          if (child->Type != JSON_String)
+            return (const uint8_t*)AssignError(perror, "Binary Error: Name is not a string");
+
+          child->Name = child->Value;
+          child->Value.Clear();
+        }
+
+        data = child->parseBinaryValue(data, end, depth + 1, perror);
+        if (!data)
+          return 0;
+      }
+      UpdateIndex();
+      return data;
+
+    case CBOR_Simple:
+      switch (initial) {
+        case CBOR_False:
+        case CBOR_True:
+          Type = JSON_Bool;
+          dValue = (initial == CBOR_True) ? 1. : 0.;
+          Value = (initial == CBOR_True) ? "true" : "false";
+          return data;
+
+        case CBOR_Null:
+        case CBOR_Undefined:
+          Type = JSON_Null;
+          return data;
+
+        // The argument of a float holds its bits.
+        case CBOR_Half:
+          Type = JSON_Number;
+          dValue = HalfToDouble((uint16_t)argument);
+          return data;
+
+        case CBOR_Float: {
+          const uint32_t bits = (uint32_t)argument;
+          float f;
+          memcpy(&f, &bits, sizeof(f));
+          Type = JSON_Number;
+          dValue = f;
+          return data;
+        }
+
+        case CBOR_Double:
+          Type = JSON_Number;
+          memcpy(&dValue, &argument, sizeof(dValue));
+          return data;
+      }
+      break;
+  }
+
+  return (const uint8_t*)AssignError(perror, "Binary Error: Invalid item");
+}
+
+//-----------------------------------------------------------------------------
+// Parses CBOR data and returns a JSON object tree. The returned object must be Released
+// after use.
+JSON* JSON::ParseBinary(const uint8_t* data, size_t size, const char** perror) {
+  AssignError(perror, 0);
+
+  if (!data)
+    return (JSON*)AssignError(perror, "Binary Error: Unexpected end of data");
+
+  JSON* json = new JSON();
+  if (!json->parseBinaryValue(data, data + size, 0, perror)) {
+    json->Release();
+    return NULL;
+  }
+
+  return json;
+}
+
+//-----------------------------------------------------------------------------
+// Loads and parses the given CBOR file pathname and returns a JSON object tree.
+// The returned object must be Released after use.
+JSON* JSON::LoadBinary(const char* path, const char** perror) {
+  // The CBOR is decoded straight from the mapping, without reading the file into a buffer.
+  MappedFile f(path);
+  if (!f.IsValid()) {
+    AssignError(perror, "Failed to open file");
+    return NULL;
+  }
+
+  if (f.GetDataSize() == 0) {
+    AssignError(perror, "Failed to read file");
+    return NULL;
+  }
+
+  return JSON::ParseBinary(f.GetData(), f.GetDataSize(), perror);
+}
+
+//-----------------------------------------------------------------------------
+// Serializes the JSON object to CBOR and writes it to the given file path
+bool JSON::SaveBinary(const char* path) {
+  SysFile f;
+  if (!f.Open(path, File::Open_Write | File::Open_Create | File::Open_Truncate, File::Mode_Write))
+    return false;
+
+  CBORFileWriter writer(&f);
+  writer.WriteHead(CBOR_Tag, CBOR_SelfDescribeTag);
+  writer.WriteValue(this);
+  bool result = writer.Flush() && f.Flush();
+  f.Close();
+  return result;
+}
+
 } // namespace OVR
@@ -47,16 +47,26 @@ enum JSONItemType {
   JSON_Object = 6
 };
 
+struct JSONItemIndex;
+
 //-----------------------------------------------------------------------------
 // ***** JSON
 
 // JSON object represents a JSON node that can be either a root of the JSON tree
 // or a child item. Every node has a type that describes what is is.
 // New JSON trees are typically loaded JSON::Load or created with JSON::Parse.
-
-class JSON : public RefCountBase<JSON>, public ListNode<JSON> {
+//
+// Nodes with many children keep an index of them, making lookups by name or index O(1). It's
+// built by the parsers and kept up to date by the child item functions below, so lookups
+// don't modify the tree, and parsed trees may be read from several threads at once. Code which
+// changes the Name of a child after adding it must call UpdateIndex on the parent.
+//
+// Nodes are allocated from a RefCountPool, as parsing creates them in large numbers.
+
+class JSON : public RefCountBasePooled<JSON>, public ListNode<JSON> {
  protected:
   List<JSON> Children;
+  JSONItemIndex* pIndex; // Null for nodes with few children.
 
  public:
   JSONItemType Type; // Type of this JSON node.
@@ -97,6 +107,17 @@ class JSON : public RefCountBase<JSON>, public ListNode<JSON> {
   // Saves a JSON object to a file.
   bool Save(const char* path);
 
+  // Binary counterparts of Load and Save, using CBOR (RFC 8949). Binary files are smaller
+  // and faster to load, and keep numbers exact. Strings and names are UTF-8 text strings;
+  // numbers are written as integers when integral, and otherwise as the smallest float type
+  // which holds them exactly.
+  static JSON* LoadBinary(const char* path, const char** perror = 0);
+  bool SaveBinary(const char* path);
+
+  // Parses CBOR data directly from memory, such as a mapped file, without copying it first.
+  // Byte strings are read as strings, tags are ignored, and undefined is read as null.
+  static JSON* ParseBinary(const uint8_t* data, size_t size, const char** perror = 0);
+
   // Return the String representation of a JSON object.
   String Stringify(bool fmt);
 
@@ -114,11 +135,14 @@ class JSON : public RefCountBase<JSON>, public ListNode<JSON> {
     return (!Children.IsEmpty()) ? Children.GetLast() : 0;
   }
 
-  // Counts the number of items in the object; these methods are inefficient.
+  // Counts the number of items in the object.
   unsigned GetItemCount() const;
   JSON* GetItemByIndex(unsigned i);
   JSON* GetItemByName(const char* name);
 
+  // Rebuilds the lookup index from the children.
+  void UpdateIndex();
+
   // Accessors by name
   double GetNumberByName(const char* name, double defValue = 0.0);
   int GetIntByName(const char* name, int defValue = 0);
@@ -199,7 +223,7 @@ class JSON : public RefCountBase<JSON>, public ListNode<JSON> {
       node->AddArrayNumber((double)array[i]);
   }
 
-  // Accessed array elements; currently inefficient.
+  // Accessed array elements.
   int GetArraySize();
   double GetArrayNumber(int index);
   const char* GetArrayString(int index);
@@ -218,10 +242,15 @@ class JSON : public RefCountBase<JSON>, public ListNode<JSON> {
   const char* parseArray(const char* value, const char** perror);
   const char* parseObject(const char* value, const char** perror);
   const char* parseString(const char* str, const char** perror);
+  const uint8_t*
+  parseBinaryValue(const uint8_t* data, const uint8_t* end, int depth, const char** perror);
 
   char* PrintValue(int depth, bool fmt);
   char* PrintObject(int depth, bool fmt);
   char* PrintArray(int depth, bool fmt);
+
+  // Adds a named child to the end of the child list, updating the index.
+  void PushBackChild(JSON* item);
 };
 } // namespace OVR
 
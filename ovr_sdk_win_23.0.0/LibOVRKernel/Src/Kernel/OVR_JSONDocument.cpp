@@ -0,0 +1,673 @@
+/************************************************************************************
+
+Filename    :   OVR_JSONDocument.cpp
+Content     :   Read-only JSON tree parsed into a single arena
+Created     :   October 18, 2026
+Notes       :
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+#include "OVR_JSONDocument.h"
+#include "OVR_Allocator.h"
+#include "OVR_Std.h"
+#include "OVR_SysFile.h"
+#include "OVR_UTF8Util.h"
+
+#include <locale.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+namespace OVR {
+
+enum {
+  JSONTextPadding = 64, // Zeroed bytes after the text, so the parser can read ahead.
+  JSONArenaMinBlockSize = 4096,
+  JSONArenaMaxBlockSize = 16 * 1024 * 1024,
+  JSONParseStackInitialCapacity = 256,
+  JSONMaxDepth = 512
+};
+
+static size_t AlignJSONArena(size_t size) {
+  return (size + 7) & ~(size_t)7;
+}
+
+//-----------------------------------------------------------------------------
+// ***** JSONDocument arena
+
+JSONDocument::~JSONDocument() {
+  while (pBlocks) {
+    ArenaBlock* next = pBlocks->pNext;
+    OVR_FREE(pBlocks);
+    pBlocks = next;
+  }
+}
+
+void* JSONDocument::Alloc(size_t size) {
+  const size_t headerSize = AlignJSONArena(sizeof(ArenaBlock));
+  size = AlignJSONArena(size);
+
+  if (!pBlocks || ((pBlocks->Size - pBlocks->Used) < size)) {
+    const size_t blockSize = (size > NextBlockSize) ? size : NextBlockSize;
+    ArenaBlock* block = (ArenaBlock*)OVR_ALLOC(headerSize + blockSize);
+    if (!block)
+      return nullptr;
+
+    block->pNext = pBlocks;
+    block->Size = blockSize;
+    block->Used = 0;
+    pBlocks = block;
+
+    if (NextBlockSize < JSONArenaMaxBlockSize)
+      NextBlockSize *= 2;
+  }
+
+  void* result = (char*)pBlocks + headerSize + pBlocks->Used;
+  pBlocks->Used += size;
+  return result;
+}
+
+char* JSONDocument::AllocText(size_t len) {
+  const size_t headerSize = AlignJSONArena(sizeof(ArenaBlock));
+  ArenaBlock* block = (ArenaBlock*)OVR_ALLOC(headerSize + len + JSONTextPadding);
+  if (!block)
+    return nullptr;
+
+  // The text block is never used for other allocations.
+  block->pNext = pBlocks;
+  block->Size = len + JSONTextPadding;
+  block->Used = block->Size;
+  pBlocks = block;
+
+  // Size the value blocks to the text; values typically take a few times the text's size.
+  NextBlockSize = Alg::Clamp(
+      AlignJSONArena(len * 2), (size_t)JSONArenaMinBlockSize, (size_t)JSONArenaMaxBlockSize);
+
+  char* text = (char*)block + headerSize;
+  memset(text + len, 0, JSONTextPadding);
+  return text;
+}
+
+size_t JSONDocument::GetMemoryUsed() const {
+  size_t total = 0;
+  for (const ArenaBlock* block = pBlocks; block; block = block->pNext)
+    total += AlignJSONArena(sizeof(ArenaBlock)) + block->Size;
+  return total;
+}
+
+//-----------------------------------------------------------------------------
+// ***** JSONDocumentParser
+//
+// Recursive descent parser over the document's copy of the text. The items of the array or
+// object being parsed are collected on a stack shared by all levels, and moved to a
+// contiguous arena block when the closing bracket is reached; nested containers are
+// complete (and popped) before their parent's next item is pushed.
+
+// Parses up to 4 hex digits. Returns the first char after them.
+static const char* ParseJSONHex4(const char* str, unsigned& value) {
+  value = 0;
+
+  for (int digitCount = 0; digitCount < 4; digitCount++, str++) {
+    unsigned v = (uint8_t)*str;
+
+    if ((v >= '0') && (v <= '9'))
+      v -= '0';
+    else if ((v >= 'a') && (v <= 'f'))
+      v = 10 + v - 'a';
+    else if ((v >= 'A') && (v <= 'F'))
+      v = 10 + v - 'A';
+    else
+      break;
+
+    value = (value * 16) + v;
+  }
+
+  return str;
+}
+
+static bool IsJSONDigit(char c) {
+  return (c >= '0') && (c <= '9');
+}
+
+// Converts number text with correct rounding, without depending on the C locale's decimal
+// point.
+static double StrtodJSON(const char* str, size_t len) {
+  char localBuffer[128];
+  char* buffer = (len < sizeof(localBuffer)) ? localBuffer : (char*)OVR_ALLOC(len + 1);
+  if (!buffer)
+    return 0.;
+
+  memcpy(buffer, str, len);
+  buffer[len] = 0;
+
+  const char decimalPoint = *localeconv()->decimal_point;
+  if (decimalPoint != '.') {
+    char* point = strchr(buffer, '.');
+    if (point)
+      *point = decimalPoint;
+  }
+
+  const double result = strtod(buffer, nullptr);
+  if (buffer != localBuffer)
+    OVR_FREE(buffer);
+  return result;
+}
+
+const char* JSONParseNumber(const char* p, double& number) {
+  static const double Pow10[] = {1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                 1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+  const uint64_t MantissaLimit = 100000000000000000ull; // 10^17; more digits are dropped.
+
+  const char* start = p;
+  const bool negative = (*p == '-');
+  if (negative)
+    ++p;
+
+  if (!IsJSONDigit(*p))
+    return nullptr;
+
+  uint64_t mantissa = 0;
+  int exponent = 0;
+  bool truncated = false;
+
+  for (; IsJSONDigit(*p); ++p) {
+    if (mantissa < MantissaLimit) {
+      mantissa = (mantissa * 10) + (*p - '0');
+    } else {
+      exponent++;
+      truncated |= (*p != '0');
+    }
+  }
+
+  if ((*p == '.') && IsJSONDigit(p[1])) {
+    for (++p; IsJSONDigit(*p); ++p) {
+      if (mantissa < MantissaLimit) {
+        mantissa = (mantissa * 10) + (*p - '0');
+        exponent--;
+      } else {
+        truncated |= (*p != '0');
+      }
+    }
+  }
+
+  if ((*p == 'e') || (*p == 'E')) {
+    ++p;
+    bool negativeExponent = false;
+    if ((*p == '+') || (*p == '-'))
+      negativeExponent = (*p++ == '-');
+
+    int e = 0;
+    for (; IsJSONDigit(*p); ++p) {
+      if (e < 100000)
+        e = (e * 10) + (*p - '0');
+    }
+    exponent += negativeExponent ? -e : e;
+  }
+
+  // Both the mantissa and the power of ten are exact doubles, so a single multiply or
+  // divide gives the correctly rounded result (Clinger's fast path). This is the usual case.
+  if (!truncated && (mantissa <= (uint64_t(1) << 53)) && (exponent >= -22) && (exponent <= 22)) {
+    double d = (double)mantissa;
+    d = (exponent < 0) ? (d / Pow10[-exponent]) : (d * Pow10[exponent]);
+    number = negative ? -d : d;
+  } else {
+    number = StrtodJSON(start, (size_t)(p - start));
+  }
+
+  return p;
+}
+
+class JSONDocumentParser {
+ public:
+  JSONDocumentParser(JSONDocument* doc, char* text, size_t len)
+      : pDoc(doc),
+        p(text),
+        pEnd(text + len),
+        pStack(nullptr),
+        StackSize(0),
+        StackCapacity(0),
+        Error(nullptr) {}
+
+  ~JSONDocumentParser() {
+    if (pStack)
+      OVR_FREE(pStack);
+  }
+
+  void SkipWhitespace() {
+    while (*p && ((uint8_t)*p <= ' '))
+      ++p;
+  }
+
+  bool ParseValue(JSONValue& value, int depth);
+
+  const char* GetError() const {
+    return Error;
+  }
+
+ private:
+  bool Fail(const char* error) {
+    if (!Error)
+      Error = error;
+    return false;
+  }
+
+  bool PushItem(const JSONValue& item);
+  bool ParseContainer(JSONValue& value, int depth);
+  bool ParseString(const char*& str, uint32_t& size);
+  bool ParseNumber(double& number);
+
+  JSONDocument* pDoc;
+  char* p;
+  char* pEnd;
+  JSONValue* pStack;
+  size_t StackSize;
+  size_t StackCapacity;
+  const char* Error;
+};
+
+bool JSONDocumentParser::ParseValue(JSONValue& value, int depth) {
+  value.pName = "";
+  value.Size = 0;
+  value.Number = 0.;
+
+  switch (*p) {
+    case '\"':
+      value.Type = JSON_String;
+      return ParseString(value.pString, value.Size);
+
+    case '[':
+    case '{':
+      return ParseContainer(value, depth);
+
+    case 'n':
+      if (memcmp(p, "null", 4) == 0) { // The padding makes reading past the end safe.
+        value.Type = JSON_Null;
+        p += 4;
+        return true;
+      }
+      break;
+
+    case 't':
+      if (memcmp(p, "true", 4) == 0) {
+        value.Type = JSON_Bool;
+        value.Number = 1.;
+        p += 4;
+        return true;
+      }
+      break;
+
+    case 'f':
+      if (memcmp(p, "false", 5) == 0) {
+        value.Type = JSON_Bool;
+        p += 5;
+        return true;
+      }
+      break;
+
+    default:
+      if ((*p == '-') || IsJSONDigit(*p)) {
+        value.Type = JSON_Number;
+        return ParseNumber(value.Number);
+      }
+      break;
+  }
+
+  return Fail("Syntax Error: Invalid syntax");
+}
+
+bool JSONDocumentParser::PushItem(const JSONValue& item) {
+  if (StackSize == StackCapacity) {
+    const size_t newCapacity =
+        StackCapacity ? (StackCapacity * 2) : (size_t)JSONParseStackInitialCapacity;
+    JSONValue* newStack = (JSONValue*)(
+        pStack ? OVR_REALLOC(pStack, newCapacity * sizeof(JSONValue))
+               : OVR_ALLOC(newCapacity * sizeof(JSONValue)));
+    if (!newStack)
+      return false;
+    pStack = newStack;
+    StackCapacity = newCapacity;
+  }
+
+  pStack[StackSize++] = item;
+  return true;
+}
+
+bool JSONDocumentParser::ParseContainer(JSONValue& value, int depth) {
+  if (depth >= JSONMaxDepth)
+    return Fail("Syntax Error: Nesting too deep");
+
+  const bool isObject = (*p == '{');
+  const char closing = isObject ? '}' : ']';
+  value.Type = isObject ? JSON_Object : JSON_Array;
+  value.pItems = nullptr;
+
+  ++p;
+  SkipWhitespace();
+
+  const size_t base = StackSize;
+
+  if (*p != closing) {
+    for (;;) {
+      const char* name = "";
+      if (isObject) {
+        if (*p != '\"')
+          return Fail("Syntax Error: Missing quote");
+
+        uint32_t nameSize;
+        if (!ParseString(name, nameSize))
+          return false;
+
+        SkipWhitespace();
+        if (*p != ':')
+          return Fail("Syntax Error: Missing colon");
+        ++p;
+        SkipWhitespace();
+      }
+
+      JSONValue item;
+      if (!ParseValue(item, depth + 1))
+        return false;
+      item.pName = name;
+
+      if (!PushItem(item))
+        return Fail("Error: Failed to allocate memory");
+
+      SkipWhitespace();
+      if (*p != ',')
+        break;
+      ++p;
+      SkipWhitespace();
+    }
+
+    if (*p != closing) {
+      return Fail(
+          isObject ? "Syntax Error: Missing closing brace"
+                   : "Syntax Error: Missing ending bracket");
+    }
+  }
+
+  ++p;
+
+  const size_t count = StackSize - base;
+  OVR_ASSERT(count <= UINT32_MAX);
+  value.Size = (uint32_t)count;
+
+  if (count) {
+    JSONValue* items = (JSONValue*)pDoc->Alloc(count * sizeof(JSONValue));
+    if (!items)
+      return Fail("Error: Failed to allocate memory");
+
+    memcpy(items, pStack + base, count * sizeof(JSONValue));
+    value.pItems = items;
+    StackSize = base;
+  }
+
+  return true;
+}
+
+// Unescapes the string in place and 0-terminates it.
+bool JSONDocumentParser::ParseString(const char*& str, uint32_t& size) {
+  char* start = ++p;
+  char* out = p;
+
+  for (;;) {
+    // Copy up to the next quote or escape. The unescaped string is never longer than its
+    // text, so out never passes p.
+    const char* found =
+        (const char*)OVR_memchr2((const uint8_t*)p, (size_t)(pEnd - p), '\"', '\\');
+    if (!found)
+      return Fail("Syntax Error: Missing quote");
+
+    const size_t run = (size_t)(found - p);
+    if (out != p)
+      memmove(out, p, run);
+    out += run;
+    p += run;
+
+    if (*p == '\"') {
+      *out = 0;
+      ++p;
+      str = start;
+      size = (uint32_t)(out - start);
+      return true;
+    }
+
+    ++p; // Skip the backslash.
+
+    switch (*p) {
+      case 'b':
+        *out++ = '\b';
+        ++p;
+        break;
+      case 'f':
+        *out++ = '\f';
+        ++p;
+        break;
+      case 'n':
+        *out++ = '\n';
+        ++p;
+        break;
+      case 'r':
+        *out++ = '\r';
+        ++p;
+        break;
+      case 't':
+        *out++ = '\t';
+        ++p;
+        break;
+
+      // Transcode utf16 to utf8.
+      case 'u': {
+        unsigned uc;
+        p = (char*)ParseJSONHex4(p + 1, uc);
+
+        // UTF16 surrogate pairs.
+        if ((uc >= 0xD800) && (uc <= 0xDBFF)) {
+          if ((p[0] != '\\') || (p[1] != 'u'))
+            break; // Missing second-half of surrogate.
+
+          unsigned uc2;
+          p = (char*)ParseJSONHex4(p + 2, uc2);
+          if ((uc2 < 0xDC00) || (uc2 > 0xDFFF))
+            break; // Invalid second-half of surrogate.
+
+          uc = 0x10000 + (((uc & 0x3FF) << 10) | (uc2 & 0x3FF));
+        } else if (((uc >= 0xDC00) && (uc <= 0xDFFF)) || (uc == 0)) {
+          break; // Invalid, like in JSON::Parse.
+        }
+
+        intptr_t encodedSize = 0;
+        UTF8Util::EncodeChar(out, &encodedSize, uc);
+        out += encodedSize;
+        break;
+      }
+
+      default:
+        if (p >= pEnd)
+          return Fail("Syntax Error: Missing quote");
+        *out++ = *p++; // '\"', '\\', '/', or an invalid escape which is passed through.
+        break;
+    }
+  }
+}
+
+bool JSONDocumentParser::ParseNumber(double& number) {
+  const char* end = JSONParseNumber(p, number);
+  if (!end)
+    return Fail("Syntax Error: Invalid syntax");
+
+  p = (char*)end;
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+// ***** JSONDocument parsing
+
+JSONDocument*
+JSONDocument::ParseText(JSONDocument* doc, char* text, size_t len, const char** perror) {
+  if (perror)
+    *perror = 0;
+
+  JSONDocumentParser parser(doc, text, len);
+  JSONValue* root = (JSONValue*)doc->Alloc(sizeof(JSONValue));
+
+  parser.SkipWhitespace();
+  if (!root || !parser.ParseValue(*root, 0)) {
+    if (perror)
+      *perror = parser.GetError() ? parser.GetError() : "Error: Failed to allocate memory";
+    doc->Release();
+    return nullptr;
+  }
+
+  doc->pRoot = root;
+  return doc;
+}
+
+JSONDocument* JSONDocument::Parse(const char* buff, const char** perror) {
+  if (!buff) {
+    if (perror)
+      *perror = "Syntax Error: Invalid syntax";
+    return nullptr;
+  }
+
+  return ParseBuffer(buff, OVR_strlen(buff), perror);
+}
+
+JSONDocument* JSONDocument::ParseBuffer(const char* buff, size_t len, const char** perror) {
+  JSONDocument* doc = new JSONDocument;
+  char* text = doc->AllocText(len);
+  if (!text) {
+    if (perror)
+      *perror = "Error: Failed to allocate memory";
+    doc->Release();
+    return nullptr;
+  }
+
+  memcpy(text, buff, len);
+  return ParseText(doc, text, len, perror);
+}
+
+JSONDocument* JSONDocument::Load(const char* path, const char** perror) {
+  SysFile f;
+  if (!f.Open(path, File::Open_Read, File::Mode_Read)) {
+    if (perror)
+      *perror = "Failed to open file";
+    return nullptr;
+  }
+
+  // Read the file straight into the document, rather than into a buffer to be copied.
+  const int len = f.GetLength();
+  JSONDocument* doc = new JSONDocument;
+  char* text = (len >= 0) ? doc->AllocText((size_t)len) : nullptr;
+  const int bytes = text ? f.Read((uint8_t*)text, len) : -1;
+  f.Close();
+
+  if ((bytes <= 0) || (bytes != len)) {
+    if (perror)
+      *perror = "Failed to read file";
+    doc->Release();
+    return nullptr;
+  }
+
+  return ParseText(doc, text, (size_t)len, perror);
+}
+
+//-----------------------------------------------------------------------------
+// ***** JSONValue accessors
+
+const JSONValue* JSONValue::GetItemByName(const char* name) const {
+  if (Type != JSON_Object)
+    return nullptr;
+
+  for (uint32_t i = 0; i < Size; i++) {
+    if (OVR_strcmp(pItems[i].pName, name) == 0)
+      return pItems + i;
+  }
+  return nullptr;
+}
+
+double JSONValue::GetNumberByName(const char* name, double defValue) const {
+  const JSONValue* item = GetItemByName(name);
+  return (item && (item->Type == JSON_Number)) ? item->Number : defValue;
+}
+
+int JSONValue::GetIntByName(const char* name, int defValue) const {
+  const JSONValue* item = GetItemByName(name);
+  return (item && (item->Type == JSON_Number)) ? (int)item->Number : defValue;
+}
+
+bool JSONValue::GetBoolByName(const char* name, bool defValue) const {
+  const JSONValue* item = GetItemByName(name);
+  return (item && (item->Type == JSON_Bool)) ? ((int)item->Number != 0) : defValue;
+}
+
+const char* JSONValue::GetStringByName(const char* name, const char* defValue) const {
+  const JSONValue* item = GetItemByName(name);
+  return (item && (item->Type == JSON_String)) ? item->pString : defValue;
+}
+
+double JSONValue::GetArrayNumber(int index) const {
+  if ((Type != JSON_Array) || (index < 0) || ((uint32_t)index >= Size))
+    return 0.;
+  return pItems[index].GetNumber();
+}
+
+const char* JSONValue::GetArrayString(int index) const {
+  if ((Type != JSON_Array) || (index < 0) || ((uint32_t)index >= Size))
+    return nullptr;
+  return pItems[index].GetString();
+}
+
+JSON* JSONValue::ToJSON() const {
+  JSON* json = nullptr;
+
+  switch (Type) {
+    case JSON_Null:
+      json = JSON::CreateNull();
+      break;
+    case JSON_Bool:
+      json = JSON::CreateBool(Number != 0.);
+      break;
+    case JSON_Number:
+      json = JSON::CreateNumber(Number);
+      break;
+    case JSON_String:
+      json = JSON::CreateString(pString);
+      break;
+    case JSON_Array:
+      json = JSON::CreateArray();
+      for (uint32_t i = 0; i < Size; i++)
+        json->AddArrayElement(pItems[i].ToJSON());
+      break;
+    case JSON_Object:
+      json = JSON::CreateObject();
+      for (uint32_t i = 0; i < Size; i++)
+        json->AddItem(pItems[i].pName, pItems[i].ToJSON());
+      break;
+    case JSON_None:
+      OVR_FAIL();
+      break;
+  }
+
+  return json;
+}
+
+} // namespace OVR
@@ -0,0 +1,220 @@
+/************************************************************************************
+
+Filename    :   OVR_JSONDocument.h
+Content     :   Read-only JSON tree parsed into a single arena
+Created     :   October 18, 2026
+Notes       :
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+#ifndef OVR_JSONDocument_h
+#define OVR_JSONDocument_h
+
+#include "OVR_JSON.h"
+#include "OVR_RefCount.h"
+#include "OVR_Types.h"
+
+namespace OVR {
+
+class JSONDocument;
+
+//-----------------------------------------------------------------------------
+// ***** JSONValue
+//
+// A node of a JSONDocument. It has the same read accessors as JSON, but the children of an
+// array or object are stored contiguously, so access by index is O(1), and strings are not
+// copied out of the document. JSONValues are owned by their document and are valid as long
+// as it is.
+
+class JSONValue {
+ public:
+  JSONItemType GetType() const {
+    return Type;
+  }
+
+  // Name part of the {Name, Value} pair in a parent object; "" otherwise.
+  const char* GetName() const {
+    return pName;
+  }
+
+  // The string for JSON_String, "true" or "false" for JSON_Bool, and "" otherwise.
+  const char* GetString() const {
+    if (Type == JSON_String)
+      return pString;
+    if (Type == JSON_Bool)
+      return (Number != 0.) ? "true" : "false";
+    return "";
+  }
+
+  // String size in bytes, for JSON_String.
+  size_t GetStringSize() const {
+    return (Type == JSON_String) ? Size : 0;
+  }
+
+  // The number for JSON_Number, 1 or 0 for JSON_Bool, and 0 otherwise.
+  double GetNumber() const {
+    return ((Type == JSON_Number) || (Type == JSON_Bool)) ? Number : 0.;
+  }
+
+  // *** Object Member Access
+
+  bool HasItems() const {
+    return IsContainer() && (Size != 0);
+  }
+
+  unsigned GetItemCount() const {
+    return IsContainer() ? Size : 0;
+  }
+
+  // Returns the child items as an array of GetItemCount() values.
+  const JSONValue* GetItems() const {
+    return IsContainer() ? pItems : nullptr;
+  }
+
+  const JSONValue* GetItemByIndex(unsigned index) const {
+    return (index < GetItemCount()) ? (pItems + index) : nullptr;
+  }
+
+  const JSONValue* GetItemByName(const char* name) const;
+
+  // Accessors by name
+  double GetNumberByName(const char* name, double defValue = 0.0) const;
+  int GetIntByName(const char* name, int defValue = 0) const;
+  bool GetBoolByName(const char* name, bool defValue = false) const;
+  const char* GetStringByName(const char* name, const char* defValue = "") const;
+
+  template <typename T>
+  int GetArrayByName(const char* name, T values[], int count, T defaultValue = T(0)) const {
+    // Zero values in case one or more elements not present in JSON
+    for (int i = 0; i < count; i++)
+      values[i] = defaultValue;
+
+    const JSONValue* array = GetItemByName(name);
+    if (!array || array->Type != JSON_Array)
+      return 0;
+
+    int i = 0;
+    for (; (i < count) && ((unsigned)i < array->Size); i++)
+      values[i] = (T)array->pItems[i].GetNumber();
+
+    return i;
+  }
+
+  // *** Array Element Access
+
+  int GetArraySize() const {
+    return (Type == JSON_Array) ? (int)Size : 0;
+  }
+  double GetArrayNumber(int index) const;
+  const char* GetArrayString(int index) const;
+
+  // Creates a JSON tree with a copy of this value, for code which needs to modify it.
+  // The returned object must be Released after use.
+  JSON* ToJSON() const;
+
+ private:
+  friend class JSONDocumentParser;
+
+  bool IsContainer() const {
+    return (Type == JSON_Array) || (Type == JSON_Object);
+  }
+
+  JSONItemType Type;
+  uint32_t Size; // Child count for arrays and objects, byte size for strings.
+  const char* pName;
+  union {
+    double Number;
+    const char* pString;
+    const JSONValue* pItems;
+  };
+};
+
+//-----------------------------------------------------------------------------
+// ***** JSONDocument
+//
+// A read-only alternative to JSON for loading large files. The input text is copied into the
+// document once, strings are unescaped in place in that copy, and the values are allocated
+// from the same arena, with the children of each array and object in one contiguous block.
+// Parsing a document costs a handful of heap allocations regardless of its size, while
+// JSON::Parse makes several per value. String scanning is vectorized with OVR_memchr2.
+//
+// Number text is converted with correct rounding, where JSON::Parse can be off in the last
+// digits. As with JSON::Parse, text after the root value is ignored; unlike it, a number
+// without digits is a syntax error rather than 0.
+//
+// Example usage:
+//     JSONDocument* doc = JSONDocument::Load(path, &error);
+//     if (doc) {
+//       double scale = doc->GetRoot()->GetNumberByName("Scale", 1.0);
+//       doc->Release();
+//     }
+
+class JSONDocument : public RefCountBase<JSONDocument> {
+ public:
+  ~JSONDocument();
+
+  // Returns null and fills in *perror in case of parse error. The returned document must be
+  // Released after use.
+  static JSONDocument* Parse(const char* buff, const char** perror = 0);
+  static JSONDocument* ParseBuffer(const char* buff, size_t len, const char** perror = 0);
+  static JSONDocument* Load(const char* path, const char** perror = 0);
+
+  const JSONValue* GetRoot() const {
+    return pRoot;
+  }
+
+  // Total bytes allocated for the document, including the copy of the input text.
+  size_t GetMemoryUsed() const;
+
+ private:
+  friend class JSONDocumentParser;
+
+  struct ArenaBlock {
+    ArenaBlock* pNext;
+    size_t Size; // Usable bytes after the header.
+    size_t Used;
+  };
+
+  JSONDocument() : pBlocks(nullptr), pRoot(nullptr), NextBlockSize(0) {}
+
+  // Allocates uninitialized, 8 byte aligned memory from the arena. Returns null on failure.
+  void* Alloc(size_t size);
+
+  // Allocates the block for the document's copy of the input text, with zeroed padding after
+  // it which the parser can read past the end of the text.
+  char* AllocText(size_t len);
+
+  // Parses the text returned by AllocText. Releases the document on failure.
+  static JSONDocument*
+  ParseText(JSONDocument* doc, char* text, size_t len, const char** perror);
+
+  ArenaBlock* pBlocks;
+  const JSONValue* pRoot;
+  size_t NextBlockSize;
+};
+
+// Converts the JSON number at str, with correct rounding and independent of the C locale.
+// Returns the end of the number, or nullptr if str doesn't start with one. The text must not
+// end in the middle of a number; a terminating null is enough.
+const char* JSONParseNumber(const char* str, double& number);
+
+} // namespace OVR
+
+#endif // OVR_JSONDocument_h
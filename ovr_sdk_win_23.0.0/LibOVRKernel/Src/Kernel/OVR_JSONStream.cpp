@@ -0,0 +1,772 @@
+/************************************************************************************
+
+Filename    :   OVR_JSONStream.cpp
+Content     :   Streaming JSON reader and writer over OVR::File
+Created     :   October 18, 2026
+Notes       :
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+#include "OVR_JSONStream.h"
+#include "OVR_Allocator.h"
+#include "OVR_Format.h"
+#include "OVR_JSONDocument.h"
+#include "OVR_Std.h"
+#include "OVR_UTF8Util.h"
+
+#include <ctype.h>
+#include <limits.h>
+#include <math.h>
+#include <string.h>
+
+namespace OVR {
+
+enum {
+  JSONReaderMinBufferSize = 64, // Room for the longest literal or escape sequence.
+  JSONReaderMaxDepth = 512 // Bounds the recursion in ReadValue.
+};
+
+//-----------------------------------------------------------------------------
+// ***** JSONReader
+
+JSONReader::JSONReader(File* file, size_t bufferSize)
+    : pFile(file),
+      pBuffer(nullptr),
+      BufferSize(Alg::Max(bufferSize, (size_t)JSONReaderMinBufferSize)),
+      pCur(nullptr),
+      pEnd(nullptr),
+      BufferOffset(0),
+      FileEnd(false),
+      pString(""),
+      StringSize(0),
+      Number(0.),
+      Token(JSONToken_None),
+      ItemDone(false),
+      NameDone(false),
+      RootDone(false),
+      Error(nullptr) {
+  pBuffer = (char*)OVR_ALLOC(BufferSize + 1);
+  if (pBuffer) {
+    pCur = pEnd = pBuffer;
+    *pEnd = 0;
+  }
+  if (!pBuffer || !pFile || !pFile->IsValid())
+    Fail(pBuffer ? "Failed to open file" : "Error: Failed to allocate memory");
+}
+
+JSONReader::~JSONReader() {
+  if (pBuffer)
+    OVR_FREE(pBuffer);
+}
+
+JSONTokenType JSONReader::Fail(const char* error) {
+  if (!Error)
+    Error = error;
+  Token = JSONToken_Error;
+  pString = "";
+  StringSize = 0;
+  return Token;
+}
+
+// Called after each complete value, including the end of objects and arrays.
+JSONTokenType JSONReader::ValueDone(JSONTokenType token) {
+  if (Stack.GetSize() == 0)
+    RootDone = true;
+  else
+    ItemDone = true;
+
+  Token = token;
+  return token;
+}
+
+// Makes at least minBytes of unread input available in the buffer, unless the file ends
+// first. Bytes before pCur are discarded. Returns whether minBytes are available.
+bool JSONReader::Fill(size_t minBytes) {
+  size_t available = (size_t)(pEnd - pCur);
+  if ((available >= minBytes) || FileEnd)
+    return available >= minBytes;
+
+  OVR_ASSERT(minBytes <= BufferSize);
+  if (pCur != pBuffer) {
+    memmove(pBuffer, pCur, available);
+    BufferOffset += (pCur - pBuffer);
+    pCur = pBuffer;
+    pEnd = pBuffer + available;
+  }
+
+  // Ask for as much as fits, to make fewer calls to the file.
+  while ((available < minBytes) && !FileEnd) {
+    const size_t room = BufferSize - available;
+    const int bytes = pFile->Read((uint8_t*)pEnd, (room > INT_MAX) ? INT_MAX : (int)room);
+
+    if (bytes <= 0) {
+      FileEnd = true; // Read errors are treated as the end of input, which fails the parse.
+    } else {
+      pEnd += bytes;
+      available += (size_t)bytes;
+    }
+  }
+
+  *pEnd = 0;
+  return available >= minBytes;
+}
+
+// Returns false at the end of input.
+bool JSONReader::SkipWhitespace() {
+  for (;;) {
+    while ((pCur < pEnd) && ((uint8_t)*pCur <= ' ') && *pCur)
+      ++pCur;
+
+    if (pCur < pEnd)
+      return true;
+    if (!Fill(1))
+      return false;
+  }
+}
+
+bool JSONReader::AppendString(const char* str, size_t size) {
+  if (size == 0)
+    return true; // The buffer may not be allocated yet, and memcpy requires a valid pointer.
+
+  const size_t oldSize = StringBuffer.GetSize();
+  StringBuffer.Resize(oldSize + size);
+  if (StringBuffer.GetSize() != (oldSize + size))
+    return false;
+
+  memcpy(StringBuffer.GetDataPtr() + oldSize, str, size);
+  return true;
+}
+
+// Reads the string at pCur. Strings without escapes which are entirely in the buffer are
+// returned in place; others are unescaped into StringBuffer.
+bool JSONReader::ReadString() {
+  OVR_ASSERT(*pCur == '\"');
+  ++pCur;
+
+  const char* start = pCur;
+  bool inPlace = true;
+  StringBuffer.Resize(0);
+
+  for (;;) {
+    char* found = (char*)OVR_memchr2((const uint8_t*)pCur, (size_t)(pEnd - pCur), '\"', '\\');
+
+    // Copy what was scanned before the buffer is refilled or the escape decoded.
+    if (!found || (*found == '\\')) {
+      const char* runStart = inPlace ? start : pCur;
+      const char* runEnd = found ? found : pEnd;
+      if (!AppendString(runStart, (size_t)(runEnd - runStart))) {
+        Fail("Error: Failed to allocate memory");
+        return false;
+      }
+      inPlace = false;
+    }
+
+    if (!found) {
+      pCur = pEnd;
+      if (!Fill(1)) {
+        Fail("Syntax Error: Missing quote");
+        return false;
+      }
+      continue;
+    }
+
+    if (*found == '\"') {
+      if (inPlace) {
+        *found = 0;
+        pString = start;
+        StringSize = (size_t)(found - start);
+      } else {
+        if (!AppendString(pCur, (size_t)(found - pCur)) || !AppendString("", 1)) {
+          Fail("Error: Failed to allocate memory");
+          return false;
+        }
+        pString = StringBuffer.GetDataPtr();
+        StringSize = StringBuffer.GetSize() - 1;
+      }
+
+      pCur = found + 1;
+      return true;
+    }
+
+    pCur = found + 1;
+    if (!ReadEscape())
+      return false;
+  }
+}
+
+// Parses up to 4 hex digits. Returns the first char after them.
+static const char* ParseHex4(const char* str, uint32_t& value) {
+  value = 0;
+
+  for (int digitCount = 0; (digitCount < 4) && isxdigit((uint8_t)*str); digitCount++, str++) {
+    const uint32_t c = (uint8_t)*str;
+    value = (value * 16) + ((c <= '9') ? (c - '0') : ((c | 0x20) - 'a' + 10));
+  }
+
+  return str;
+}
+
+// Decodes the escape sequence after a backslash at pCur into StringBuffer.
+bool JSONReader::ReadEscape() {
+  Fill(11); // The longest sequence is a surrogate pair: "uXXXX\uXXXX".
+  if (pCur == pEnd) {
+    Fail("Syntax Error: Missing quote");
+    return false;
+  }
+
+  char c = *pCur++;
+  switch (c) {
+    case 'b':
+      c = '\b';
+      break;
+    case 'f':
+      c = '\f';
+      break;
+    case 'n':
+      c = '\n';
+      break;
+    case 'r':
+      c = '\r';
+      break;
+    case 't':
+      c = '\t';
+      break;
+
+    // Transcode utf16 to utf8.
+    case 'u': {
+      uint32_t uc;
+      const char* p = ParseHex4(pCur, uc);
+
+      // UTF16 surrogate pairs.
+      if ((uc >= 0xD800) && (uc <= 0xDBFF)) {
+        if ((p[0] != '\\') || (p[1] != 'u')) {
+          pCur = (char*)p;
+          return true; // Missing second-half of surrogate.
+        }
+
+        uint32_t uc2;
+        p = ParseHex4(p + 2, uc2);
+
+        pCur = (char*)p;
+        if ((uc2 < 0xDC00) || (uc2 > 0xDFFF))
+          return true; // Invalid second-half of surrogate.
+
+        uc = 0x10000 + (((uc & 0x3FF) << 10) | (uc2 & 0x3FF));
+      } else {
+        pCur = (char*)p;
+        if (((uc >= 0xDC00) && (uc <= 0xDFFF)) || (uc == 0))
+          return true; // Invalid, like in JSON::Parse.
+      }
+
+      char encoded[8];
+      intptr_t encodedSize = 0;
+      UTF8Util::EncodeChar(encoded, &encodedSize, uc);
+      if (!AppendString(encoded, (size_t)encodedSize)) {
+        Fail("Error: Failed to allocate memory");
+        return false;
+      }
+      return true;
+    }
+
+    default: // '\"', '\\', '/', or an invalid escape which is passed through.
+      break;
+  }
+
+  if (!AppendString(&c, 1)) {
+    Fail("Error: Failed to allocate memory");
+    return false;
+  }
+  return true;
+}
+
+// Reads the number at pCur. Its text is collected in StringBuffer, since it may span a
+// buffer refill.
+bool JSONReader::ReadNumber() {
+  StringBuffer.Resize(0);
+
+  for (;;) {
+    const char* p = pCur;
+    while ((p < pEnd) &&
+           (((*p >= '0') && (*p <= '9')) || (*p == '-') || (*p == '+') || (*p == '.') ||
+            (*p == 'e') || (*p == 'E')))
+      ++p;
+
+    if (!AppendString(pCur, (size_t)(p - pCur))) {
+      Fail("Error: Failed to allocate memory");
+      return false;
+    }
+    pCur = (char*)p;
+
+    if ((pCur < pEnd) || !Fill(1))
+      break;
+  }
+
+  if (!AppendString("", 1)) {
+    Fail("Error: Failed to allocate memory");
+    return false;
+  }
+
+  const char* text = StringBuffer.GetDataPtr();
+  const char* end = JSONParseNumber(text, Number);
+  if (!end || (*end != 0)) {
+    Fail("Syntax Error: Invalid syntax");
+    return false;
+  }
+
+  return true;
+}
+
+JSONTokenType JSONReader::Next() {
+  if ((Token == JSONToken_Error) || (Token == JSONToken_End))
+    return Token;
+
+  pString = "";
+  StringSize = 0;
+  Number = 0.;
+
+  if (RootDone)
+    return (Token = JSONToken_End);
+
+  if (!SkipWhitespace()) {
+    if (Stack.GetSize() == 0)
+      return Fail("Syntax Error: Invalid syntax");
+    return Fail(
+        (Stack.Back() == '{') ? "Syntax Error: Missing closing brace"
+                              : "Syntax Error: Missing ending bracket");
+  }
+
+  if (Stack.GetSize() != 0) {
+    const bool inObject = (Stack.Back() == '{');
+
+    if (NameDone) {
+      if (*pCur != ':')
+        return Fail("Syntax Error: Missing colon");
+      ++pCur;
+      SkipWhitespace();
+      NameDone = false;
+    } else {
+      if (*pCur == (inObject ? '}' : ']')) {
+        ++pCur;
+        Stack.PopBack();
+        return ValueDone(inObject ? JSONToken_EndObject : JSONToken_EndArray);
+      }
+
+      if (ItemDone) {
+        if (*pCur != ',') {
+          return Fail(
+              inObject ? "Syntax Error: Missing closing brace"
+                       : "Syntax Error: Missing ending bracket");
+        }
+        ++pCur;
+        SkipWhitespace();
+      }
+
+      if (inObject) {
+        if (*pCur != '\"')
+          return Fail("Syntax Error: Missing quote");
+        if (!ReadString())
+          return Token;
+
+        // The colon is checked by the next call, so that reading ahead for it can't move
+        // the name in the buffer.
+        NameDone = true;
+        return (Token = JSONToken_Name);
+      }
+    }
+  }
+
+  // A value. Make sure literals are entirely in the buffer.
+  Fill(5);
+
+  switch (*pCur) {
+    case '{':
+    case '[':
+      if (Stack.GetSize() >= JSONReaderMaxDepth)
+        return Fail("Syntax Error: Nesting too deep");
+
+      Stack.PushBack(*pCur);
+      ItemDone = false;
+      return (Token = (*pCur++ == '{') ? JSONToken_BeginObject : JSONToken_BeginArray);
+
+    case '\"':
+      if (!ReadString())
+        return Token;
+      return ValueDone(JSONToken_String);
+
+    case 'n':
+      if (strncmp(pCur, "null", 4) == 0) {
+        pCur += 4;
+        return ValueDone(JSONToken_Null);
+      }
+      break;
+
+    case 't':
+      if (strncmp(pCur, "true", 4) == 0) {
+        pCur += 4;
+        Number = 1.;
+        return ValueDone(JSONToken_Bool);
+      }
+      break;
+
+    case 'f':
+      if (strncmp(pCur, "false", 5) == 0) {
+        pCur += 5;
+        return ValueDone(JSONToken_Bool);
+      }
+      break;
+
+    default:
+      if ((*pCur == '-') || ((*pCur >= '0') && (*pCur <= '9'))) {
+        if (!ReadNumber())
+          return Token;
+        return ValueDone(JSONToken_Number);
+      }
+      break;
+  }
+
+  return Fail("Syntax Error: Invalid syntax");
+}
+
+bool JSONReader::SkipValue() {
+  if ((Token != JSONToken_BeginObject) && (Token != JSONToken_BeginArray))
+    return (Token != JSONToken_Error) && (Token != JSONToken_End);
+
+  const int depth = GetDepth() - 1;
+  while (Next() != JSONToken_Error) {
+    if (GetDepth() == depth)
+      return true;
+  }
+  return false;
+}
+
+JSON* JSONReader::ReadValue() {
+  JSON* json = JSON::CreateNull();
+  if (!ReadValueInto(json)) {
+    json->Release();
+    return nullptr;
+  }
+  return json;
+}
+
+// Fills in json from the current token, reading on through the end of containers.
+bool JSONReader::ReadValueInto(JSON* json) {
+  switch (Token) {
+    case JSONToken_Null:
+      json->Type = JSON_Null;
+      return true;
+
+    case JSONToken_Bool:
+      json->Type = JSON_Bool;
+      json->dValue = Number;
+      json->Value = GetBool() ? "true" : "false";
+      return true;
+
+    case JSONToken_Number:
+      json->Type = JSON_Number;
+      json->dValue = Number;
+      return true;
+
+    case JSONToken_String:
+      json->Type = JSON_String;
+      json->Value.AssignString(pString, StringSize);
+      return true;
+
+    case JSONToken_BeginArray:
+      json->Type = JSON_Array;
+      while (Next() != JSONToken_EndArray) {
+        if (Token == JSONToken_Error)
+          return false;
+
+        JSON* item = JSON::CreateNull();
+        json->AddArrayElement(item);
+        if (!ReadValueInto(item))
+          return false;
+      }
+      return true;
+
+    case JSONToken_BeginObject:
+      json->Type = JSON_Object;
+      while (Next() == JSONToken_Name) {
+        JSON* item = JSON::CreateNull();
+        json->AddItem(pString, item);
+        if ((Next() == JSONToken_Error) || !ReadValueInto(item))
+          return false;
+      }
+      return Token == JSONToken_EndObject;
+
+    default:
+      return false;
+  }
+}
+
+//-----------------------------------------------------------------------------
+// ***** JSONWriter
+
+JSONWriter::JSONWriter(File* file, bool fmt)
+    : pFile(file),
+      Format(fmt),
+      Failed(!file || !file->IsValid()),
+      ItemDone(false),
+      NameDone(false),
+      BufferUsed(0) {}
+
+JSONWriter::~JSONWriter() {
+  OVR_ASSERT_M(Stack.GetSize() == 0, "JSONWriter: Unclosed object or array.");
+  FlushBuffer();
+}
+
+void JSONWriter::FlushBuffer() {
+  if (BufferUsed && !Failed) {
+    if (pFile->Write((const uint8_t*)Buffer, (int)BufferUsed) != (int)BufferUsed)
+      Failed = true;
+  }
+  BufferUsed = 0;
+}
+
+bool JSONWriter::Flush() {
+  FlushBuffer();
+  if (!Failed && !pFile->Flush())
+    Failed = true;
+  return !Failed;
+}
+
+void JSONWriter::WriteRaw(const char* str, size_t size) {
+  while (size) {
+    if (BufferUsed == BufferSize)
+      FlushBuffer();
+
+    const size_t count = Alg::Min(size, BufferSize - BufferUsed);
+    memcpy(Buffer + BufferUsed, str, count);
+    BufferUsed += count;
+    str += count;
+    size -= count;
+  }
+}
+
+void JSONWriter::WriteNewLine(size_t tabCount) {
+#ifdef OVR_OS_WIN32
+  WriteRawChar('\r');
+#endif
+  WriteRawChar('\n');
+  for (size_t i = 0; i < tabCount; i++)
+    WriteRawChar('\t');
+}
+
+// Writes the separator before a value, and the indentation for object members.
+void JSONWriter::BeginValue() {
+  if (Stack.GetSize() == 0)
+    return;
+
+  if (Stack.Back() == '{') {
+    OVR_ASSERT_M(NameDone, "JSONWriter: Object member without a name.");
+    NameDone = false;
+  } else {
+    if (ItemDone) {
+      WriteRawChar(',');
+      if (Format)
+        WriteRawChar(' ');
+    }
+  }
+
+  ItemDone = true;
+}
+
+void JSONWriter::WriteName(const char* name) {
+  OVR_ASSERT_M((Stack.GetSize() != 0) && (Stack.Back() == '{') && !NameDone,
+               "JSONWriter: Name outside of an object.");
+  if (ItemDone)
+    WriteRawChar(',');
+  if (Format)
+    WriteNewLine(Stack.GetSize());
+
+  WriteEscaped(name, name ? OVR_strlen(name) : 0);
+  WriteRawChar(':');
+  if (Format)
+    WriteRawChar('\t');
+
+  NameDone = true;
+}
+
+void JSONWriter::BeginObject() {
+  BeginValue();
+  WriteRawChar('{');
+  Stack.PushBack('{');
+  ItemDone = false;
+}
+
+void JSONWriter::BeginArray() {
+  BeginValue();
+  WriteRawChar('[');
+  Stack.PushBack('[');
+  ItemDone = false;
+}
+
+void JSONWriter::EndContainer(char closing) {
+  OVR_ASSERT_M(
+      (Stack.GetSize() != 0) && (Stack.Back() == ((closing == '}') ? '{' : '[')) && !NameDone,
+      "JSONWriter: Mismatched end of object or array.");
+  if (Stack.GetSize() == 0)
+    return;
+
+  Stack.PopBack();
+
+  // Same layout as JSON::PrintObject, including the one less tab for empty objects.
+  if (Format && (closing == '}')) {
+    const size_t depth = Stack.GetSize();
+    WriteNewLine(ItemDone ? depth : ((depth > 0) ? depth - 1 : 0));
+  }
+
+  WriteRawChar(closing);
+  ItemDone = true; // The container is an item of its parent.
+}
+
+void JSONWriter::EndObject() {
+  EndContainer('}');
+}
+
+void JSONWriter::EndArray() {
+  EndContainer(']');
+}
+
+void JSONWriter::WriteNull() {
+  BeginValue();
+  WriteRaw("null", 4);
+}
+
+void JSONWriter::WriteBool(bool b) {
+  BeginValue();
+  if (b)
+    WriteRaw("true", 4);
+  else
+    WriteRaw("false", 5);
+}
+
+void JSONWriter::WriteNumber(double num) {
+  if (!isfinite(num)) {
+    WriteNull();
+    return;
+  }
+
+  BeginValue();
+  char buffer[FormatNumberCapacity];
+  WriteRaw(buffer, FormatFloatingPoint(buffer, num));
+}
+
+void JSONWriter::WriteInt(int64_t num) {
+  BeginValue();
+  char buffer[FormatNumberCapacity];
+  WriteRaw(buffer, FormatInteger(buffer, num));
+}
+
+void JSONWriter::WriteString(const char* str) {
+  WriteString(str, str ? OVR_strlen(str) : 0);
+}
+
+void JSONWriter::WriteString(const char* str, size_t size) {
+  BeginValue();
+  WriteEscaped(str, size);
+}
+
+// Writes the string in quotes, escaped the same as by JSON::Stringify.
+void JSONWriter::WriteEscaped(const char* str, size_t size) {
+  WriteRawChar('\"');
+
+  const char* end = str + size;
+  while (str < end) {
+    // Copy the run of chars which need no escaping.
+    const char* run = str;
+    while ((str < end) && ((uint8_t)*str > 31) && (*str != '\"') && (*str != '\\'))
+      ++str;
+    WriteRaw(run, (size_t)(str - run));
+
+    if (str == end)
+      break;
+
+    const uint8_t c = (uint8_t)*str++;
+    WriteRawChar('\\');
+    switch (c) {
+      case '\\':
+      case '\"':
+        WriteRawChar((char)c);
+        break;
+      case '\b':
+        WriteRawChar('b');
+        break;
+      case '\f':
+        WriteRawChar('f');
+        break;
+      case '\n':
+        WriteRawChar('n');
+        break;
+      case '\r':
+        WriteRawChar('r');
+        break;
+      case '\t':
+        WriteRawChar('t');
+        break;
+      default: {
+        static const char HexDigits[] = "0123456789abcdef";
+        const char escape[5] = {'u', '0', '0', HexDigits[c >> 4], HexDigits[c & 15]};
+        WriteRaw(escape, sizeof(escape));
+        break;
+      }
+    }
+  }
+
+  WriteRawChar('\"');
+}
+
+void JSONWriter::WriteValue(JSON* json) {
+  if (!json) {
+    WriteNull();
+    return;
+  }
+
+  switch (json->Type) {
+    case JSON_Bool:
+      WriteBool((int)json->dValue != 0);
+      break;
+    case JSON_Number:
+      WriteNumber(json->dValue);
+      break;
+    case JSON_String:
+      WriteString(json->Value.ToCStr(), json->Value.GetSize());
+      break;
+    case JSON_Array:
+      BeginArray();
+      for (JSON* item = json->GetFirstItem(); item; item = json->GetNextItem(item))
+        WriteValue(item);
+      EndArray();
+      break;
+    case JSON_Object:
+      BeginObject();
+      for (JSON* item = json->GetFirstItem(); item; item = json->GetNextItem(item)) {
+        WriteName(item->Name.ToCStr());
+        WriteValue(item);
+      }
+      EndObject();
+      break;
+    default:
+      WriteNull();
+      break;
+  }
+}
+
+} // namespace OVR
@@ -0,0 +1,239 @@
+/************************************************************************************
+
+Filename    :   OVR_JSONStream.h
+Content     :   Streaming JSON reader and writer over OVR::File
+Created     :   October 18, 2026
+Notes       :
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+#ifndef OVR_JSONStream_h
+#define OVR_JSONStream_h
+
+#include "OVR_Array.h"
+#include "OVR_File.h"
+#include "OVR_JSON.h"
+#include "OVR_Types.h"
+
+namespace OVR {
+
+// JSONTokenType is what JSONReader::Next read.
+enum JSONTokenType {
+  JSONToken_None = 0, // Nothing has been read yet.
+  JSONToken_BeginObject,
+  JSONToken_EndObject,
+  JSONToken_BeginArray,
+  JSONToken_EndArray,
+  JSONToken_Name, // Name part of the {Name, Value} pair in an object.
+  JSONToken_Null,
+  JSONToken_Bool,
+  JSONToken_Number,
+  JSONToken_String,
+  JSONToken_End, // The root value is complete; text after it is ignored, as by JSON::Parse.
+  JSONToken_Error
+};
+
+//-----------------------------------------------------------------------------
+// ***** JSONReader
+//
+// Pull parser which reads JSON text from a File one token at a time, for files too large to
+// load as a JSON tree, such as recorded tracking sessions. Memory use is the read buffer plus
+// the longest string in the input, however large the file is. Values of manageable size can
+// still be read as trees with ReadValue.
+//
+// Example usage, for a file holding an array of samples:
+//     JSONReader reader(file);
+//     if (reader.Next() == JSONToken_BeginArray) {
+//       while (reader.Next() == JSONToken_BeginObject) {
+//         JSON* sample = reader.ReadValue();
+//         ...
+//         sample->Release();
+//       }
+//     }
+//     if (reader.GetToken() == JSONToken_Error)
+//       ... reader.GetError() ...
+
+class JSONReader {
+ public:
+  enum { DefaultBufferSize = 65536 };
+
+  JSONReader(File* file, size_t bufferSize = DefaultBufferSize);
+  ~JSONReader();
+
+  // Reads the next token. After JSONToken_End or JSONToken_Error, keeps returning it.
+  JSONTokenType Next();
+
+  JSONTokenType GetToken() const {
+    return Token;
+  }
+
+  // The text of a Name or String token, null-terminated. Valid until the next call to Next.
+  const char* GetString() const {
+    return pString;
+  }
+  size_t GetStringSize() const {
+    return StringSize;
+  }
+
+  // The value of a Number token, or 1 or 0 for a Bool token.
+  double GetNumber() const {
+    return Number;
+  }
+  bool GetBool() const {
+    return Number != 0.;
+  }
+
+  // Number of objects and arrays that are open at the current token.
+  int GetDepth() const {
+    return (int)Stack.GetSize();
+  }
+
+  // Skips the rest of the value starting at the current token, through its end token if it's
+  // an object or array. Returns false on error.
+  bool SkipValue();
+
+  // Reads the value starting at the current token into a new JSON tree, through its end
+  // token if it's an object or array. Returns null on error. The returned object must be
+  // Released after use.
+  JSON* ReadValue();
+
+  // The error message for a JSONToken_Error token, in the style of JSON::Parse's.
+  const char* GetError() const {
+    return Error;
+  }
+
+  // Number of bytes of the file consumed so far, for progress reporting.
+  int64_t GetOffset() const {
+    return BufferOffset + (pCur - pBuffer);
+  }
+
+ private:
+  JSONTokenType Fail(const char* error);
+  JSONTokenType ValueDone(JSONTokenType token);
+  bool Fill(size_t minBytes);
+  bool SkipWhitespace();
+  bool ReadString();
+  bool ReadEscape();
+  bool ReadNumber();
+  bool AppendString(const char* str, size_t size);
+  bool ReadValueInto(JSON* json);
+
+  Ptr<File> pFile;
+  char* pBuffer; // BufferSize chars plus a terminating null.
+  size_t BufferSize;
+  char* pCur;
+  char* pEnd;
+  int64_t BufferOffset; // File offset of pBuffer.
+  bool FileEnd;
+
+  // String tokens are returned from the read buffer where possible, and otherwise from
+  // StringBuffer, which grows to the longest such string.
+  const char* pString;
+  size_t StringSize;
+  ArrayPOD<char> StringBuffer;
+  double Number;
+
+  JSONTokenType Token;
+  ArrayPOD<char> Stack; // '{' or '[' for each open object or array.
+  bool ItemDone; // The innermost object or array has an item, so the next needs a ','.
+  bool NameDone; // A name was read, so the next token is its value.
+  bool RootDone;
+  const char* Error;
+};
+
+//-----------------------------------------------------------------------------
+// ***** JSONWriter
+//
+// Writes JSON text to a File as values are added, without building a tree, so that large
+// outputs use no more memory than the write buffer. Separators are added automatically;
+// in objects, WriteName must precede each value. With formatting enabled, the layout is the
+// same as JSON::Stringify(true)'s.
+//
+// Numbers are written with the shortest text which reads back as the same double (see
+// FormatFloatingPoint), so values round-trip exactly. JSON has no representation of NaN or
+// infinity, so those are written as null.
+//
+// Write errors are sticky: after one, further writes are ignored and HasError returns true.
+//
+// Example usage:
+//     JSONWriter writer(file);
+//     writer.BeginObject();
+//     writer.WriteName("Timestamp");
+//     writer.WriteNumber(t);
+//     writer.EndObject();
+//     bool ok = writer.Flush();
+
+class JSONWriter {
+ public:
+  JSONWriter(File* file, bool fmt = false);
+  ~JSONWriter(); // Flushes.
+
+  void BeginObject();
+  void EndObject();
+  void BeginArray();
+  void EndArray();
+
+  void WriteName(const char* name);
+
+  void WriteNull();
+  void WriteBool(bool b);
+  void WriteNumber(double num);
+  void WriteInt(int64_t num);
+  void WriteString(const char* str);
+  void WriteString(const char* str, size_t size);
+
+  // Writes a JSON tree as a single value.
+  void WriteValue(JSON* json);
+
+  // Writes out buffered text. Returns false if any write failed.
+  bool Flush();
+
+  bool HasError() const {
+    return Failed;
+  }
+
+ private:
+  enum { BufferSize = 4096 };
+
+  void BeginValue();
+  void EndContainer(char closing);
+  void WriteNewLine(size_t tabCount);
+  void WriteRaw(const char* str, size_t size);
+  void WriteRawChar(char c) {
+    if (BufferUsed == BufferSize)
+      FlushBuffer();
+    Buffer[BufferUsed++] = c;
+  }
+  void WriteEscaped(const char* str, size_t size);
+  void FlushBuffer();
+
+  Ptr<File> pFile;
+  bool Format;
+  bool Failed;
+  bool ItemDone; // The innermost object or array has an item, so the next needs a ','.
+  bool NameDone; // A name was written, so the next call writes its value.
+  ArrayPOD<char> Stack; // '{' or '[' for each open object or array.
+  size_t BufferUsed;
+  char Buffer[BufferSize];
+};
+
+} // namespace OVR
+
+#endif // OVR_JSONStream_h
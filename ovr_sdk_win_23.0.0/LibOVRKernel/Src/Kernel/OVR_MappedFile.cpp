@@ -0,0 +1,265 @@
+/************************************************************************************
+
+Filename    :   OVR_MappedFile.cpp
+Content     :   Read-only memory mapped File implementation
+Created     :   October 18, 2026
+Notes       :
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+#include "OVR_File.h"
+#include "OVR_Allocator.h"
+#include "OVR_UTF8Util.h"
+
+#include <errno.h>
+#include <string.h>
+
+#if defined(OVR_OS_MS)
+#include "OVR_Win32_IncludeWindows.h"
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace OVR {
+
+// Empty files can't be mapped; they get this instead, so GetData is never null when valid.
+static const uint8_t EmptyMappedData[1] = {0};
+
+MappedFile::MappedFile(const char* pfileName, AccessPattern pattern)
+    : FilePath(pfileName), pData(nullptr), DataSize(0), Pos(0), ErrorCode(0), Valid(false) {
+  Open(pattern);
+}
+
+MappedFile::MappedFile(const String& fileName, AccessPattern pattern)
+    : FilePath(fileName), pData(nullptr), DataSize(0), Pos(0), ErrorCode(0), Valid(false) {
+  Open(pattern);
+}
+
+MappedFile::~MappedFile() {
+  Close();
+}
+
+#if defined(OVR_OS_MS)
+
+static int MappedFileError(DWORD error) {
+  switch (error) {
+    case ERROR_FILE_NOT_FOUND:
+    case ERROR_PATH_NOT_FOUND:
+      return FileConstants::Error_FileNotFound;
+    case ERROR_ACCESS_DENIED:
+    case ERROR_SHARING_VIOLATION:
+      return FileConstants::Error_Access;
+    default:
+      return FileConstants::Error_IOError;
+  }
+}
+
+void MappedFile::Open(AccessPattern pattern) {
+  auto fileNameLength = (size_t)UTF8Util::GetLength(FilePath.ToCStr()) + 1;
+  wchar_t* pwFileName = (wchar_t*)OVR_ALLOC(fileNameLength * sizeof(pwFileName[0]));
+  if (!pwFileName) {
+    ErrorCode = Error_IOError;
+    return;
+  }
+
+  HANDLE hFile = INVALID_HANDLE_VALUE;
+  auto requiredUTF8Length = OVR::UTF8Util::Strlcpy(pwFileName, fileNameLength, FilePath.ToCStr());
+  if (requiredUTF8Length < fileNameLength) {
+    const DWORD flags = (pattern == Access_Sequential)
+        ? FILE_FLAG_SEQUENTIAL_SCAN
+        : (pattern == Access_Random) ? FILE_FLAG_RANDOM_ACCESS : FILE_ATTRIBUTE_NORMAL;
+    hFile = ::CreateFileW(
+        pwFileName,
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_DELETE,
+        nullptr,
+        OPEN_EXISTING,
+        flags,
+        nullptr);
+  }
+  OVR_FREE(pwFileName);
+
+  if (hFile == INVALID_HANDLE_VALUE) {
+    ErrorCode = MappedFileError(::GetLastError());
+    return;
+  }
+
+  LARGE_INTEGER size;
+  if (!::GetFileSizeEx(hFile, &size)) {
+    ErrorCode = MappedFileError(::GetLastError());
+    ::CloseHandle(hFile);
+    return;
+  }
+
+  if (size.QuadPart == 0) {
+    pData = EmptyMappedData;
+  } else if ((uint64_t)size.QuadPart > (uint64_t)SIZE_MAX) {
+    ErrorCode = Error_IOError; // Too large for the address space.
+  } else {
+    // The view keeps the mapping and file open, so their handles can be closed right away.
+    HANDLE hMapping = ::CreateFileMappingW(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (hMapping) {
+      pData = (const uint8_t*)::MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0);
+      ::CloseHandle(hMapping);
+    }
+    if (!pData)
+      ErrorCode = MappedFileError(::GetLastError());
+  }
+
+  ::CloseHandle(hFile);
+
+  if (pData) {
+    DataSize = (uint64_t)size.QuadPart;
+    Valid = true;
+  }
+}
+
+bool MappedFile::Close() {
+  if (!Valid)
+    return false;
+
+  if (pData != EmptyMappedData)
+    ::UnmapViewOfFile(pData);
+
+  pData = nullptr;
+  DataSize = Pos = 0;
+  Valid = false;
+  return true;
+}
+
+#else // OVR_OS_MS
+
+static int MappedFileError(int error) {
+  if (error == ENOENT)
+    return FileConstants::Error_FileNotFound;
+  else if (error == EACCES || error == EPERM)
+    return FileConstants::Error_Access;
+  else
+    return FileConstants::Error_IOError;
+}
+
+void MappedFile::Open(AccessPattern pattern) {
+  const int fd = ::open(FilePath.ToCStr(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    ErrorCode = MappedFileError(errno);
+    return;
+  }
+
+  struct stat fileStat {};
+  if (::fstat(fd, &fileStat) != 0) {
+    ErrorCode = MappedFileError(errno);
+    ::close(fd);
+    return;
+  }
+
+  if (fileStat.st_size == 0) {
+    pData = EmptyMappedData;
+  } else if ((uint64_t)fileStat.st_size > (uint64_t)SIZE_MAX) {
+    ErrorCode = Error_IOError; // Too large for the address space.
+  } else {
+    // The mapping keeps the file open, so the descriptor can be closed right away.
+    void* data = ::mmap(nullptr, (size_t)fileStat.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+      ErrorCode = MappedFileError(errno);
+    } else {
+      pData = (const uint8_t*)data;
+
+      // Sequential access also starts read-ahead of the whole file right away.
+      if (pattern == Access_Sequential) {
+        ::madvise(data, (size_t)fileStat.st_size, MADV_SEQUENTIAL);
+        ::madvise(data, (size_t)fileStat.st_size, MADV_WILLNEED);
+      } else if (pattern == Access_Random) {
+        ::madvise(data, (size_t)fileStat.st_size, MADV_RANDOM);
+      }
+    }
+  }
+
+  ::close(fd);
+
+  if (pData) {
+    DataSize = (uint64_t)fileStat.st_size;
+    Valid = true;
+  }
+}
+
+bool MappedFile::Close() {
+  if (!Valid)
+    return false;
+
+  if (pData != EmptyMappedData)
+    ::munmap((void*)pData, (size_t)DataSize);
+
+  pData = nullptr;
+  DataSize = Pos = 0;
+  Valid = false;
+  return true;
+}
+
+#endif // OVR_OS_MS
+
+int MappedFile::Read(uint8_t* pbuffer, int numBytes) {
+  if (!Valid || (numBytes < 0))
+    return -1;
+
+  const size_t count = (size_t)Alg::Min((uint64_t)numBytes, DataSize - Pos);
+  memcpy(pbuffer, pData + Pos, count);
+  Pos += count;
+  return (int)count;
+}
+
+int MappedFile::SkipBytes(int numBytes) {
+  if (!Valid || (numBytes < 0))
+    return -1;
+
+  const uint64_t count = Alg::Min((uint64_t)numBytes, DataSize - Pos);
+  Pos += count;
+  return (int)count;
+}
+
+int64_t MappedFile::LSeek(int64_t offset, int origin) {
+  if (!Valid)
+    return -1;
+
+  int64_t newPos;
+  switch (origin) {
+    case Seek_Set:
+      newPos = offset;
+      break;
+    case Seek_Cur:
+      newPos = (int64_t)Pos + offset;
+      break;
+    case Seek_End:
+      newPos = (int64_t)DataSize + offset;
+      break;
+    default:
+      return -1;
+  }
+
+  // Unlike a FILE, positions past the end are clamped, since there's no writing to fill them.
+  if (newPos < 0)
+    return -1;
+  Pos = Alg::Min((uint64_t)newPos, DataSize);
+  return (int64_t)Pos;
+}
+
+} // namespace OVR
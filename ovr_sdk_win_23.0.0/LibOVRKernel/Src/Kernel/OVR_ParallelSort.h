@@ -0,0 +1,163 @@
+/************************************************************************************
+
+Filename    :   OVR_ParallelSort.h
+Content     :   Multi-threaded IntroSort for large arrays
+Created     :   October 18, 2026
+Notes       :
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+#ifndef OVR_ParallelSort_h
+#define OVR_ParallelSort_h
+
+#include "OVR_Alg.h"
+
+#include <thread>
+#include <vector>
+
+namespace OVR {
+namespace Alg {
+
+//-----------------------------------------------------------------------------------
+// ***** ParallelSortSliced
+//
+// Sort any part of any array: plain, Array, ArrayPaged, ArrayUnsafe.
+// The range is specified with start, end, where "end" is exclusive!
+// The comparison predicate must be specified, and must be safe to call concurrently.
+//
+// The range is partitioned with the IntroSort partition step, and the two sides of each
+// partition are sorted concurrently (fork-join) until the worker budget is used up or the
+// sub-ranges are smaller than ParallelSortGrainSize, at which point each worker finishes
+// its range with IntroSortSliced. The array's operator[] must be safe to call concurrently
+// for distinct elements, which is the case for all of the OVR array types.
+//
+// threadCount is the maximum number of threads which work on the sort, including the
+// calling thread. Zero means std::thread::hardware_concurrency().
+// Ranges below ParallelSortGrainSize elements are sorted on the calling thread only.
+//
+// Example usage:
+//     ArrayAdaptor<double> arr(data, count);
+//     ParallelSort(arr);
+
+enum {
+  ParallelSortGrainSize = 16384 // Ranges smaller than this are not worth a thread.
+};
+
+template <class Array, class Less>
+void ParallelSortTask(
+    Array& arr,
+    intptr_t base,
+    intptr_t limit,
+    Less less,
+    int badAllowed,
+    unsigned extraThreads) {
+  std::vector<std::thread> children;
+
+  while ((extraThreads > 0) && ((limit - base) >= ParallelSortGrainSize)) {
+    intptr_t len = limit - base;
+    intptr_t pivotPos;
+    bool alreadyPartitioned;
+    IntroSortPartition<false>(arr, base, limit, less, pivotPos, alreadyPartitioned);
+
+    intptr_t lSize = pivotPos - base;
+    intptr_t rSize = limit - (pivotPos + 1);
+
+    if ((lSize < len / 8) || (rSize < len / 8)) {
+      if (--badAllowed == 0) {
+        HeapSortSliced(arr, (size_t)base, (size_t)limit, less);
+        base = limit; // Sorted; only the children are left to wait for.
+        break;
+      }
+    }
+
+    // Hand the smaller side to a new thread along with a share of the remaining budget,
+    // and keep the larger side on this thread.
+    unsigned childThreads = (extraThreads - 1) / 2;
+    extraThreads -= (childThreads + 1);
+
+    intptr_t childBase, childLimit;
+    if (lSize < rSize) {
+      childBase = base;
+      childLimit = pivotPos;
+      base = pivotPos + 1;
+    } else {
+      childBase = pivotPos + 1;
+      childLimit = limit;
+      limit = pivotPos;
+    }
+
+    children.emplace_back([&arr, childBase, childLimit, less, badAllowed, childThreads] {
+      ParallelSortTask(arr, childBase, childLimit, less, badAllowed, childThreads);
+    });
+  }
+
+  if (limit - base >= 2)
+    IntroSortLoop<false>(arr, base, limit, less, badAllowed);
+
+  for (std::thread& child : children)
+    child.join();
+}
+
+template <class Array, class Less>
+void ParallelSortSliced(Array& arr, size_t start, size_t end, Less less, unsigned threadCount = 0) {
+  if (end - start < 2)
+    return;
+
+  if (threadCount == 0)
+    threadCount = std::thread::hardware_concurrency();
+
+  unsigned extraThreads = (threadCount > 1) ? (threadCount - 1) : 0;
+  ParallelSortTask(
+      arr, (intptr_t)start, (intptr_t)end, less, IntroSortDepthBudget(end - start), extraThreads);
+}
+
+template <class Array>
+void ParallelSortSliced(Array& arr, size_t start, size_t end) {
+  typedef typename Array::ValueType ValueType;
+  ParallelSortSliced(arr, start, end, OperatorLess<ValueType>::Compare);
+}
+
+//-----------------------------------------------------------------------------------
+// ***** ParallelSort
+//
+// Sort an array Array, ArrayPaged, ArrayUnsafe.
+// The array must have GetSize() function.
+// The comparison predicate must be specified.
+template <class Array, class Less>
+void ParallelSort(Array& arr, Less less, unsigned threadCount = 0) {
+  ParallelSortSliced(arr, 0, arr.GetSize(), less, threadCount);
+}
+
+//-----------------------------------------------------------------------------------
+// ***** ParallelSort
+//
+// Sort an array Array, ArrayPaged, ArrayUnsafe.
+// The array must have GetSize() function.
+// The data type must have a defined "<" operator.
+template <class Array>
+void ParallelSort(Array& arr) {
+  typedef typename Array::ValueType ValueType;
+  ParallelSortSliced(arr, 0, arr.GetSize(), OperatorLess<ValueType>::Compare);
+}
+
+} // namespace Alg
+} // namespace OVR
+
+#endif // OVR_ParallelSort_h
@@ -25,6 +25,7 @@ limitations under the License.
 ************************************************************************************/
 
 #include "OVR_RefCount.h"
+#include "OVR_Alg.h"
 #include "OVR_Atomic.h"
 
 namespace OVR {
@@ -59,32 +60,72 @@ void RefCountNTSImplCore::reportInvalidDelete(void* /*pmem*/) {
 }
 #endif
 
-// *** Thread-Safe RefCountImpl
-
-void RefCountImpl::AddRef() {
-  RefCount.fetch_add(1, std::memory_order_relaxed);
-}
-void RefCountImpl::Release() {
-  if (RefCount.fetch_add(-1, std::memory_order_relaxed) - 1 == 0)
-    delete this;
-}
-
 // *** Thread-Safe RefCountVImpl w/virtual AddRef/Release
 
 void RefCountVImpl::AddRef() {
   RefCount.fetch_add(1, std::memory_order_relaxed);
 }
 void RefCountVImpl::Release() {
-  if (RefCount.fetch_add(-1, std::memory_order_relaxed) - 1 == 0)
+  // See RefCountImpl::Release for the ordering.
+  int oldCount = RefCount.fetch_sub(1, std::memory_order_acq_rel);
+  OVR_ASSERT(oldCount > 0);
+  if (oldCount == 1)
     delete this;
 }
 
-// *** NON-Thread-Safe RefCountImpl
+// ***** RefCountPool
+
+RefCountPool::RefCountPool(size_t elementSize)
+    : PoolLock(),
+      ElementSize(
+          (Alg::Max(elementSize, sizeof(FreeNode)) + ElementAlignment - 1) &
+          ~(size_t)(ElementAlignment - 1)),
+      pFreeList(nullptr),
+      pSlabCur(nullptr),
+      pSlabEnd(nullptr) {}
+
+void* RefCountPool::Alloc(size_t size) {
+  if (size > ElementSize)
+    return OVR_ALLOC(size);
+
+  Lock::Locker locker(&PoolLock);
+
+  if (pFreeList) {
+    FreeNode* node = pFreeList;
+    pFreeList = node->pNext;
+    return node;
+  }
+
+  if ((size_t)(pSlabEnd - pSlabCur) < ElementSize) {
+    // The rest of the old slab, if any, is too small for an element and is abandoned.
+    size_t slabSize = Alg::Max((size_t)SlabSize, ElementSize);
+    char* slab = static_cast<char*>(SafeMMapAlloc(slabSize));
+    if (!slab)
+      return nullptr;
+    pSlabCur = slab;
+    pSlabEnd = slab + slabSize;
+  }
+
+  void* p = pSlabCur;
+  pSlabCur += ElementSize;
+  return p;
+}
 
-void RefCountNTSImpl::Release() const {
-  RefCount--;
-  if (RefCount == 0)
-    delete this;
+void RefCountPool::Free(void* p, size_t size) {
+  if (size > ElementSize) {
+    OVR_FREE(p);
+    return;
+  }
+
+#ifdef OVR_BUILD_DEBUG
+  // Make use after free more likely to be noticed.
+  memset(p, 0xfe, ElementSize);
+#endif
+
+  FreeNode* node = static_cast<FreeNode*>(p);
+  Lock::Locker locker(&PoolLock);
+  node->pNext = pFreeList;
+  pFreeList = node;
 }
 
 } // namespace OVR
@@ -31,6 +31,8 @@ limitations under the License.
 #include "OVR_Allocator.h"
 #include "OVR_Types.h"
 
+#include <thread>
+
 namespace OVR {
 
 //-----------------------------------------------------------------------------------
@@ -38,8 +40,14 @@ namespace OVR {
 
 // There are three types of reference counting base classes:
 //
-//  RefCountBase     - Provides thread-safe reference counting (Default).
-//  RefCountBaseNTS  - Non Thread Safe version of reference counting.
+//  RefCountBase       - Provides thread-safe reference counting (Default).
+//  RefCountBaseNTS    - Non Thread Safe version of reference counting.
+//  RefCountBasePooled - Either of the above, allocated from a per-class RefCountPool.
+//
+// The counting itself is done by the RefCountImpl (atomic) and RefCountNTSImpl
+// (thread-confined) policies. Debug builds check that a thread-confined object is only
+// referenced from one thread, and that no object is released more times than it was
+// referenced.
 
 // ***** Declared classes
 
@@ -47,9 +55,12 @@ template <class C>
 class RefCountBase;
 template <class C>
 class RefCountBaseNTS;
+template <class C, class Impl>
+class RefCountBasePooled;
 
 class RefCountImpl;
 class RefCountNTSImpl;
+class RefCountPool;
 
 //-----------------------------------------------------------------------------------
 // ***** Implementation For Reference Counting
@@ -125,6 +136,32 @@ class RefCountNTSImplCore {
   OVR_FORCE_INLINE static void checkInvalidDelete(RefCountNTSImplCore*) {}
 #endif
 
+// The object belongs to the first thread which calls AddRef or Release on it, so it can be
+// created on one thread and handed off to another before it's used. Debug only.
+#ifdef OVR_BUILD_DEBUG
+ protected:
+  mutable std::thread::id OwnerThread;
+
+  OVR_FORCE_INLINE void checkOwnerThread() const {
+    std::thread::id current = std::this_thread::get_id();
+    if (OwnerThread == std::thread::id())
+      OwnerThread = current;
+    OVR_ASSERT(OwnerThread == current);
+  }
+
+ public:
+  // Lets another thread take over the object, after all use of it on this one is done.
+  void ResetOwnerThread() const {
+    OwnerThread = std::thread::id();
+  }
+#else
+ protected:
+  OVR_FORCE_INLINE void checkOwnerThread() const {}
+
+ public:
+  void ResetOwnerThread() const {}
+#endif
+
   // Base class ref-count content should not be copied.
   void operator=(const RefCountNTSImplCore&) {}
 };
@@ -135,8 +172,19 @@ class RefCountNTSImplCore {
 class RefCountImpl : public RefCountImplCore {
  public:
   // Thread-Safe Ref-Count Implementation.
-  void AddRef();
-  void Release();
+  // Taking a reference needs no ordering, as the caller already holds one. Dropping one
+  // releases this thread's writes to the object, and the last drop acquires everyone else's
+  // before the object is destroyed.
+  OVR_FORCE_INLINE void AddRef() {
+    RefCount.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  OVR_FORCE_INLINE void Release() {
+    int oldCount = RefCount.fetch_sub(1, std::memory_order_acq_rel);
+    OVR_ASSERT(oldCount > 0);
+    if (oldCount == 1)
+      delete this;
+  }
 };
 
 // RefCountVImpl provides Thread-Safe implementation of reference counting, plus,
@@ -155,10 +203,16 @@ class RefCountVImpl : virtual public RefCountImplCore {
 class RefCountNTSImpl : public RefCountNTSImplCore {
  public:
   OVR_FORCE_INLINE void AddRef() const {
+    checkOwnerThread();
     RefCount++;
   }
 
-  void Release() const;
+  OVR_FORCE_INLINE void Release() const {
+    checkOwnerThread();
+    OVR_ASSERT(RefCount > 0);
+    if (--RefCount == 0)
+      delete this;
+  }
 };
 
 // RefCountBaseStatImpl<> is a common class that adds new/delete override with Stat tracking
@@ -269,6 +323,104 @@ class RefCountBaseNTS : public RefCountBaseStatImpl<RefCountNTSImpl> {
   OVR_FORCE_INLINE RefCountBaseNTS() : RefCountBaseStatImpl<RefCountNTSImpl>() {}
 };
 
+//-----------------------------------------------------------------------------------
+// ***** RefCountPool
+//
+// Free list allocator for reference counted objects of one size. Memory comes from system
+// pages in slabs and is kept for reuse once objects are freed, rather than returned, so
+// creating and destroying objects costs a short locked list operation and the objects stay
+// close together in memory. Requests larger than the element size go to OVR_ALLOC.
+// Pooled objects aren't seen by the Allocator's leak tracking.
+
+class RefCountPool {
+ public:
+  // Elements are 16 byte aligned.
+  enum { SlabSize = 65536, ElementAlignment = 16 };
+
+  explicit RefCountPool(size_t elementSize);
+
+  // Returns null on failure.
+  void* Alloc(size_t size);
+
+  // size must be the one that was passed to Alloc.
+  void Free(void* p, size_t size);
+
+  size_t GetElementSize() const {
+    return ElementSize;
+  }
+
+ private:
+  struct FreeNode {
+    FreeNode* pNext;
+  };
+
+  Lock PoolLock;
+  size_t ElementSize;
+  FreeNode* pFreeList;
+  char* pSlabCur;
+  char* pSlabEnd;
+
+  OVR_NON_COPYABLE(RefCountPool);
+};
+
+// RefCountBasePooled is RefCountBase or RefCountBaseNTS, depending on the Impl policy, with
+// new and delete going to a pool shared by all objects of class C. It suits small objects
+// which are created and destroyed in large numbers, such as JSON nodes.
+//
+// Objects are freed with the sized delete, so classes derived from C are supported, but
+// larger ones are allocated with OVR_ALLOC.
+
+template <class C, class Impl = RefCountImpl>
+class RefCountBasePooled : public Impl {
+ public:
+  OVR_FORCE_INLINE RefCountBasePooled() : Impl() {}
+
+  // The pool is constructed on first use and never destroyed, so objects can be released
+  // from static destructors.
+  static RefCountPool& GetPool() {
+    static_assert(alignof(C) <= RefCountPool::ElementAlignment, "Pooled class is over-aligned");
+    alignas(RefCountPool) static char poolStorage[sizeof(RefCountPool)];
+    static RefCountPool* pool = new (poolStorage) RefCountPool(sizeof(C));
+    return *pool;
+  }
+
+// DOM-IGNORE-BEGIN
+// Undef new temporarily if it is being redefined
+#ifdef OVR_DEFINE_NEW
+#undef new
+#endif
+
+  void* operator new(size_t sz) {
+    void* p = GetPool().Alloc(sz);
+    if (!p)
+      throw OVR::bad_alloc();
+    return p;
+  }
+
+  void* operator new(size_t sz, const char* file, int line) {
+    OVR_UNUSED2(file, line);
+    return operator new(sz);
+  }
+
+  void operator delete(void* p, size_t sz) {
+    if (p) {
+      Impl::checkInvalidDelete((C*)p);
+      GetPool().Free(p, sz);
+    }
+  }
+
+  // Only called when a constructor throws, without the size, so this assumes a C.
+  void operator delete(void* p, const char*, int) {
+    if (p)
+      GetPool().Free(p, sizeof(C));
+  }
+
+#ifdef OVR_DEFINE_NEW
+#define new OVR_DEFINE_NEW
+#endif
+  // DOM-IGNORE-END
+};
+
 //-----------------------------------------------------------------------------------
 // ***** Ref-Counted template pointer
 //
@@ -316,6 +468,16 @@ class Ptr {
     pObject = src;
   }
 
+  // Moves take over the source's reference, leaving it null, with no reference count change.
+  OVR_FORCE_INLINE Ptr(Ptr<C>&& src) : pObject(src.pObject) {
+    src.pObject = 0;
+  }
+
+  template <class R>
+  OVR_FORCE_INLINE Ptr(Ptr<R>&& src) : pObject(src.GetPtr()) {
+    src.NullWithoutRelease();
+  }
+
   // Destructor
   OVR_FORCE_INLINE ~Ptr() {
     if (pObject)
@@ -366,6 +528,27 @@ class Ptr {
     return *this;
   }
 
+  template <class R>
+  OVR_FORCE_INLINE const Ptr<C>& operator=(Ptr<R>&& src) {
+    C* pold = pObject;
+    pObject = src.GetPtr();
+    src.NullWithoutRelease();
+    if (pold)
+      pold->Release();
+    return *this;
+  }
+
+  OVR_FORCE_INLINE const Ptr<C>& operator=(Ptr<C>&& src) {
+    if (this != &src) {
+      C* pold = pObject;
+      pObject = src.pObject;
+      src.pObject = 0;
+      if (pold)
+        pold->Release();
+    }
+    return *this;
+  }
+
   OVR_FORCE_INLINE const Ptr<C>& operator=(C* psrc) {
     if (psrc)
       psrc->AddRef();
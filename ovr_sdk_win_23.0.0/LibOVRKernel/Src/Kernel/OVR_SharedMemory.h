@@ -40,7 +40,7 @@ class SharedMemoryInternalBase; // Opaque
 
 // SharedMemory
 // Note: Safe when used between 32-bit and 64-bit processes
-class SharedMemory : public RefCountBase<SharedMemory> {
+class SharedMemory : public RefCountBasePooled<SharedMemory> {
   friend class SharedMemoryFactory;
 
   OVR_NON_COPYABLE(SharedMemory);
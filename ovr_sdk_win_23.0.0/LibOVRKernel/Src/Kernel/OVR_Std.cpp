@@ -51,27 +51,6 @@ const char* OVR_CDECL OVR_strrchr(const char* pString, int c) {
   return nullptr;
 }
 
-char* OVR_CDECL OVR_stristr(const char* s1, const char* s2) {
-  const char* cp = s1;
-
-  if (!*s2)
-    return (char*)s1;
-
-  while (*cp) {
-    const char* s = cp;
-    const char* t = s2;
-
-    while (*s && *t && (tolower((uint8_t)*s) == tolower((uint8_t)*t)))
-      ++s, ++t;
-
-    if (*t == 0)
-      return const_cast<char*>(cp);
-    ++cp;
-  }
-
-  return 0;
-}
-
 wchar_t* OVR_CDECL OVR_stristr(const wchar_t* s1, const wchar_t* s2) {
   const wchar_t* cp = s1;
 
@@ -173,33 +152,6 @@ size_t OVR_CDECL OVR_strlcat(wchar_t* dest, const wchar_t* src, size_t destsize)
   return t;
 }
 
-// Case insensitive compare implemented in platform-specific way.
-int OVR_CDECL OVR_stricmp(const char* a, const char* b) {
-#if defined(OVR_OS_MS)
-#if defined(OVR_CC_MSVC) && (OVR_CC_MSVC >= 1400)
-  return ::_stricmp(a, b);
-#else
-  return ::stricmp(a, b);
-#endif
-
-#else
-  return strcasecmp(a, b);
-#endif
-}
-
-int OVR_CDECL OVR_strnicmp(const char* a, const char* b, size_t count) {
-#if defined(OVR_OS_MS)
-#if defined(OVR_CC_MSVC) && (OVR_CC_MSVC >= 1400)
-  return ::_strnicmp(a, b, count);
-#else
-  return ::strnicmp(a, b, count);
-#endif
-
-#else
-  return strncasecmp(a, b, count);
-#endif
-}
-
 wchar_t* OVR_CDECL OVR_wcscpy(wchar_t* dest, size_t destsize, const wchar_t* src) {
 #if defined(OVR_MSVC_SAFESTRING)
   wcscpy_s(dest, destsize, src);
@@ -240,19 +240,29 @@ inline char* OVR_CDECL OVR_strrchr(char* pString, int c) {
   return (char*)OVR_strrchr((const char*)pString, c);
 }
 
-// Supports ASCII strings only, by calling tolower on each element.
+// Supports ASCII strings only, by calling OVR_tolower on each element.
+// Implemented in OVR_Std_SIMD.cpp.
 char* OVR_CDECL OVR_stristr(const char* s1, const char* s2);
 
 // Converts each element via towlower.
 wchar_t* OVR_CDECL OVR_stristr(const wchar_t* s1, const wchar_t* s2);
 
-inline const uint8_t* OVR_CDECL OVR_memrchr(const uint8_t* str, size_t size, uint8_t c) {
-  for (intptr_t i = (intptr_t)size - 1; i >= 0; i--) {
-    if (str[i] == c)
-      return str + i;
-  }
-  return 0;
-}
+// Returns a pointer to the last occurrence of c in the first size bytes of str, or NULL.
+// Implemented in OVR_Std_SIMD.cpp.
+const uint8_t* OVR_CDECL OVR_memrchr(const uint8_t* str, size_t size, uint8_t c);
+
+// Returns a pointer to the first occurrence of either c1 or c2 in the first size bytes of str,
+// or NULL. Implemented in OVR_Std_SIMD.cpp.
+const uint8_t* OVR_CDECL OVR_memchr2(const uint8_t* str, size_t size, uint8_t c1, uint8_t c2);
+
+// Returns the index of the first byte which differs between p1 and p2, or size if the
+// first size bytes are equal. Implemented in OVR_Std_SIMD.cpp.
+size_t OVR_CDECL OVR_memmismatch(const void* p1, const void* p2, size_t size);
+
+// Returns the number of leading chars of the first size chars of str which are 7-bit ASCII
+// (less than 0x80). 0 chars are counted as ASCII. Implemented in OVR_Std_SIMD.cpp.
+size_t OVR_CDECL OVR_asciispan(const char* str, size_t size);
+size_t OVR_CDECL OVR_asciispan(const wchar_t* str, size_t size);
 
 double OVR_CDECL OVR_strtod(const char* string, char** tailptr);
 
@@ -296,7 +306,8 @@ inline uint64_t OVR_CDECL OVR_atouq(const char* string) {
   return OVR_strtouq(string, NULL, 10);
 }
 
-// Implemented in OVR_Std.cpp in platform-specific manner.
+// ASCII case-insensitive compare. Returns the difference of the first pair of chars which
+// differ after OVR_tolower, like strcasecmp in the C locale. Implemented in OVR_Std_SIMD.cpp.
 int OVR_CDECL OVR_stricmp(const char* dest, const char* src);
 int OVR_CDECL OVR_strnicmp(const char* dest, const char* src, size_t count);
 
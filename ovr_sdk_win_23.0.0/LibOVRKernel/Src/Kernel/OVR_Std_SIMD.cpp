@@ -0,0 +1,723 @@
+/************************************************************************************
+
+Filename    :   OVR_Std_SIMD.cpp
+Content     :   SSE2/AVX2/NEON implementations of memory and ASCII string functions
+Created     :   October 18, 2026
+Notes       :   Each function has a scalar reference implementation, and the vector
+                implementations must return exactly what the scalar one returns.
+                The implementation is chosen on first use for the CPU dispatch tier
+                (see Util_CPUDispatch.h).
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+#include "OVR_Std.h"
+#include "OVR_Alg.h"
+#include "Util/Util_CPUDispatch.h"
+
+#if defined(OVR_CPU_X86) || defined(OVR_CPU_X86_64)
+#define OVR_STD_SIMD_X86
+#include <immintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define OVR_STD_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace OVR {
+
+// Unaligned loads of a vector of this many bytes at p won't touch the next memory page.
+// Used for 0-terminated strings, which may end just before an unmapped page.
+static inline bool CanLoadWithinPage(const void* p, size_t vectorSize) {
+  return ((uintptr_t)p & 4095) <= (4096 - vectorSize);
+}
+
+//-----------------------------------------------------------------------------------
+// ***** Scalar reference implementations
+
+static const uint8_t* OVR_CDECL MemrchrScalar(const uint8_t* str, size_t size, uint8_t c) {
+  for (intptr_t i = (intptr_t)size - 1; i >= 0; i--) {
+    if (str[i] == c)
+      return str + i;
+  }
+  return nullptr;
+}
+
+static const uint8_t* OVR_CDECL
+Memchr2Scalar(const uint8_t* str, size_t size, uint8_t c1, uint8_t c2) {
+  for (size_t i = 0; i < size; i++) {
+    if ((str[i] == c1) || (str[i] == c2))
+      return str + i;
+  }
+  return nullptr;
+}
+
+static size_t OVR_CDECL MemMismatchScalar(const void* p1, const void* p2, size_t size) {
+  const uint8_t* a = (const uint8_t*)p1;
+  const uint8_t* b = (const uint8_t*)p2;
+  size_t i = 0;
+  while ((i < size) && (a[i] == b[i]))
+    ++i;
+  return i;
+}
+
+static size_t OVR_CDECL AsciiSpanScalar(const char* str, size_t size) {
+  size_t i = 0;
+  while ((i < size) && ((uint8_t)str[i] < 0x80))
+    ++i;
+  return i;
+}
+
+static size_t OVR_CDECL WAsciiSpanScalar(const wchar_t* str, size_t size) {
+  size_t i = 0;
+  while ((i < size) && ((uint32_t)str[i] < 0x80))
+    ++i;
+  return i;
+}
+
+static int OVR_CDECL StrnicmpScalar(const char* a, const char* b, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    int ca = OVR_tolower((uint8_t)a[i]);
+    int cb = OVR_tolower((uint8_t)b[i]);
+    if ((ca != cb) || (ca == 0))
+      return ca - cb;
+  }
+  return 0;
+}
+
+static int OVR_CDECL StricmpScalar(const char* a, const char* b) {
+  return StrnicmpScalar(a, b, SIZE_MAX);
+}
+
+// Returns true if the first count chars of a and b are equal when ASCII case folded.
+static bool EqualFoldASCII(const char* a, const char* b, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    if (OVR_tolower((uint8_t)a[i]) != OVR_tolower((uint8_t)b[i]))
+      return false;
+  }
+  return true;
+}
+
+static const char*
+StristrTail(const char* s1, size_t pos, size_t end, const char* s2, size_t len2) {
+  for (; pos < end; ++pos) {
+    if (EqualFoldASCII(s1 + pos, s2, len2))
+      return s1 + pos;
+  }
+  return nullptr;
+}
+
+static char* OVR_CDECL StristrScalar(const char* s1, const char* s2) {
+  if (!*s2)
+    return (char*)s1;
+
+  const size_t len1 = strlen(s1);
+  const size_t len2 = strlen(s2);
+  if (len2 > len1)
+    return nullptr;
+
+  return (char*)StristrTail(s1, 0, len1 - len2 + 1, s2, len2);
+}
+
+#if defined(OVR_STD_SIMD_X86)
+
+//-----------------------------------------------------------------------------------
+// ***** SSE2 implementations
+
+// Returns v with the ASCII upper case letters converted to lower case.
+static inline __m128i FoldASCII_SSE2(__m128i v) {
+  // Bias 'A' to -128 so that a single signed compare finds 'A'..'Z'.
+  const __m128i biased = _mm_add_epi8(v, _mm_set1_epi8((char)(0x80 - 'A')));
+  const __m128i isUpper = _mm_cmplt_epi8(biased, _mm_set1_epi8((char)(-128 + 26)));
+  return _mm_or_si128(v, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+}
+
+static const uint8_t* OVR_CDECL MemrchrSSE2(const uint8_t* str, size_t size, uint8_t c) {
+  const __m128i needle = _mm_set1_epi8((char)c);
+  size_t i = size;
+
+  while (i >= 16) {
+    i -= 16;
+    const __m128i block = _mm_loadu_si128((const __m128i*)(str + i));
+    const uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(block, needle));
+    if (mask)
+      return str + i + (31 - Alg::CountLeading0Bits(mask));
+  }
+
+  return MemrchrScalar(str, i, c);
+}
+
+static const uint8_t* OVR_CDECL
+Memchr2SSE2(const uint8_t* str, size_t size, uint8_t c1, uint8_t c2) {
+  const __m128i needle1 = _mm_set1_epi8((char)c1);
+  const __m128i needle2 = _mm_set1_epi8((char)c2);
+  size_t i = 0;
+
+  for (; i + 16 <= size; i += 16) {
+    const __m128i block = _mm_loadu_si128((const __m128i*)(str + i));
+    const __m128i match =
+        _mm_or_si128(_mm_cmpeq_epi8(block, needle1), _mm_cmpeq_epi8(block, needle2));
+    const uint32_t mask = (uint32_t)_mm_movemask_epi8(match);
+    if (mask)
+      return str + i + Alg::CountTrailing0Bits(mask);
+  }
+
+  return Memchr2Scalar(str + i, size - i, c1, c2);
+}
+
+static size_t OVR_CDECL MemMismatchSSE2(const void* p1, const void* p2, size_t size) {
+  const uint8_t* a = (const uint8_t*)p1;
+  const uint8_t* b = (const uint8_t*)p2;
+  size_t i = 0;
+
+  for (; i + 16 <= size; i += 16) {
+    const __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+    const __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+    const uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(va, vb)) ^ 0xffffu;
+    if (mask)
+      return i + Alg::CountTrailing0Bits(mask);
+  }
+
+  return i + MemMismatchScalar(a + i, b + i, size - i);
+}
+
+static size_t OVR_CDECL AsciiSpanSSE2(const char* str, size_t size) {
+  size_t i = 0;
+
+  for (; i + 16 <= size; i += 16) {
+    // movemask collects the high bit of each byte, which is set for non-ASCII bytes.
+    const uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(str + i)));
+    if (mask)
+      return i + Alg::CountTrailing0Bits(mask);
+  }
+
+  return i + AsciiSpanScalar(str + i, size - i);
+}
+
+static size_t OVR_CDECL WAsciiSpanSSE2(const wchar_t* str, size_t size) {
+  const __m128i zero = _mm_setzero_si128();
+  const size_t perVector = 16 / sizeof(wchar_t);
+  size_t i = 0;
+
+  for (; i + perVector <= size; i += perVector) {
+    const __m128i v = _mm_loadu_si128((const __m128i*)(str + i));
+    uint32_t mask;
+    if (sizeof(wchar_t) == 2)
+      mask = (uint32_t)_mm_movemask_epi8(
+          _mm_cmpeq_epi16(_mm_and_si128(v, _mm_set1_epi16((short)0xff80)), zero));
+    else
+      mask = (uint32_t)_mm_movemask_epi8(
+          _mm_cmpeq_epi32(_mm_and_si128(v, _mm_set1_epi32((int)0xffffff80)), zero));
+    mask ^= 0xffffu;
+    if (mask)
+      return i + (Alg::CountTrailing0Bits(mask) / sizeof(wchar_t));
+  }
+
+  return i + WAsciiSpanScalar(str + i, size - i);
+}
+
+static int OVR_CDECL StrnicmpSSE2(const char* a, const char* b, size_t count) {
+  const __m128i zero = _mm_setzero_si128();
+
+  while (count >= 16) {
+    if (CanLoadWithinPage(a, 16) && CanLoadWithinPage(b, 16)) {
+      const __m128i va = _mm_loadu_si128((const __m128i*)a);
+      const __m128i vb = _mm_loadu_si128((const __m128i*)b);
+      const __m128i equal = _mm_cmpeq_epi8(FoldASCII_SSE2(va), FoldASCII_SSE2(vb));
+      const uint32_t stop = ((uint32_t)_mm_movemask_epi8(equal) ^ 0xffffu) |
+          (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(va, zero));
+      if (stop) {
+        const int i = Alg::CountTrailing0Bits(stop);
+        return OVR_tolower((uint8_t)a[i]) - OVR_tolower((uint8_t)b[i]);
+      }
+      a += 16;
+      b += 16;
+      count -= 16;
+    } else {
+      // Step a single char until the loads no longer straddle a page boundary.
+      const int ca = OVR_tolower((uint8_t)*a);
+      const int cb = OVR_tolower((uint8_t)*b);
+      if ((ca != cb) || (ca == 0))
+        return ca - cb;
+      ++a;
+      ++b;
+      --count;
+    }
+  }
+
+  return StrnicmpScalar(a, b, count);
+}
+
+static int OVR_CDECL StricmpSSE2(const char* a, const char* b) {
+  return StrnicmpSSE2(a, b, SIZE_MAX);
+}
+
+static char* OVR_CDECL StristrSSE2(const char* s1, const char* s2) {
+  if (!*s2)
+    return (char*)s1;
+
+  const size_t len1 = strlen(s1);
+  const size_t len2 = strlen(s2);
+  if (len2 > len1)
+    return nullptr;
+
+  // Candidate positions are those where both the first and the last chars of s2 match.
+  // Only candidates are compared in full, which skips most of s1 16 positions at a time.
+  const size_t end = len1 - len2 + 1;
+  const __m128i first = _mm_set1_epi8((char)OVR_tolower((uint8_t)s2[0]));
+  const __m128i last = _mm_set1_epi8((char)OVR_tolower((uint8_t)s2[len2 - 1]));
+  const size_t innerLen = (len2 > 2) ? (len2 - 2) : 0;
+  size_t pos = 0;
+
+  for (; pos + 16 <= end; pos += 16) {
+    const __m128i blockFirst = _mm_loadu_si128((const __m128i*)(s1 + pos));
+    const __m128i blockLast = _mm_loadu_si128((const __m128i*)(s1 + pos + len2 - 1));
+    uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_and_si128(
+        _mm_cmpeq_epi8(FoldASCII_SSE2(blockFirst), first),
+        _mm_cmpeq_epi8(FoldASCII_SSE2(blockLast), last)));
+
+    while (mask) {
+      const size_t candidate = pos + Alg::CountTrailing0Bits(mask);
+      if (EqualFoldASCII(s1 + candidate + 1, s2 + 1, innerLen))
+        return (char*)(s1 + candidate);
+      mask &= (mask - 1);
+    }
+  }
+
+  return (char*)StristrTail(s1, pos, end, s2, len2);
+}
+
+//-----------------------------------------------------------------------------------
+// ***** AVX2 implementations
+
+OVR_CPU_TARGET_AVX2 static inline __m256i FoldASCII_AVX2(__m256i v) {
+  const __m256i biased = _mm256_add_epi8(v, _mm256_set1_epi8((char)(0x80 - 'A')));
+  const __m256i isUpper = _mm256_cmpgt_epi8(_mm256_set1_epi8((char)(-128 + 26)), biased);
+  return _mm256_or_si256(v, _mm256_and_si256(isUpper, _mm256_set1_epi8(0x20)));
+}
+
+OVR_CPU_TARGET_AVX2 static const uint8_t* OVR_CDECL
+MemrchrAVX2(const uint8_t* str, size_t size, uint8_t c) {
+  const __m256i needle = _mm256_set1_epi8((char)c);
+  size_t i = size;
+
+  while (i >= 32) {
+    i -= 32;
+    const __m256i block = _mm256_loadu_si256((const __m256i*)(str + i));
+    const uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, needle));
+    if (mask)
+      return str + i + (31 - Alg::CountLeading0Bits(mask));
+  }
+
+  return MemrchrSSE2(str, i, c);
+}
+
+OVR_CPU_TARGET_AVX2 static const uint8_t* OVR_CDECL
+Memchr2AVX2(const uint8_t* str, size_t size, uint8_t c1, uint8_t c2) {
+  const __m256i needle1 = _mm256_set1_epi8((char)c1);
+  const __m256i needle2 = _mm256_set1_epi8((char)c2);
+  size_t i = 0;
+
+  for (; i + 32 <= size; i += 32) {
+    const __m256i block = _mm256_loadu_si256((const __m256i*)(str + i));
+    const __m256i match =
+        _mm256_or_si256(_mm256_cmpeq_epi8(block, needle1), _mm256_cmpeq_epi8(block, needle2));
+    const uint32_t mask = (uint32_t)_mm256_movemask_epi8(match);
+    if (mask)
+      return str + i + Alg::CountTrailing0Bits(mask);
+  }
+
+  return Memchr2SSE2(str + i, size - i, c1, c2);
+}
+
+OVR_CPU_TARGET_AVX2 static size_t OVR_CDECL
+MemMismatchAVX2(const void* p1, const void* p2, size_t size) {
+  const uint8_t* a = (const uint8_t*)p1;
+  const uint8_t* b = (const uint8_t*)p2;
+  size_t i = 0;
+
+  for (; i + 32 <= size; i += 32) {
+    const __m256i va = _mm256_loadu_si256((const __m256i*)(a + i));
+    const __m256i vb = _mm256_loadu_si256((const __m256i*)(b + i));
+    const uint32_t mask = ~(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb));
+    if (mask)
+      return i + Alg::CountTrailing0Bits(mask);
+  }
+
+  return i + MemMismatchSSE2(a + i, b + i, size - i);
+}
+
+OVR_CPU_TARGET_AVX2 static size_t OVR_CDECL AsciiSpanAVX2(const char* str, size_t size) {
+  size_t i = 0;
+
+  for (; i + 32 <= size; i += 32) {
+    const uint32_t mask =
+        (uint32_t)_mm256_movemask_epi8(_mm256_loadu_si256((const __m256i*)(str + i)));
+    if (mask)
+      return i + Alg::CountTrailing0Bits(mask);
+  }
+
+  return i + AsciiSpanSSE2(str + i, size - i);
+}
+
+OVR_CPU_TARGET_AVX2 static size_t OVR_CDECL WAsciiSpanAVX2(const wchar_t* str, size_t size) {
+  const __m256i zero = _mm256_setzero_si256();
+  const size_t perVector = 32 / sizeof(wchar_t);
+  size_t i = 0;
+
+  for (; i + perVector <= size; i += perVector) {
+    const __m256i v = _mm256_loadu_si256((const __m256i*)(str + i));
+    uint32_t mask;
+    if (sizeof(wchar_t) == 2)
+      mask = (uint32_t)_mm256_movemask_epi8(
+          _mm256_cmpeq_epi16(_mm256_and_si256(v, _mm256_set1_epi16((short)0xff80)), zero));
+    else
+      mask = (uint32_t)_mm256_movemask_epi8(
+          _mm256_cmpeq_epi32(_mm256_and_si256(v, _mm256_set1_epi32((int)0xffffff80)), zero));
+    mask = ~mask;
+    if (mask)
+      return i + (Alg::CountTrailing0Bits(mask) / sizeof(wchar_t));
+  }
+
+  return i + WAsciiSpanSSE2(str + i, size - i);
+}
+
+OVR_CPU_TARGET_AVX2 static int OVR_CDECL StrnicmpAVX2(const char* a, const char* b, size_t count) {
+  const __m256i zero = _mm256_setzero_si256();
+
+  while (count >= 32) {
+    if (CanLoadWithinPage(a, 32) && CanLoadWithinPage(b, 32)) {
+      const __m256i va = _mm256_loadu_si256((const __m256i*)a);
+      const __m256i vb = _mm256_loadu_si256((const __m256i*)b);
+      const __m256i equal = _mm256_cmpeq_epi8(FoldASCII_AVX2(va), FoldASCII_AVX2(vb));
+      const uint32_t stop = ~(uint32_t)_mm256_movemask_epi8(equal) |
+          (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, zero));
+      if (stop) {
+        const int i = Alg::CountTrailing0Bits(stop);
+        return OVR_tolower((uint8_t)a[i]) - OVR_tolower((uint8_t)b[i]);
+      }
+      a += 32;
+      b += 32;
+      count -= 32;
+    } else {
+      const int ca = OVR_tolower((uint8_t)*a);
+      const int cb = OVR_tolower((uint8_t)*b);
+      if ((ca != cb) || (ca == 0))
+        return ca - cb;
+      ++a;
+      ++b;
+      --count;
+    }
+  }
+
+  return StrnicmpSSE2(a, b, count);
+}
+
+OVR_CPU_TARGET_AVX2 static int OVR_CDECL StricmpAVX2(const char* a, const char* b) {
+  return StrnicmpAVX2(a, b, SIZE_MAX);
+}
+
+OVR_CPU_TARGET_AVX2 static char* OVR_CDECL StristrAVX2(const char* s1, const char* s2) {
+  if (!*s2)
+    return (char*)s1;
+
+  const size_t len1 = strlen(s1);
+  const size_t len2 = strlen(s2);
+  if (len2 > len1)
+    return nullptr;
+
+  const size_t end = len1 - len2 + 1;
+  const __m256i first = _mm256_set1_epi8((char)OVR_tolower((uint8_t)s2[0]));
+  const __m256i last = _mm256_set1_epi8((char)OVR_tolower((uint8_t)s2[len2 - 1]));
+  const size_t innerLen = (len2 > 2) ? (len2 - 2) : 0;
+  size_t pos = 0;
+
+  for (; pos + 32 <= end; pos += 32) {
+    const __m256i blockFirst = _mm256_loadu_si256((const __m256i*)(s1 + pos));
+    const __m256i blockLast = _mm256_loadu_si256((const __m256i*)(s1 + pos + len2 - 1));
+    uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_and_si256(
+        _mm256_cmpeq_epi8(FoldASCII_AVX2(blockFirst), first),
+        _mm256_cmpeq_epi8(FoldASCII_AVX2(blockLast), last)));
+
+    while (mask) {
+      const size_t candidate = pos + Alg::CountTrailing0Bits(mask);
+      if (EqualFoldASCII(s1 + candidate + 1, s2 + 1, innerLen))
+        return (char*)(s1 + candidate);
+      mask &= (mask - 1);
+    }
+  }
+
+  return (char*)StristrTail(s1, pos, end, s2, len2);
+}
+
+#elif defined(OVR_STD_SIMD_NEON)
+
+//-----------------------------------------------------------------------------------
+// ***** NEON implementations
+
+// Returns a 16 bit mask with bit i set if byte i of v (which must be 0x00 or 0xff) is set,
+// like SSE2's _mm_movemask_epi8.
+static inline uint32_t MoveMaskNEON(uint8x16_t v) {
+  static const uint8_t bitWeights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  const uint8x16_t bits = vandq_u8(v, vld1q_u8(bitWeights));
+  return (uint32_t)vaddv_u8(vget_low_u8(bits)) | ((uint32_t)vaddv_u8(vget_high_u8(bits)) << 8);
+}
+
+static inline uint8x16_t FoldASCII_NEON(uint8x16_t v) {
+  const uint8x16_t isUpper = vcltq_u8(vsubq_u8(v, vdupq_n_u8('A')), vdupq_n_u8(26));
+  return vorrq_u8(v, vandq_u8(isUpper, vdupq_n_u8(0x20)));
+}
+
+static const uint8_t* OVR_CDECL MemrchrNEON(const uint8_t* str, size_t size, uint8_t c) {
+  const uint8x16_t needle = vdupq_n_u8(c);
+  size_t i = size;
+
+  while (i >= 16) {
+    i -= 16;
+    const uint32_t mask = MoveMaskNEON(vceqq_u8(vld1q_u8(str + i), needle));
+    if (mask)
+      return str + i + (31 - Alg::CountLeading0Bits(mask));
+  }
+
+  return MemrchrScalar(str, i, c);
+}
+
+static const uint8_t* OVR_CDECL
+Memchr2NEON(const uint8_t* str, size_t size, uint8_t c1, uint8_t c2) {
+  const uint8x16_t needle1 = vdupq_n_u8(c1);
+  const uint8x16_t needle2 = vdupq_n_u8(c2);
+  size_t i = 0;
+
+  for (; i + 16 <= size; i += 16) {
+    const uint8x16_t block = vld1q_u8(str + i);
+    const uint8x16_t match = vorrq_u8(vceqq_u8(block, needle1), vceqq_u8(block, needle2));
+    if (vmaxvq_u8(match))
+      break; // The scalar loop below finds the exact position.
+  }
+
+  return Memchr2Scalar(str + i, size - i, c1, c2);
+}
+
+static size_t OVR_CDECL MemMismatchNEON(const void* p1, const void* p2, size_t size) {
+  const uint8_t* a = (const uint8_t*)p1;
+  const uint8_t* b = (const uint8_t*)p2;
+  size_t i = 0;
+
+  for (; i + 16 <= size; i += 16) {
+    const uint32_t mask = MoveMaskNEON(vceqq_u8(vld1q_u8(a + i), vld1q_u8(b + i))) ^ 0xffffu;
+    if (mask)
+      return i + Alg::CountTrailing0Bits(mask);
+  }
+
+  return i + MemMismatchScalar(a + i, b + i, size - i);
+}
+
+static size_t OVR_CDECL AsciiSpanNEON(const char* str, size_t size) {
+  size_t i = 0;
+
+  for (; i + 16 <= size; i += 16) {
+    if (vmaxvq_u8(vld1q_u8((const uint8_t*)(str + i))) >= 0x80)
+      break; // The scalar loop below finds the exact position.
+  }
+
+  return i + AsciiSpanScalar(str + i, size - i);
+}
+
+static size_t OVR_CDECL WAsciiSpanNEON(const wchar_t* str, size_t size) {
+  const size_t perVector = 16 / sizeof(wchar_t);
+  size_t i = 0;
+
+  for (; i + perVector <= size; i += perVector) {
+    const uint32_t maxValue = (sizeof(wchar_t) == 2)
+        ? (uint32_t)vmaxvq_u16(vld1q_u16((const uint16_t*)(str + i)))
+        : vmaxvq_u32(vld1q_u32((const uint32_t*)(str + i)));
+    if (maxValue >= 0x80)
+      break;
+  }
+
+  return i + WAsciiSpanScalar(str + i, size - i);
+}
+
+static int OVR_CDECL StrnicmpNEON(const char* a, const char* b, size_t count) {
+  while (count >= 16) {
+    if (CanLoadWithinPage(a, 16) && CanLoadWithinPage(b, 16)) {
+      const uint8x16_t va = vld1q_u8((const uint8_t*)a);
+      const uint8x16_t vb = vld1q_u8((const uint8_t*)b);
+      const uint8x16_t equal = vceqq_u8(FoldASCII_NEON(va), FoldASCII_NEON(vb));
+      const uint32_t stop =
+          (MoveMaskNEON(equal) ^ 0xffffu) | MoveMaskNEON(vceqq_u8(va, vdupq_n_u8(0)));
+      if (stop) {
+        const int i = Alg::CountTrailing0Bits(stop);
+        return OVR_tolower((uint8_t)a[i]) - OVR_tolower((uint8_t)b[i]);
+      }
+      a += 16;
+      b += 16;
+      count -= 16;
+    } else {
+      const int ca = OVR_tolower((uint8_t)*a);
+      const int cb = OVR_tolower((uint8_t)*b);
+      if ((ca != cb) || (ca == 0))
+        return ca - cb;
+      ++a;
+      ++b;
+      --count;
+    }
+  }
+
+  return StrnicmpScalar(a, b, count);
+}
+
+static int OVR_CDECL StricmpNEON(const char* a, const char* b) {
+  return StrnicmpNEON(a, b, SIZE_MAX);
+}
+
+static char* OVR_CDECL StristrNEON(const char* s1, const char* s2) {
+  if (!*s2)
+    return (char*)s1;
+
+  const size_t len1 = strlen(s1);
+  const size_t len2 = strlen(s2);
+  if (len2 > len1)
+    return nullptr;
+
+  const size_t end = len1 - len2 + 1;
+  const uint8x16_t first = vdupq_n_u8((uint8_t)OVR_tolower((uint8_t)s2[0]));
+  const uint8x16_t last = vdupq_n_u8((uint8_t)OVR_tolower((uint8_t)s2[len2 - 1]));
+  const size_t innerLen = (len2 > 2) ? (len2 - 2) : 0;
+  size_t pos = 0;
+
+  for (; pos + 16 <= end; pos += 16) {
+    const uint8x16_t blockFirst = vld1q_u8((const uint8_t*)(s1 + pos));
+    const uint8x16_t blockLast = vld1q_u8((const uint8_t*)(s1 + pos + len2 - 1));
+    uint32_t mask = MoveMaskNEON(vandq_u8(
+        vceqq_u8(FoldASCII_NEON(blockFirst), first), vceqq_u8(FoldASCII_NEON(blockLast), last)));
+
+    while (mask) {
+      const size_t candidate = pos + Alg::CountTrailing0Bits(mask);
+      if (EqualFoldASCII(s1 + candidate + 1, s2 + 1, innerLen))
+        return (char*)(s1 + candidate);
+      mask &= (mask - 1);
+    }
+  }
+
+  return (char*)StristrTail(s1, pos, end, s2, len2);
+}
+
+#endif // OVR_STD_SIMD_NEON
+
+//-----------------------------------------------------------------------------------
+// ***** Dispatch
+
+struct StdKernelTable {
+  const uint8_t*(OVR_CDECL* Memrchr)(const uint8_t* str, size_t size, uint8_t c);
+  const uint8_t*(OVR_CDECL* Memchr2)(const uint8_t* str, size_t size, uint8_t c1, uint8_t c2);
+  size_t(OVR_CDECL* MemMismatch)(const void* p1, const void* p2, size_t size);
+  size_t(OVR_CDECL* AsciiSpan)(const char* str, size_t size);
+  size_t(OVR_CDECL* WAsciiSpan)(const wchar_t* str, size_t size);
+  int(OVR_CDECL* Stricmp)(const char* a, const char* b);
+  int(OVR_CDECL* Strnicmp)(const char* a, const char* b, size_t count);
+  char*(OVR_CDECL* Stristr)(const char* s1, const char* s2);
+};
+
+static StdKernelTable SelectStdKernels(Util::CPUDispatchTier tier) {
+  StdKernelTable table = {MemrchrScalar,
+                           Memchr2Scalar,
+                           MemMismatchScalar,
+                           AsciiSpanScalar,
+                           WAsciiSpanScalar,
+                           StricmpScalar,
+                           StrnicmpScalar,
+                           StristrScalar};
+
+#if defined(OVR_STD_SIMD_X86)
+  if (Util::CPUDispatchTierIncludes(tier, Util::CPUDispatchTier::AVX2)) {
+    table.Memrchr = MemrchrAVX2;
+    table.Memchr2 = Memchr2AVX2;
+    table.MemMismatch = MemMismatchAVX2;
+    table.AsciiSpan = AsciiSpanAVX2;
+    table.WAsciiSpan = WAsciiSpanAVX2;
+    table.Stricmp = StricmpAVX2;
+    table.Strnicmp = StrnicmpAVX2;
+    table.Stristr = StristrAVX2;
+  } else if (Util::CPUDispatchTierIncludes(tier, Util::CPUDispatchTier::SSE2)) {
+    table.Memrchr = MemrchrSSE2;
+    table.Memchr2 = Memchr2SSE2;
+    table.MemMismatch = MemMismatchSSE2;
+    table.AsciiSpan = AsciiSpanSSE2;
+    table.WAsciiSpan = WAsciiSpanSSE2;
+    table.Stricmp = StricmpSSE2;
+    table.Strnicmp = StrnicmpSSE2;
+    table.Stristr = StristrSSE2;
+  }
+#elif defined(OVR_STD_SIMD_NEON)
+  if (Util::CPUDispatchTierIncludes(tier, Util::CPUDispatchTier::NEON)) {
+    table.Memrchr = MemrchrNEON;
+    table.Memchr2 = Memchr2NEON;
+    table.MemMismatch = MemMismatchNEON;
+    table.AsciiSpan = AsciiSpanNEON;
+    table.WAsciiSpan = WAsciiSpanNEON;
+    table.Stricmp = StricmpNEON;
+    table.Strnicmp = StrnicmpNEON;
+    table.Stristr = StristrNEON;
+  }
+#endif
+
+  return table;
+}
+
+static const StdKernelTable& GetStdKernels() {
+  static Util::CPUDispatchTable<StdKernelTable> table(SelectStdKernels);
+  return table.Get();
+}
+
+//-----------------------------------------------------------------------------------
+// ***** Public functions
+
+const uint8_t* OVR_CDECL OVR_memrchr(const uint8_t* str, size_t size, uint8_t c) {
+  return GetStdKernels().Memrchr(str, size, c);
+}
+
+const uint8_t* OVR_CDECL OVR_memchr2(const uint8_t* str, size_t size, uint8_t c1, uint8_t c2) {
+  return GetStdKernels().Memchr2(str, size, c1, c2);
+}
+
+size_t OVR_CDECL OVR_memmismatch(const void* p1, const void* p2, size_t size) {
+  return GetStdKernels().MemMismatch(p1, p2, size);
+}
+
+size_t OVR_CDECL OVR_asciispan(const char* str, size_t size) {
+  return GetStdKernels().AsciiSpan(str, size);
+}
+
+size_t OVR_CDECL OVR_asciispan(const wchar_t* str, size_t size) {
+  return GetStdKernels().WAsciiSpan(str, size);
+}
+
+int OVR_CDECL OVR_stricmp(const char* a, const char* b) {
+  return GetStdKernels().Stricmp(a, b);
+}
+
+int OVR_CDECL OVR_strnicmp(const char* a, const char* b, size_t count) {
+  return GetStdKernels().Strnicmp(a, b, count);
+}
+
+char* OVR_CDECL OVR_stristr(const char* s1, const char* s2) {
+  return GetStdKernels().Stristr(s1, s2);
+}
+
+} // namespace OVR
@@ -41,8 +41,12 @@ static size_t GetEncodeStringSize(const wchar_t* pchar, size_t length = StringIs
       len += UTF8Util::GetEncodeCharSize(pchar[i]);
     }
   } else {
-    for (size_t i = 0; i < length; ++i) {
-      len += UTF8Util::GetEncodeCharSize(pchar[i]);
+    for (size_t i = 0; i < length;) {
+      const size_t asciiCount = OVR_asciispan(pchar + i, length - i);
+      len += asciiCount;
+      i += asciiCount;
+      if (i < length)
+        len += UTF8Util::GetEncodeCharSize(pchar[i++]);
     }
   }
   return len;
@@ -289,29 +293,42 @@ size_t StringBuffer::InsertCharAt(uint32_t c, size_t posAt) {
   return (size_t)len;
 }
 
-std::string StringVsprintf(const char* format, va_list args) {
-  char buffer[512]; // We first try writing into this buffer. If it's not enough then use a string.
+// Formats into a stack buffer, so that in the common case there is a single vsnprintf call
+// and only the bytes written are appended. Output which doesn't fit is formatted again,
+// straight into the end of s. s is left unmodified if the format is invalid.
+static void AppendVsprintf(std::string& s, const char* format, va_list args) {
+  char buffer[512];
 
   va_list tmp_args;
   va_copy(tmp_args, args);
   const int requiredStrlen = vsnprintf(buffer, sizeof(buffer), format, tmp_args);
   va_end(tmp_args);
 
-  if (requiredStrlen <
-      static_cast<int>(sizeof(buffer))) { // If the entire result fits into the buffer.
-    return std::string(buffer, requiredStrlen);
-  }
+  if (requiredStrlen < 0) // If there was a printf format error...
+    return;
 
-  std::string result(requiredStrlen, '\0');
-  std::vsnprintf(&result[0], result.size(), format, args);
+  if ((size_t)requiredStrlen < sizeof(buffer)) {
+    s.append(buffer, (size_t)requiredStrlen);
+  } else {
+    // The string's own terminating null provides the space for the one vsnprintf writes.
+    const size_t origSize = s.size();
+    s.resize(origSize + (size_t)requiredStrlen);
+    va_copy(tmp_args, args);
+    vsnprintf(&s[origSize], (size_t)requiredStrlen + 1, format, tmp_args);
+    va_end(tmp_args);
+  }
+}
 
+std::string StringVsprintf(const char* format, va_list args) {
+  std::string result;
+  AppendVsprintf(result, format, args);
   return result;
 }
 
 std::string& AppendSprintf(std::string& s, const char* format, ...) {
   va_list args;
   va_start(args, format);
-  s += StringVsprintf(format, args);
+  AppendVsprintf(s, format, args);
   va_end(args);
   return s;
 }
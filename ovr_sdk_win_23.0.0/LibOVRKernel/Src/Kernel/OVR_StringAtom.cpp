@@ -0,0 +1,184 @@
+/************************************************************************************
+
+Filename    :   OVR_StringAtom.cpp
+Content     :   Interned strings with O(1) comparison and precomputed hashes
+Created     :   October 18, 2026
+Notes       :   The intern table is a fixed array of buckets, each a singly-linked list
+                of entries which is only ever pushed to at the front with a CAS. Entries
+                are never removed, so readers need no synchronization beyond acquire loads.
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+#include "OVR_StringAtom.h"
+#include "OVR_Allocator.h"
+
+#include <stddef.h>
+#include <string.h>
+#include <atomic>
+
+namespace OVR {
+
+// String::BernsteinHashFunction of the empty string is its seed.
+const StringAtomEntry StringAtom::EmptyEntry = {nullptr, 5381, 0, {0}};
+
+//-----------------------------------------------------------------------------------
+// ***** Intern table storage
+//
+// Entries are bump-allocated from chunks of mapped memory rather than from the OVR heap, so
+// that the intern table works before the Allocator is initialized and its never-freed
+// entries don't show up in leak reports. All of the state here is zero-initialized, so it's
+// usable during static initialization.
+
+namespace {
+
+enum {
+  AtomBucketCount = 4096, // Power of two.
+  AtomChunkSize = 65536
+};
+
+struct AtomChunk {
+  std::atomic<size_t> Used; // Including this header.
+};
+
+std::atomic<const StringAtomEntry*> AtomBuckets[AtomBucketCount];
+std::atomic<AtomChunk*> AtomCurrentChunk;
+
+size_t AtomChunkHeaderSize() {
+  return (sizeof(AtomChunk) + (sizeof(void*) - 1)) & ~(sizeof(void*) - 1);
+}
+
+StringAtomEntry* AllocAtomEntry(size_t stringSize) {
+  const size_t entrySize =
+      (offsetof(StringAtomEntry, Data) + stringSize + 1 + (sizeof(void*) - 1)) &
+      ~(sizeof(void*) - 1);
+
+  // Strings too large to share a chunk get a mapping of their own.
+  if (entrySize > (AtomChunkSize - AtomChunkHeaderSize()) / 4)
+    return (StringAtomEntry*)SafeMMapAlloc(entrySize);
+
+  for (;;) {
+    AtomChunk* chunk = AtomCurrentChunk.load(std::memory_order_acquire);
+
+    if (chunk) {
+      const size_t offset = chunk->Used.fetch_add(entrySize, std::memory_order_relaxed);
+      if ((offset + entrySize) <= AtomChunkSize)
+        return (StringAtomEntry*)((char*)chunk + offset);
+    }
+
+    // The chunk is full (or there is none yet). Install a new one with our entry already
+    // taken from it. If another thread installs one first, give ours back and use theirs.
+    AtomChunk* newChunk = (AtomChunk*)SafeMMapAlloc(AtomChunkSize);
+    OVR_ASSERT(newChunk != nullptr);
+    if (!newChunk)
+      return nullptr;
+
+    const size_t offset = AtomChunkHeaderSize();
+    newChunk->Used.store(offset + entrySize, std::memory_order_relaxed); // Memory is 0-filled.
+
+    if (AtomCurrentChunk.compare_exchange_strong(chunk, newChunk, std::memory_order_acq_rel))
+      return (StringAtomEntry*)((char*)newChunk + offset);
+
+    SafeMMapFree(newChunk, AtomChunkSize);
+  }
+}
+
+std::atomic<const StringAtomEntry*>& GetAtomBucket(size_t hash) {
+  // The Bernstein hash is weak in its low bits for short strings, so mix in the high bits.
+  hash ^= (hash >> 15) ^ (hash >> 27);
+  return AtomBuckets[hash & (AtomBucketCount - 1)];
+}
+
+// Returns the entry for the string in the list starting at head, or nullptr.
+const StringAtomEntry*
+FindAtomEntry(const StringAtomEntry* head, const char* str, size_t size, size_t hash) {
+  for (const StringAtomEntry* entry = head; entry; entry = entry->pNext) {
+    if ((entry->Hash == hash) && (entry->Size == size) && (memcmp(entry->Data, str, size) == 0))
+      return entry;
+  }
+  return nullptr;
+}
+
+} // namespace
+
+//-----------------------------------------------------------------------------------
+// ***** StringAtom
+
+const StringAtomEntry* StringAtom::Intern(const char* str, size_t size) {
+  if (!str)
+    return &EmptyEntry;
+  if (size == StringIsNullTerminated)
+    size = OVR_strlen(str);
+  if (size == 0)
+    return &EmptyEntry;
+
+  const size_t hash = String::BernsteinHashFunction(str, size);
+  std::atomic<const StringAtomEntry*>& bucket = GetAtomBucket(hash);
+
+  const StringAtomEntry* head = bucket.load(std::memory_order_acquire);
+  const StringAtomEntry* found = FindAtomEntry(head, str, size, hash);
+  if (found)
+    return found;
+
+  StringAtomEntry* entry = AllocAtomEntry(size);
+  if (!entry)
+    return &EmptyEntry;
+
+  entry->Hash = hash;
+  entry->Size = size;
+  memcpy(entry->Data, str, size);
+  entry->Data[size] = 0;
+
+  for (;;) {
+    entry->pNext = head;
+    if (bucket.compare_exchange_weak(
+            head, entry, std::memory_order_release, std::memory_order_acquire))
+      return entry;
+
+    // Another thread pushed to this bucket first. Only the entries it added need to be
+    // checked, since the ones from head on were already searched. If it added the same
+    // string, ours is left unused in the chunk, which is rare enough not to matter.
+    for (const StringAtomEntry* e = head; e && (e != entry->pNext); e = e->pNext) {
+      if ((e->Hash == hash) && (e->Size == size) && (memcmp(e->Data, str, size) == 0))
+        return e;
+    }
+  }
+}
+
+bool StringAtom::TryFind(const char* str, size_t size, StringAtom& atom) {
+  if (!str)
+    return false;
+  if (size == StringIsNullTerminated)
+    size = OVR_strlen(str);
+  if (size == 0) {
+    atom.pEntry = &EmptyEntry;
+    return true;
+  }
+
+  const size_t hash = String::BernsteinHashFunction(str, size);
+  const StringAtomEntry* found =
+      FindAtomEntry(GetAtomBucket(hash).load(std::memory_order_acquire), str, size, hash);
+  if (!found)
+    return false;
+
+  atom.pEntry = found;
+  return true;
+}
+
+} // namespace OVR
@@ -0,0 +1,141 @@
+/************************************************************************************
+
+Filename    :   OVR_StringAtom.h
+Content     :   Interned strings with O(1) comparison and precomputed hashes
+Created     :   October 18, 2026
+Notes       :
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+#ifndef OVR_StringAtom_h
+#define OVR_StringAtom_h
+
+#include "OVR_Hash.h"
+#include "OVR_String.h"
+#include "OVR_Types.h"
+
+namespace OVR {
+
+//-----------------------------------------------------------------------------------
+// ***** StringAtomEntry
+//
+// The interned copy of a string. Entries are created by StringAtom and live until the process
+// exits; they are never modified after being published.
+
+struct StringAtomEntry {
+  const StringAtomEntry* pNext; // Next entry in the same intern table bucket.
+  size_t Hash; // String::BernsteinHashFunction of the string.
+  size_t Size; // Length in bytes, not including the terminating null.
+  char Data[1]; // Null-terminated; the entry is allocated with room for the whole string.
+};
+
+//-----------------------------------------------------------------------------------
+// ***** StringAtom
+//
+// A handle to a string in the global intern table. All atoms made from equal strings refer
+// to the same entry, so atoms compare equal with a single pointer compare, and their hash is
+// computed once when the string is interned. This makes them good keys for name lookups that
+// happen often, such as per-frame lookups, where the name can be interned once up front.
+//
+// Interning (constructing from a string) is a hash table lookup, and inserts the string if
+// it's not already present. It's lock-free and safe to call from any thread, including
+// during static initialization. Interned strings are never freed, so atoms should be made
+// from names and other strings drawn from a bounded set, not from arbitrary data.
+//
+// The default atom is the empty string. Atoms are compared case-sensitively, so they don't
+// suit names which are looked up case-insensitively, such as SettingsManager paths.
+//
+// Example usage:
+//     static const StringAtom kTrackingName("Tracking");
+//     Hash<StringAtom, int> counters;
+//     counters.Set(kTrackingName, 1);    // Hashing and comparing kTrackingName is O(1).
+
+class StringAtom {
+ public:
+  StringAtom() : pEntry(&EmptyEntry) {}
+  explicit StringAtom(const char* str) : pEntry(Intern(str, StringIsNullTerminated)) {}
+  StringAtom(const char* str, size_t size) : pEntry(Intern(str, size)) {}
+  explicit StringAtom(const std::string& str) : pEntry(Intern(str.data(), str.size())) {}
+
+  // Looks up an already interned string without inserting it. Returns true and sets atom if
+  // it was found. Useful for looking up keys from untrusted or unbounded input.
+  static bool TryFind(const char* str, size_t size, StringAtom& atom);
+  static bool TryFind(const char* str, StringAtom& atom) {
+    return TryFind(str, StringIsNullTerminated, atom);
+  }
+
+  const char* ToCStr() const {
+    return pEntry->Data;
+  }
+
+  String ToString() const {
+    return String(pEntry->Data, pEntry->Size);
+  }
+
+  // Byte length.
+  size_t GetSize() const {
+    return pEntry->Size;
+  }
+
+  bool IsEmpty() const {
+    return pEntry->Size == 0;
+  }
+
+  // The same value as String::HashFunctor returns for the string.
+  size_t GetHash() const {
+    return pEntry->Hash;
+  }
+
+  bool operator==(const StringAtom& other) const {
+    return pEntry == other.pEntry;
+  }
+
+  bool operator!=(const StringAtom& other) const {
+    return pEntry != other.pEntry;
+  }
+
+  // Lexicographic order, for sorting. This compares the strings, so it's not O(1).
+  bool operator<(const StringAtom& other) const {
+    return (pEntry != other.pEntry) && (OVR_strcmp(pEntry->Data, other.pEntry->Data) < 0);
+  }
+
+  // Hash functor used for atoms; returns the precomputed hash.
+  struct HashFunctor {
+    size_t operator()(const StringAtom& atom) const {
+      return atom.GetHash();
+    }
+  };
+
+ private:
+  static const StringAtomEntry* Intern(const char* str, size_t size);
+
+  static const StringAtomEntry EmptyEntry;
+
+  const StringAtomEntry* pEntry;
+};
+
+// Hash<StringAtom, U> and HashSet<StringAtom> use the atom's precomputed hash rather than
+// hashing the bytes of the handle, and look up keys with pointer compares.
+template <>
+class FixedSizeHash<StringAtom> : public StringAtom::HashFunctor {};
+
+} // namespace OVR
+
+#endif // OVR_StringAtom_h
@@ -29,43 +29,35 @@ limitations under the License.
 
 namespace OVR {
 
+// Formats directly into the end of the buffer, so the common case is a single vsnprintf call
+// with no intermediate buffer or copy.
 void StringBuffer::AppendFormatV(const char* format, va_list argList) {
-  char buffer[512];
-  char* bufferUsed = buffer;
-  char* bufferAllocated = NULL;
+  const size_t origSize = Size;
+  Reserve(origSize + 511);
+  OVR_ASSERT(pData != NULL);
 
   va_list argListSaved;
   va_copy(argListSaved, argList);
+  int requiredStrlen = vsnprintf(pData + origSize, BufferSize - origSize, format, argListSaved);
+  va_end(argListSaved);
 
-  int requiredStrlen = vsnprintf(
-      bufferUsed,
-      OVR_ARRAY_COUNT(buffer),
-      format,
-      argListSaved); // The large majority of the time this will succeed.
-
-  if (requiredStrlen >= (int)sizeof(buffer)) // If the initial capacity wasn't enough...
-  {
-    bufferAllocated = (char*)OVR_ALLOC(sizeof(char) * (requiredStrlen + 1));
-    bufferUsed = bufferAllocated;
-    if (bufferAllocated) {
-      va_end(argListSaved);
-      va_copy(argListSaved, argList);
-      requiredStrlen = vsnprintf(bufferAllocated, (requiredStrlen + 1), format, argListSaved);
-    }
+  if ((requiredStrlen >= 0) && ((size_t)requiredStrlen >= (BufferSize - origSize))) {
+    // If the initial capacity wasn't enough...
+    Reserve(origSize + (size_t)requiredStrlen);
+    va_copy(argListSaved, argList);
+    requiredStrlen =
+        vsnprintf(pData + origSize, (size_t)requiredStrlen + 1, format, argListSaved);
+    va_end(argListSaved);
   }
 
-  if (requiredStrlen < 0) // If there was a printf format error...
-  {
-    bufferUsed = NULL;
+  if (requiredStrlen < 0) { // If there was a printf format error...
+    pData[origSize] = 0;
+    return;
   }
 
-  va_end(argListSaved);
-
-  if (bufferUsed)
-    AppendString(bufferUsed);
-
-  if (bufferAllocated)
-    OVR_FREE(bufferAllocated);
+  LengthIsSize = false;
+  Size = origSize + (size_t)requiredStrlen;
+  pData[Size] = 0;
 }
 
 void StringBuffer::AppendFormat(const char* format, ...) {
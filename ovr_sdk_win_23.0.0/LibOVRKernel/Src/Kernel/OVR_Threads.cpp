@@ -0,0 +1,414 @@
+/************************************************************************************
+
+Filename    :   OVR_Threads.cpp
+Content     :   Platform independent thread functions
+Created     :   October 18, 2026
+Notes       :
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+
+#include "OVR_Threads.h"
+
+#ifdef OVR_ENABLE_THREADS
+
+#include "Logging/Logging_Library.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+
+#if defined(OVR_OS_LINUX) || defined(OVR_OS_ANDROID)
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#define OVR_FUTEX_AVAILABLE
+#endif
+
+namespace OVR {
+
+//-----------------------------------------------------------------------------------
+// ***** Futex
+//
+// FutexWait blocks while *address is expected, until FutexWakeAll(address) is called or delay
+// milliseconds pass. It can return spuriously, so callers recheck their condition.
+// FutexWakeAll must be called after the value is changed.
+
+#if defined(OVR_FUTEX_AVAILABLE)
+
+static void FutexWait(std::atomic<uint32_t>* address, uint32_t expected, unsigned delay) {
+  static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "Futex word size");
+  timespec timeout;
+  timespec* pTimeout = nullptr;
+  if (delay != OVR_WAIT_INFINITE) {
+    timeout.tv_sec = delay / 1000;
+    timeout.tv_nsec = (long)(delay % 1000) * 1000000;
+    pTimeout = &timeout;
+  }
+  syscall(SYS_futex, address, FUTEX_WAIT_PRIVATE, expected, pTimeout, nullptr, 0);
+}
+
+static void FutexWakeAll(std::atomic<uint32_t>* address) {
+  syscall(SYS_futex, address, FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+}
+
+#else
+
+// Emulated with condition variables shared by addresses which hash alike. Windows has
+// WaitOnAddress, but only from Windows 8.
+struct FutexBucket {
+  std::mutex Mutex;
+  std::condition_variable Condition;
+};
+
+static FutexBucket& GetFutexBucket(const void* address) {
+  enum { BucketCount = 64 };
+  // Never destroyed, as events can be used by static destructors.
+  static FutexBucket* buckets = new FutexBucket[BucketCount];
+  return buckets[((uintptr_t)address >> 4) % BucketCount];
+}
+
+static void FutexWait(std::atomic<uint32_t>* address, uint32_t expected, unsigned delay) {
+  FutexBucket& bucket = GetFutexBucket(address);
+  std::unique_lock<std::mutex> lock(bucket.Mutex);
+  if (address->load() != expected)
+    return;
+  if (delay == OVR_WAIT_INFINITE)
+    bucket.Condition.wait(lock);
+  else
+    bucket.Condition.wait_for(lock, std::chrono::milliseconds(delay));
+}
+
+static void FutexWakeAll(std::atomic<uint32_t>* address) {
+  FutexBucket& bucket = GetFutexBucket(address);
+  // Taking the mutex orders this after any waiter's check of the value.
+  {
+    std::lock_guard<std::mutex> lock(bucket.Mutex);
+  }
+  bucket.Condition.notify_all();
+}
+
+#endif // OVR_FUTEX_AVAILABLE
+
+// Tracks the time left of a wait in milliseconds, which stays OVR_WAIT_INFINITE if it was.
+class WaitDeadline {
+ public:
+  explicit WaitDeadline(unsigned delay)
+      : Delay(delay), Start(std::chrono::steady_clock::now()) {}
+
+  // Returns false once the time is up.
+  bool GetRemaining(unsigned& remaining) const {
+    if (Delay == OVR_WAIT_INFINITE) {
+      remaining = OVR_WAIT_INFINITE;
+      return true;
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - Start)
+                       .count();
+    if (elapsed >= (int64_t)Delay)
+      return false;
+    remaining = Delay - (unsigned)elapsed;
+    return true;
+  }
+
+ private:
+  unsigned Delay;
+  std::chrono::steady_clock::time_point Start;
+};
+
+//-----------------------------------------------------------------------------------
+// ***** Event
+//
+// Waiters register in Waiters before checking State, and setters change State before checking
+// Waiters, both sequentially consistent, so either the setter sees the waiter and wakes it,
+// or the waiter sees the new State. WaitAny waiters sleep on their own word, which setters
+// signal through the event's WaitAny list.
+
+struct Event::WaitAnyNode {
+  std::atomic<uint32_t>* pSignaled;
+  WaitAnyNode* pNext;
+};
+
+Event::Event(bool setInitially)
+    : State(setInitially ? State_Set : State_Reset),
+      Waiters(0),
+      WaitAnyLock(),
+      pWaitAnyList(nullptr),
+      PollFd(-1) {}
+
+Event::~Event() {
+  OVR_ASSERT(Waiters.load() == 0);
+#if defined(OVR_FUTEX_AVAILABLE)
+  int fd = PollFd.load();
+  if (fd >= 0)
+    close(fd);
+#endif
+}
+
+// Takes the event if it's set, consuming a pulse.
+bool Event::tryAcquire() {
+  uint32_t state = State.load();
+  while (state != State_Reset) {
+    if (state == State_Set)
+      return true;
+    if (State.compare_exchange_weak(state, State_Reset)) {
+      updatePollFd();
+      return true;
+    }
+  }
+  return false;
+}
+
+void Event::setState(uint32_t newState) {
+  uint32_t oldState = State.exchange(newState);
+  if (oldState == State_Reset)
+    updatePollFd();
+  if (Waiters.load() != 0)
+    wakeWaiters();
+}
+
+void Event::wakeWaiters() {
+  FutexWakeAll(&State);
+
+  Lock::Locker locker(&WaitAnyLock);
+  for (WaitAnyNode* node = pWaitAnyList; node; node = node->pNext) {
+    node->pSignaled->store(1);
+    FutexWakeAll(node->pSignaled);
+  }
+}
+
+void Event::ResetEvent() {
+  State.store(State_Reset);
+  updatePollFd();
+}
+
+// Makes the eventfd readable if and only if the event is set. Concurrent updates can leave
+// it readable while the event is reset, but not the other way around, as the eventfd is
+// drained before State is rechecked.
+void Event::updatePollFd() {
+#if defined(OVR_FUTEX_AVAILABLE)
+  int fd = PollFd.load(std::memory_order_acquire);
+  if (fd < 0)
+    return;
+
+  uint64_t count;
+  if (State.load() == State_Reset) {
+    while (read(fd, &count, sizeof(count)) == sizeof(count))
+      ;
+    if (State.load() == State_Reset)
+      return;
+  }
+  count = 1;
+  if (write(fd, &count, sizeof(count)) < 0) {
+    // The counter only overflows after 2^64 - 1 writes without a read.
+  }
+#endif
+}
+
+bool Event::Wait(unsigned delay) {
+  // Fast path: no registration if the event is already set.
+  if (tryAcquire())
+    return true;
+  if (delay == 0)
+    return false;
+
+  WaitDeadline deadline(delay);
+  bool result = false;
+  Waiters.fetch_add(1);
+
+  for (;;) {
+    if (tryAcquire()) {
+      result = true;
+      break;
+    }
+    unsigned remaining;
+    if (!deadline.GetRemaining(remaining))
+      break;
+    FutexWait(&State, State_Reset, remaining);
+  }
+
+  Waiters.fetch_sub(1);
+  return result;
+}
+
+int Event::WaitAny(Event* const events[], int count, unsigned delay) {
+  for (int i = 0; i < count; ++i) {
+    if (events[i]->tryAcquire())
+      return i;
+  }
+  if (delay == 0)
+    return -1;
+
+  WaitDeadline deadline(delay);
+  std::atomic<uint32_t> signaled(0);
+
+  // Register with every event. Most callers wait on a few, which fit on the stack.
+  WaitAnyNode localNodes[8];
+  ArrayPOD<WaitAnyNode> heapNodes;
+  WaitAnyNode* nodes = localNodes;
+  if (count > (int)OVR_ARRAY_COUNT(localNodes)) {
+    heapNodes.Resize(count);
+    nodes = heapNodes.GetDataPtr();
+  }
+
+  for (int i = 0; i < count; ++i) {
+    Event* event = events[i];
+    nodes[i].pSignaled = &signaled;
+    {
+      Lock::Locker locker(&event->WaitAnyLock);
+      nodes[i].pNext = event->pWaitAnyList;
+      event->pWaitAnyList = &nodes[i];
+    }
+    event->Waiters.fetch_add(1);
+  }
+
+  int result = -1;
+  for (;;) {
+    // Clear the signal before checking, so that a set after the check wakes the wait.
+    signaled.store(0);
+    for (int i = 0; (i < count) && (result < 0); ++i) {
+      if (events[i]->tryAcquire())
+        result = i;
+    }
+    unsigned remaining;
+    if ((result >= 0) || !deadline.GetRemaining(remaining))
+      break;
+    FutexWait(&signaled, 0, remaining);
+  }
+
+  for (int i = 0; i < count; ++i) {
+    Event* event = events[i];
+    event->Waiters.fetch_sub(1);
+    Lock::Locker locker(&event->WaitAnyLock);
+    WaitAnyNode** link = &event->pWaitAnyList;
+    while (*link != &nodes[i])
+      link = &(*link)->pNext;
+    *link = nodes[i].pNext;
+  }
+
+  return result;
+}
+
+int Event::GetPollFd() {
+#if defined(OVR_FUTEX_AVAILABLE)
+  int fd = PollFd.load(std::memory_order_acquire);
+  if (fd >= 0)
+    return fd;
+
+  int newFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (newFd < 0)
+    return -1;
+  if (!PollFd.compare_exchange_strong(fd, newFd, std::memory_order_acq_rel)) {
+    close(newFd); // Another thread created it first.
+    return fd;
+  }
+  updatePollFd();
+  return newFd;
+#else
+  return -1;
+#endif
+}
+
+//-----------------------------------------------------------------------------------
+// ***** Thread attributes
+
+bool Thread::SetCurrentThreadAttributes(const ThreadAttributes& attributes) {
+  bool result = true;
+
+  if (attributes.AffinityMask && !SetCurrentThreadAffinity(attributes.AffinityMask))
+    result = false;
+
+  if (attributes.Policy != ThreadScheduling_Unchanged && !SetCurrentThreadScheduling(attributes))
+    result = false;
+
+  // Lock memory before touching the stack, so the touched pages stay resident.
+  if (attributes.LockMemory && !LockProcessMemory())
+    result = false;
+
+  if (attributes.StackPrefaultSize)
+    PrefaultCurrentThreadStack(attributes.StackPrefaultSize);
+
+  return result;
+}
+
+// Touches size bytes of stack below the caller, one page sized frame at a time. The write
+// after the recursive call keeps the compiler from reusing the frame as a tail call.
+static size_t PrefaultStackPages(size_t size) {
+  volatile char page[4096];
+  page[sizeof(page) - 1] = 0; // The top first, as Windows grows its stack through guard pages.
+  page[0] = 0;
+  size_t touched = sizeof(page);
+  if (size > sizeof(page))
+    touched += PrefaultStackPages(size - sizeof(page));
+  page[0] = (char)touched;
+  return touched;
+}
+
+void Thread::PrefaultCurrentThreadStack(size_t size) {
+  PrefaultStackPages(size);
+}
+
+// *** Background thread attributes
+
+static std::mutex BackgroundAttributesMutex;
+static ThreadAttributes BackgroundAttributes;
+static std::atomic<unsigned> BackgroundAttributesVersion = {0};
+
+// Applies the background attributes on the logging worker thread, which can't see this file.
+static void UpdateLoggingWorkerThread() {
+  static OVR_THREAD_LOCAL unsigned appliedVersion = 0;
+  Thread::UpdateBackgroundThreadAttributes(appliedVersion);
+}
+
+void Thread::SetBackgroundThreadAttributes(const ThreadAttributes& attributes) {
+  {
+    std::lock_guard<std::mutex> lock(BackgroundAttributesMutex);
+    BackgroundAttributes = attributes;
+    BackgroundAttributesVersion.fetch_add(1, std::memory_order_release);
+  }
+
+  ovrlog::OutputWorker::GetInstance()->SetWorkerThreadHook(&UpdateLoggingWorkerThread);
+}
+
+ThreadAttributes Thread::GetBackgroundThreadAttributes() {
+  std::lock_guard<std::mutex> lock(BackgroundAttributesMutex);
+  return BackgroundAttributes;
+}
+
+bool Thread::UpdateBackgroundThreadAttributes(unsigned& appliedVersion) {
+  if (BackgroundAttributesVersion.load(std::memory_order_acquire) == appliedVersion)
+    return true;
+
+  ThreadAttributes attributes;
+  {
+    std::lock_guard<std::mutex> lock(BackgroundAttributesMutex);
+    attributes = BackgroundAttributes;
+    appliedVersion = BackgroundAttributesVersion.load(std::memory_order_relaxed);
+  }
+
+  return SetCurrentThreadAttributes(attributes);
+}
+
+} // namespace OVR
+
+#endif // OVR_ENABLE_THREADS
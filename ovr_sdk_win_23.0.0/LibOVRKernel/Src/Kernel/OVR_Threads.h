@@ -103,19 +103,44 @@ class Mutex {
 // Event is a wait-able synchronization object similar to Windows event.
 // Event can be waited on until it's signaled by another thread calling
 // either SetEvent or PulseEvent.
+//
+// The state is a single atomic word, so setting an event nobody waits on, and waiting on one
+// that's already set, don't take locks or enter the kernel. Blocked threads wait on the word
+// with a futex on Linux, and on a hashed condition variable elsewhere.
+//
+// Several events can be waited on at once with WaitAny. On Linux, GetPollFd also returns an
+// eventfd which is readable while the event is set, for use with poll or epoll.
+//
+// Example usage, for a thread servicing several sources:
+//     Event* events[] = {&ShutdownEvent, &LogWakeEvent, &DeviceReadyEvent};
+//     for (;;) {
+//       int index = Event::WaitAny(events, 3);
+//       if (index == 0)
+//         break;
+//       ...
+//     }
 
 class Event {
-  // Event state, its mutex and the wait condition
-  volatile bool State;
-  volatile bool Temporary;
-  mutable std::mutex StateMutex;
-  std::condition_variable StateWaitCondition;
+  enum { State_Reset = 0, State_Set = 1, State_Pulsed = 2 };
+
+  struct WaitAnyNode; // A WaitAny call waiting on this event.
+
+  std::atomic<uint32_t> State; // A State_ value; blocked Waits sleep on it.
+  std::atomic<int> Waiters; // Threads in Wait or WaitAny on this event.
+  Lock WaitAnyLock;
+  WaitAnyNode* pWaitAnyList;
+  std::atomic<int> PollFd; // eventfd created by GetPollFd, or -1.
+
+  bool tryAcquire();
+  void setState(uint32_t newState);
+  void wakeWaiters();
+  void updatePollFd();
 
-  void updateState(bool newState, bool newTemp, bool mustNotify);
+  OVR_NON_COPYABLE(Event);
 
  public:
-  Event(bool setInitially = 0) : State(setInitially), Temporary(false) {}
-  ~Event() {}
+  Event(bool setInitially = 0);
+  ~Event();
 
   // Wait on an event condition until it is set
   // Delay is specified in milliseconds (1/1000 of a second).
@@ -123,20 +148,27 @@ class Event {
 
   // Set an event, releasing objects waiting on it
   void SetEvent() {
-    updateState(true, false, true);
+    setState(State_Set);
   }
 
   // Reset an event, un-signaling it
-  void ResetEvent() {
-    updateState(false, false, false);
-  }
+  void ResetEvent();
 
   // Set and then reset an event once a waiter is released.
   // If threads are already waiting, they will be notified and released
   // If threads are not waiting, the event is set until the first thread comes in
   void PulseEvent() {
-    updateState(true, true, true);
+    setState(State_Pulsed);
   }
+
+  // Waits until one of the events is set, and returns its index, or -1 on timeout. If several
+  // are set, the lowest index wins, and only that event's pulse is consumed.
+  static int WaitAny(Event* const events[], int count, unsigned delay = OVR_WAIT_INFINITE);
+
+  // Returns an eventfd that is readable while the event is set, or -1 where unsupported. It's
+  // created on first use and owned by the event. Readability can be stale by the time it's
+  // acted on, so poll loops should still call Wait(0) to take the event.
+  int GetPollFd();
 };
 
 //-----------------------------------------------------------------------------------
@@ -164,6 +196,63 @@ typedef void* ThreadId;
 // and finish once it is set.
 #define OVR_THREAD_EXIT 0x10
 
+// *** Thread attributes
+
+// ThreadSchedulingPolicy selects how the OS schedules a thread against the others.
+enum ThreadSchedulingPolicy {
+  ThreadScheduling_Unchanged, // Leave the thread's scheduling as it is.
+  ThreadScheduling_Normal, // Time sharing at normal priority.
+  ThreadScheduling_Background, // Time sharing at low priority, for logging and I/O threads.
+  ThreadScheduling_RealTime, // Fixed priority which preempts all time sharing threads.
+  ThreadScheduling_Deadline // Runtime guaranteed every period. RealTime where unsupported.
+};
+
+// ThreadAttributes describes how a thread is to be scheduled, for threads with latency
+// requirements, such as a 1 kHz input thread, and for the threads which must stay out of
+// their way. Fields left at their defaults are not changed.
+//
+// Platform mapping:
+//     Linux:   pthread_setaffinity_np, SCHED_FIFO, SCHED_DEADLINE, nice values, mlockall.
+//              RealTime and Deadline need CAP_SYS_NICE or an RLIMIT_RTPRIO allowance, and
+//              LockMemory needs CAP_IPC_LOCK or a sufficient RLIMIT_MEMLOCK.
+//     Mac:     SCHED_FIFO, Darwin background priority and mlockall. No affinity control.
+//     Windows: SetThreadAffinityMask and thread priorities, where RealTime and Deadline are
+//              THREAD_PRIORITY_TIME_CRITICAL. No memory locking.
+
+struct ThreadAttributes {
+  ThreadAttributes()
+      : AffinityMask(0),
+        Policy(ThreadScheduling_Unchanged),
+        RealTimePriority(0),
+        DeadlineRuntimeNs(0),
+        DeadlineNs(0),
+        DeadlinePeriodNs(0),
+        LockMemory(false),
+        StackPrefaultSize(0) {}
+
+  // CPUs the thread may run on, with bit n for CPU n. 0 leaves the affinity unchanged.
+  uint64_t AffinityMask;
+
+  ThreadSchedulingPolicy Policy;
+
+  // 1 (lowest) to 99 (highest) for ThreadScheduling_RealTime, as with SCHED_FIFO.
+  int RealTimePriority;
+
+  // For ThreadScheduling_Deadline: the thread gets DeadlineRuntimeNs of CPU time within
+  // DeadlineNs of the start of every DeadlinePeriodNs. DeadlineNs 0 means the whole period.
+  uint64_t DeadlineRuntimeNs;
+  uint64_t DeadlineNs;
+  uint64_t DeadlinePeriodNs;
+
+  // Locks all current and future memory of the process into RAM, so that no thread takes page
+  // faults on it. This applies to the whole process, not just the thread.
+  bool LockMemory;
+
+  // Bytes of the thread's stack to touch in advance, so that using them later doesn't fault.
+  // Combined with LockMemory, the pages then stay resident. Must be less than the stack size.
+  size_t StackPrefaultSize;
+};
+
 namespace Thread {
 // *** Sleep
 
@@ -173,6 +262,36 @@ bool MSleep(unsigned msecs);
 // *** Debugging functionality
 void SetCurrentThreadName(const char* name);
 void GetCurrentThreadName(char* name, size_t nameCapacity);
+
+// *** Scheduling
+//
+// These return false if the platform doesn't support the request or the process lacks the
+// privilege for it, in which case the thread is left as it was.
+
+// Applies all of the attributes that are set. Returns false if any of them failed, after
+// applying the rest.
+bool SetCurrentThreadAttributes(const ThreadAttributes& attributes);
+
+bool SetCurrentThreadAffinity(uint64_t affinityMask);
+
+// Applies the Policy of the attributes and its parameters.
+bool SetCurrentThreadScheduling(const ThreadAttributes& attributes);
+
+bool LockProcessMemory();
+
+void PrefaultCurrentThreadStack(size_t size);
+
+// Attributes for LibOVRKernel's own background threads: the logging worker, LongPollThread and
+// the WatchDogObserver. They're applied to those threads as they start, and by running ones at
+// their next wakeup, so that they can be kept off the CPUs of latency sensitive threads.
+// None are set by default.
+void SetBackgroundThreadAttributes(const ThreadAttributes& attributes);
+ThreadAttributes GetBackgroundThreadAttributes();
+
+// Applies the background thread attributes to the calling thread if they have changed since
+// the version it last applied, which starts at 0. Cheap when nothing has changed, so
+// background threads can call it every time they wake up. Returns false if applying failed.
+bool UpdateBackgroundThreadAttributes(unsigned& appliedVersion);
 }; // namespace Thread
 
 // Returns the unique Id of a thread it is called on, intended for
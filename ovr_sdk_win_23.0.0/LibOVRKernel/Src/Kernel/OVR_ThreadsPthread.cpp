@@ -33,11 +33,18 @@ limitations under the License.
 #include <errno.h>
 #include <pthread.h>
 #include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
 #include <sys/time.h>
 #include <time.h>
 #include <unistd.h>
+#include "OVR_Alg.h"
 #include "OVR_Timer.h"
 
+#if defined(OVR_OS_LINUX)
+#include <sys/syscall.h>
+#endif
+
 #if defined(OVR_OS_MAC) || defined(OVR_OS_BSD)
 #include <sys/param.h>
 #include <sys/sysctl.h>
@@ -165,40 +172,6 @@ bool Mutex::IsLockedByAnotherThread() {
   return pImpl->IsLockedByAnotherThread(this);
 }
 
-//-----------------------------------------------------------------------------------
-// ***** Event
-
-bool Event::Wait(unsigned delay) {
-  std::unique_lock<std::mutex> locker(StateMutex);
-
-  // Do the correct amount of waiting
-  if (delay == OVR_WAIT_INFINITE) {
-    while (!State)
-      StateWaitCondition.wait(locker);
-  } else if (delay) {
-    if (!State)
-      StateWaitCondition.wait_for(locker, std::chrono::milliseconds(delay));
-  }
-
-  bool state = State;
-  // Take care of temporary 'pulsing' of a state
-  if (Temporary) {
-    Temporary = false;
-    State = false;
-  }
-  return state;
-}
-
-void Event::updateState(bool newState, bool newTemp, bool mustNotify) {
-  std::unique_lock<std::mutex> lock(StateMutex);
-  State = newState;
-  Temporary = newTemp;
-  if (mustNotify) {
-    lock.unlock();
-    StateWaitCondition.notify_all();
-  }
-}
-
 ThreadId GetCurrentThreadId() {
   return (void*)pthread_self();
 }
@@ -227,6 +200,105 @@ void Thread::GetCurrentThreadName(char* name, size_t nameCapacity) {
 #endif
 }
 
+//-----------------------------------------------------------------------------------
+// ***** Thread attributes
+
+bool Thread::SetCurrentThreadAffinity(uint64_t affinityMask) {
+#if defined(OVR_OS_LINUX) || defined(OVR_OS_ANDROID)
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  for (int cpu = 0; cpu < 64; ++cpu) {
+    if (affinityMask & ((uint64_t)1 << cpu))
+      CPU_SET(cpu, &cpuSet);
+  }
+  return sched_setaffinity(0, sizeof(cpuSet), &cpuSet) == 0; // 0 is the calling thread.
+#else
+  // Mac only has affinity hints between threads, and BSD uses cpuset_t.
+  OVR_UNUSED(affinityMask);
+  return false;
+#endif
+}
+
+#if defined(OVR_OS_LINUX)
+// The glibc headers don't declare sched_setattr, which SCHED_DEADLINE requires.
+#if !defined(SCHED_DEADLINE)
+#define SCHED_DEADLINE 6
+#endif
+
+struct SchedAttr {
+  uint32_t size;
+  uint32_t sched_policy;
+  uint64_t sched_flags;
+  int32_t sched_nice;
+  uint32_t sched_priority;
+  uint64_t sched_runtime;
+  uint64_t sched_deadline;
+  uint64_t sched_period;
+};
+
+static bool SetCurrentThreadDeadline(const ThreadAttributes& attributes) {
+  SchedAttr attr = {};
+  attr.size = sizeof(attr);
+  attr.sched_policy = SCHED_DEADLINE;
+  attr.sched_runtime = attributes.DeadlineRuntimeNs;
+  attr.sched_deadline =
+      attributes.DeadlineNs ? attributes.DeadlineNs : attributes.DeadlinePeriodNs;
+  attr.sched_period = attributes.DeadlinePeriodNs;
+  return syscall(SYS_sched_setattr, 0, &attr, 0) == 0;
+}
+
+// Linux keeps a nice value per thread, which setpriority sets given the thread id.
+static bool SetCurrentThreadNice(int nice) {
+  return setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), nice) == 0;
+}
+#endif
+
+bool Thread::SetCurrentThreadScheduling(const ThreadAttributes& attributes) {
+  sched_param param = {};
+
+  switch (attributes.Policy) {
+    case ThreadScheduling_Unchanged:
+      return true;
+
+    case ThreadScheduling_Normal:
+    case ThreadScheduling_Background: {
+      bool background = (attributes.Policy == ThreadScheduling_Background);
+      if (pthread_setschedparam(pthread_self(), SCHED_OTHER, &param) != 0)
+        return false;
+#if defined(OVR_OS_LINUX)
+      return SetCurrentThreadNice(background ? 10 : 0);
+#elif defined(OVR_OS_MAC)
+      return setpriority(PRIO_DARWIN_THREAD, 0, background ? PRIO_DARWIN_BG : 0) == 0;
+#else
+      return !background;
+#endif
+    }
+
+    case ThreadScheduling_Deadline:
+#if defined(OVR_OS_LINUX)
+      if (attributes.DeadlineRuntimeNs && attributes.DeadlinePeriodNs)
+        return SetCurrentThreadDeadline(attributes);
+#endif
+    // Fall through to a fixed real-time priority.
+    case ThreadScheduling_RealTime: {
+      int minPriority = sched_get_priority_min(SCHED_FIFO);
+      int maxPriority = sched_get_priority_max(SCHED_FIFO);
+      param.sched_priority = Alg::Clamp(attributes.RealTimePriority, minPriority, maxPriority);
+      return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+    }
+  }
+
+  return false;
+}
+
+bool Thread::LockProcessMemory() {
+#if defined(OVR_OS_ANDROID)
+  return false;
+#else
+  return mlockall(MCL_CURRENT | MCL_FUTURE) == 0;
+#endif
+}
+
 } // namespace OVR
 
 #endif // OVR_ENABLE_THREADS
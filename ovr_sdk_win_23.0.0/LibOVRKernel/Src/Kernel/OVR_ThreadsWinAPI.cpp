@@ -195,43 +195,6 @@ bool Mutex::IsLockedByAnotherThread() {
   return pImpl->IsLockedByAnotherThread(this);
 }
 
-//-----------------------------------------------------------------------------------
-// ***** Event
-
-bool Event::Wait(unsigned delay) {
-  std::unique_lock<std::mutex> locker(StateMutex);
-
-  // Do the correct amount of waiting
-  if (delay == OVR_WAIT_INFINITE) {
-    while (!State)
-      StateWaitCondition.wait(locker);
-  } else if (delay) {
-    if (!State)
-      StateWaitCondition.wait_for(locker, std::chrono::milliseconds(delay));
-  }
-
-  bool state = State;
-  // Take care of temporary 'pulsing' of a state
-  if (Temporary) {
-    Temporary = false;
-    State = false;
-  }
-  return state;
-}
-
-void Event::updateState(bool newState, bool newTemp, bool mustNotify) {
-  {
-    std::lock_guard<std::mutex> lock(StateMutex);
-    State = newState;
-    Temporary = newTemp;
-  }
-
-  // NOTE: The lock does not need to be held when calling notify_all(),
-  // and holding it is in fact a pessimization.
-  if (mustNotify)
-    StateWaitCondition.notify_all();
-}
-
 //-----------------------------------------------------------------------------------
 // ***** Thread Namespace
 
@@ -303,6 +266,41 @@ void Thread::GetCurrentThreadName(char* name, size_t nameCapacity) {
   OVR_strlcpy(name, ThreadLocaThreadlName, nameCapacity);
 }
 
+//-----------------------------------------------------------------------------------
+// ***** Thread attributes
+
+bool Thread::SetCurrentThreadAffinity(uint64_t affinityMask) {
+  // Only the CPUs of the thread's processor group can be set, 64 at most.
+  return ::SetThreadAffinityMask(::GetCurrentThread(), (DWORD_PTR)affinityMask) != 0;
+}
+
+bool Thread::SetCurrentThreadScheduling(const ThreadAttributes& attributes) {
+  int priority;
+
+  switch (attributes.Policy) {
+    case ThreadScheduling_Unchanged:
+      return true;
+    case ThreadScheduling_Normal:
+      priority = THREAD_PRIORITY_NORMAL;
+      break;
+    case ThreadScheduling_Background:
+      priority = THREAD_PRIORITY_LOWEST;
+      break;
+    default:
+      // Only real-time in a REALTIME_PRIORITY_CLASS process; otherwise the highest priority
+      // of the process's class.
+      priority = THREAD_PRIORITY_TIME_CRITICAL;
+      break;
+  }
+
+  return ::SetThreadPriority(::GetCurrentThread(), priority) != 0;
+}
+
+bool Thread::LockProcessMemory() {
+  // VirtualLock only covers given ranges, not future allocations.
+  return false;
+}
+
 // Returns the unique Id of a thread it is called on, intended for
 // comparison purposes.
 ThreadId GetCurrentThreadId() {
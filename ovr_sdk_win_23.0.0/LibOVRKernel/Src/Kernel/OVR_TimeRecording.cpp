@@ -0,0 +1,315 @@
+/************************************************************************************
+
+Filename    :   OVR_TimeRecording.cpp
+Content     :   Recording and deterministic replay of timestamped data streams
+Created     :   October 18, 2026
+Notes       :
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+#include "OVR_TimeRecording.h"
+
+#include <chrono>
+#include <thread>
+#include "OVR_Alg.h"
+#include "OVR_Timer.h"
+
+namespace OVR {
+
+// A recording is the magic followed by records, each a RecordHeader and Size bytes of data.
+// Streams are declared by records for DeclareStream, holding the stream id and its name.
+static const char RecordingMagic[8] = {'O', 'V', 'R', 'T', 'R', 'E', 'C', '1'};
+static const uint32_t DeclareStream = 0xffffffff;
+static const uint32_t MaxRecordSize = 1 << 24;
+static const uint32_t MaxStreamCount = 1 << 16;
+
+struct RecordHeader {
+  uint64_t TimestampNanos;
+  uint32_t Stream;
+  uint32_t Size;
+};
+
+//-----------------------------------------------------------------------------
+// ***** TimeRecorder
+
+TimeRecorder::TimeRecorder(File* file)
+    : RecordLock(), pFile(file), Failed(!file || !file->IsValid()), StreamCount(0), BufferUsed(0) {
+  writeRaw(RecordingMagic, sizeof(RecordingMagic));
+}
+
+TimeRecorder::~TimeRecorder() {
+  Flush();
+}
+
+uint32_t TimeRecorder::AddStream(const char* name) {
+  Lock::Locker locker(&RecordLock);
+
+  const uint32_t stream = StreamCount++;
+  const size_t nameSize = strlen(name);
+  RecordHeader header = {Timer::GetTicksNanos(), DeclareStream, uint32_t(4 + nameSize)};
+  writeRaw(&header, sizeof(header));
+  writeRaw(&stream, 4);
+  writeRaw(name, nameSize);
+  return stream;
+}
+
+void TimeRecorder::Record(uint32_t stream, const void* data, size_t size) {
+  Lock::Locker locker(&RecordLock);
+  writeRecord(Timer::GetTicksNanos(), stream, data, size);
+}
+
+void TimeRecorder::Record(
+    uint32_t stream,
+    const void* data,
+    size_t size,
+    uint64_t timestampNanos) {
+  Lock::Locker locker(&RecordLock);
+  writeRecord(timestampNanos, stream, data, size);
+}
+
+void TimeRecorder::writeRecord(
+    uint64_t timestampNanos,
+    uint32_t stream,
+    const void* data,
+    size_t size) {
+  OVR_ASSERT_M(stream < StreamCount, "TimeRecorder: Undeclared stream.");
+  if ((stream >= StreamCount) || (size > MaxRecordSize)) {
+    Failed = true;
+    return;
+  }
+
+  RecordHeader header = {timestampNanos, stream, uint32_t(size)};
+  writeRaw(&header, sizeof(header));
+  writeRaw(data, size);
+}
+
+void TimeRecorder::writeRaw(const void* data, size_t size) {
+  const uint8_t* bytes = static_cast<const uint8_t*>(data);
+  while (size) {
+    if (BufferUsed == BufferSize)
+      flushBuffer();
+
+    const size_t count = Alg::Min(size, BufferSize - BufferUsed);
+    memcpy(Buffer + BufferUsed, bytes, count);
+    BufferUsed += count;
+    bytes += count;
+    size -= count;
+  }
+}
+
+void TimeRecorder::flushBuffer() {
+  if (BufferUsed && !Failed) {
+    if (pFile->Write(Buffer, (int)BufferUsed) != (int)BufferUsed)
+      Failed = true;
+  }
+  BufferUsed = 0;
+}
+
+bool TimeRecorder::Flush() {
+  Lock::Locker locker(&RecordLock);
+  flushBuffer();
+  if (!Failed && !pFile->Flush())
+    Failed = true;
+  return !Failed;
+}
+
+//-----------------------------------------------------------------------------
+// ***** TimeReplayer
+
+TimeReplayer::TimeReplayer(File* file)
+    : pFile(file),
+      HeaderRead(false),
+      AtEnd(false),
+      DrivingClock(false),
+      Error((!file || !file->IsValid()) ? "Recording could not be opened" : nullptr),
+      SampleCount(0),
+      LastTimestampNanos(0),
+      FirstTimestampNanos(0),
+      BaseNanos(0),
+      Stopped(false) {}
+
+TimeReplayer::~TimeReplayer() {
+  if (DrivingClock)
+    Timer::SetVirtualTicksNanos(0, false);
+}
+
+void TimeReplayer::SetHandler(const char* streamName, SampleFunc handler) {
+  int index = -1;
+  for (size_t i = 0; i < Handlers.GetSize(); ++i) {
+    if (Handlers[i].StreamName == streamName)
+      index = (int)i;
+  }
+
+  if (index < 0) {
+    index = (int)Handlers.GetSize();
+    Handlers.PushBack(Handler());
+    Handlers[index].StreamName = streamName;
+  }
+  Handlers[index].Func = handler;
+
+  // Streams may have been declared already.
+  for (size_t i = 0; i < StreamNames.GetSize(); ++i) {
+    if (StreamNames[i] == streamName)
+      StreamHandlers[i] = index;
+  }
+}
+
+bool TimeReplayer::fail(const char* error) {
+  if (!Error)
+    Error = error;
+  return false;
+}
+
+bool TimeReplayer::readExact(void* data, size_t size, bool allowEnd) {
+  uint8_t* bytes = static_cast<uint8_t*>(data);
+  size_t done = 0;
+
+  while (done < size) {
+    const int count = pFile->Read(bytes + done, (int)(size - done));
+    if (count <= 0) {
+      if (allowEnd && (done == 0)) {
+        AtEnd = true;
+        return false;
+      }
+      return fail("Truncated recording");
+    }
+    done += (size_t)count;
+  }
+
+  return true;
+}
+
+bool TimeReplayer::readRecord(uint64_t& timestampNanos, uint32_t& stream) {
+  if (Error || AtEnd)
+    return false;
+
+  if (!HeaderRead) {
+    char magic[sizeof(RecordingMagic)];
+    if (!readExact(magic, sizeof(magic), false) ||
+        (memcmp(magic, RecordingMagic, sizeof(magic)) != 0))
+      return fail("Not a recording");
+    HeaderRead = true;
+  }
+
+  for (;;) {
+    RecordHeader header;
+    if (!readExact(&header, sizeof(header), true))
+      return false;
+    if (header.Size > MaxRecordSize)
+      return fail("Malformed recording");
+
+    Payload.Resize(header.Size);
+    if (header.Size && !readExact(Payload.GetDataPtr(), header.Size, false))
+      return false;
+
+    if (header.Stream != DeclareStream) {
+      timestampNanos = header.TimestampNanos;
+      stream = header.Stream;
+      return true;
+    }
+
+    // A stream declaration; match it to its handler.
+    uint32_t id = 0;
+    if (header.Size >= 4)
+      memcpy(&id, Payload.GetDataPtr(), 4);
+    if ((header.Size < 4) || (id >= MaxStreamCount))
+      return fail("Malformed recording");
+
+    if (id >= StreamNames.GetSize()) {
+      const size_t oldSize = StreamHandlers.GetSize();
+      StreamNames.Resize(id + 1);
+      StreamHandlers.Resize(id + 1);
+      for (size_t i = oldSize; i <= id; ++i)
+        StreamHandlers[i] = -1;
+    }
+
+    StreamNames[id] = String((const char*)Payload.GetDataPtr() + 4, header.Size - 4);
+    StreamHandlers[id] = -1;
+    for (size_t i = 0; i < Handlers.GetSize(); ++i) {
+      if (Handlers[i].StreamName == StreamNames[id])
+        StreamHandlers[id] = (int)i;
+    }
+  }
+}
+
+void TimeReplayer::replayRecord(uint64_t timestampNanos, uint32_t stream) {
+  // The recording starts at the current time, so that the virtual clock doesn't jump back to
+  // when it was recorded.
+  if (SampleCount == 0) {
+    FirstTimestampNanos = timestampNanos;
+    LastTimestampNanos = timestampNanos;
+    BaseNanos = Timer::GetVirtualTicksNanos();
+  }
+
+  // The virtual clock doesn't go backwards, even if samples were recorded with out of order
+  // timestamps.
+  LastTimestampNanos = Alg::Max(timestampNanos, LastTimestampNanos);
+  Timer::SetVirtualTicksNanos(BaseNanos + (LastTimestampNanos - FirstTimestampNanos));
+  DrivingClock = true;
+  ++SampleCount;
+
+  const int index = (stream < StreamHandlers.GetSize()) ? StreamHandlers[stream] : -1;
+  if ((index >= 0) && Handlers[index].Func.IsValid())
+    Handlers[index].Func(Payload.GetDataPtr(), Payload.GetSize());
+}
+
+bool TimeReplayer::Step() {
+  uint64_t timestampNanos;
+  uint32_t stream;
+  if (!readRecord(timestampNanos, stream))
+    return false;
+
+  replayRecord(timestampNanos, stream);
+  return true;
+}
+
+bool TimeReplayer::Run(double speed) {
+  // Pacing is by the real clock, as the Timer reports the virtual time during the replay.
+  const std::chrono::steady_clock::time_point realStart = std::chrono::steady_clock::now();
+  bool started = false;
+  uint64_t startNanos = 0;
+
+  // A Stop is consumed by the Run it ends.
+  while (!Stopped.exchange(false, std::memory_order_relaxed)) {
+    uint64_t timestampNanos;
+    uint32_t stream;
+    if (!readRecord(timestampNanos, stream))
+      return !Error;
+
+    if (speed > 0.0) {
+      if (!started) {
+        started = true;
+        startNanos = timestampNanos;
+      }
+
+      if (timestampNanos > startNanos) {
+        const double realNanos = double(timestampNanos - startNanos) / speed;
+        std::this_thread::sleep_until(
+            realStart + std::chrono::nanoseconds(int64_t(realNanos)));
+      }
+    }
+
+    replayRecord(timestampNanos, stream);
+  }
+
+  return true;
+}
+
+} // namespace OVR
@@ -0,0 +1,216 @@
+/************************************************************************************
+
+Filename    :   OVR_TimeRecording.h
+Content     :   Recording and deterministic replay of timestamped data streams
+Created     :   October 18, 2026
+Notes       :
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+#ifndef OVR_TimeRecording_h
+#define OVR_TimeRecording_h
+
+#include <string.h>
+#include <atomic>
+#include <type_traits>
+#include "OVR_Array.h"
+#include "OVR_Atomic.h"
+#include "OVR_Delegates.h"
+#include "OVR_File.h"
+#include "OVR_String.h"
+#include "OVR_Types.h"
+
+namespace OVR {
+
+//-----------------------------------------------------------------------------
+// ***** TimeRecorder
+//
+// Records timestamped samples of named data streams, such as the tracking states or controller
+// data a device delivers, to a File for later replay with TimeReplayer. Samples are stored as
+// raw bytes, so typed samples must be trivially copyable, and recordings are only portable
+// between machines of the same endianness.
+//
+// Record may be called from several threads at once. Samples are timestamped with
+// Timer::GetTicksNanos as they're recorded, unless given a timestamp, and written in the order
+// they're recorded. Write errors are sticky, as with JSONWriter.
+//
+// Example usage:
+//     TimeRecorder recorder(file);
+//     const uint32_t poseStream = recorder.AddStream("HeadPose");
+//     ...
+//     recorder.Record(poseStream, headPose);
+
+class TimeRecorder {
+ public:
+  TimeRecorder(File* file);
+  ~TimeRecorder(); // Flushes.
+
+  // Declares a stream, and returns its id for Record.
+  uint32_t AddStream(const char* name);
+
+  void Record(uint32_t stream, const void* data, size_t size);
+
+  // Records a sample with an explicit timestamp, in Timer::GetTicksNanos time, such as a
+  // device's own time of measurement.
+  void Record(uint32_t stream, const void* data, size_t size, uint64_t timestampNanos);
+
+  template <typename T>
+  void Record(uint32_t stream, const T& sample) {
+    static_assert(std::is_trivially_copyable<T>::value, "Samples are recorded as raw bytes.");
+    Record(stream, &sample, sizeof(T));
+  }
+
+  // Writes out buffered samples. Returns false if any write failed.
+  bool Flush();
+
+  bool HasError() const {
+    return Failed;
+  }
+
+ private:
+  enum { BufferSize = 65536 };
+
+  void writeRecord(uint64_t timestampNanos, uint32_t stream, const void* data, size_t size);
+  void writeRaw(const void* data, size_t size);
+  void flushBuffer();
+
+  Lock RecordLock;
+  Ptr<File> pFile;
+  bool Failed;
+  uint32_t StreamCount;
+  size_t BufferUsed;
+  uint8_t Buffer[BufferSize];
+
+  OVR_NON_COPYABLE(TimeRecorder);
+};
+
+//-----------------------------------------------------------------------------
+// ***** TimeReplayer
+//
+// Replays a recording made by TimeRecorder, calling each stream's handler with its samples in
+// order. Before each sample is handled, the Timer virtual time is set to its timestamp, so
+// code downstream which timestamps or filters by Timer::GetVirtualTicksNanos sees the recorded
+// times. The timestamps are rebased so that the virtual time starts from the time the replay
+// began, and never runs backward. Given the same recording, a replay is deterministic
+// regardless of the speed it runs at, apart from that base, which makes it suitable for
+// benchmarking and regression testing processing pipelines without hardware.
+//
+// Replays run on the calling thread, either paced relative to the recorded times or as fast
+// as the handlers allow. Real time is restored when the replayer is destroyed.
+//
+// Example usage, replaying head poses at 100 times the recorded rate:
+//     TimeReplayer replayer(file);
+//     replayer.SetHandler("HeadPose", TimeReplayer::SampleFunc::FromMember<Filter,
+//                         &Filter::OnPoseSample>(&filter));
+//     if (!replayer.Run(100.0))
+//       ... replayer.GetError() ...
+//
+//     void Filter::OnPoseSample(const void* data, size_t size) {
+//       HeadPoseInfo pose;
+//       if (TimeReplayer::GetSample(data, size, pose))
+//         ...
+//     }
+
+class TimeReplayer {
+ public:
+  typedef Delegate<void(const void*, size_t)> SampleFunc;
+
+  TimeReplayer(File* file);
+  ~TimeReplayer();
+
+  // Sets the handler for the samples of a stream. Samples of streams without handlers are
+  // skipped.
+  void SetHandler(const char* streamName, SampleFunc handler);
+
+  // Replays samples until the end of the recording, or a call to Stop from another thread.
+  // speed is the replay rate relative to the recorded one; 0 replays without pacing. Returns
+  // false on a read error or a malformed recording.
+  bool Run(double speed = 0.0);
+
+  // Replays the next sample without pacing. Returns false at the end of the recording or on
+  // error.
+  bool Step();
+
+  // Stops the current Run, or the next one if none is running.
+  void Stop() {
+    Stopped.store(true, std::memory_order_relaxed);
+  }
+
+  bool IsAtEnd() const {
+    return AtEnd;
+  }
+
+  // Null if the replay hasn't failed.
+  const char* GetError() const {
+    return Error;
+  }
+
+  // Number of samples replayed so far, including those without handlers.
+  uint64_t GetSampleCount() const {
+    return SampleCount;
+  }
+
+  // Recorded timestamp of the last sample replayed.
+  uint64_t GetTimestampNanos() const {
+    return LastTimestampNanos;
+  }
+
+  // Copies a sample into a trivially copyable value, checking its size.
+  template <typename T>
+  static bool GetSample(const void* data, size_t size, T& sample) {
+    static_assert(std::is_trivially_copyable<T>::value, "Samples are recorded as raw bytes.");
+    if (size != sizeof(T))
+      return false;
+    memcpy(&sample, data, sizeof(T));
+    return true;
+  }
+
+ private:
+  struct Handler {
+    String StreamName;
+    SampleFunc Func;
+  };
+
+  bool fail(const char* error);
+  bool readExact(void* data, size_t size, bool allowEnd);
+  bool readRecord(uint64_t& timestampNanos, uint32_t& stream);
+  void replayRecord(uint64_t timestampNanos, uint32_t stream);
+
+  Ptr<File> pFile;
+  Array<Handler> Handlers;
+  Array<String> StreamNames; // By stream id.
+  ArrayPOD<int> StreamHandlers; // Index in Handlers for each stream id, or -1.
+  ArrayPOD<uint8_t> Payload;
+  bool HeaderRead;
+  bool AtEnd;
+  bool DrivingClock; // The replay set the Timer virtual time.
+  const char* Error;
+  uint64_t SampleCount;
+  uint64_t LastTimestampNanos;
+  uint64_t FirstTimestampNanos; // Recorded timestamp of the first sample replayed.
+  uint64_t BaseNanos; // Virtual time of the first sample replayed.
+  std::atomic<bool> Stopped;
+
+  OVR_NON_COPYABLE(TimeReplayer);
+};
+
+} // namespace OVR
+
+#endif // OVR_TimeRecording_h
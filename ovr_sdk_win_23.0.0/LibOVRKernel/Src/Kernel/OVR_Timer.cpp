@@ -35,7 +35,14 @@ limitations under the License.
 #include <android/log.h>
 #include <time.h>
 #else
+#include <atomic>
 #include <chrono>
+#include <thread>
+#if defined(OVR_CPU_X86_64) && (defined(__GNUC__) || defined(__clang__))
+#include <cpuid.h>
+#include <x86intrin.h>
+#define OVR_TIMER_TSC_AVAILABLE
+#endif
 #endif
 
 #if defined(OVR_BUILD_DEBUG) && defined(OVR_OS_WIN32)
@@ -58,8 +65,8 @@ double ovr_GetTimeInSeconds() {
 namespace OVR {
 
 // For recorded data playback
-bool Timer::useVirtualSeconds = false;
-double Timer::VirtualSeconds = 0.0;
+std::atomic<bool> Timer::useVirtualSeconds = {false};
+std::atomic<uint64_t> Timer::VirtualTicksNanos = {0};
 
 //------------------------------------------------------------------------
 // *** Android Specific Timer
@@ -72,8 +79,8 @@ double Timer::VirtualSeconds = 0.0;
 
 // Returns global high-resolution application timer in seconds.
 double Timer::GetSeconds() {
-  if (useVirtualSeconds)
-    return VirtualSeconds;
+  if (useVirtualSeconds.load(std::memory_order_acquire))
+    return getVirtualSeconds();
 
   // Choreographer vsync timestamp is based on.
   struct timespec tp;
@@ -91,9 +98,13 @@ double Timer::GetSeconds() {
 }
 
 uint64_t Timer::GetTicksNanos() {
-  if (useVirtualSeconds)
-    return (uint64_t)(VirtualSeconds * NanosPerSecond);
+  if (useVirtualSeconds.load(std::memory_order_acquire))
+    return VirtualTicksNanos.load(std::memory_order_relaxed);
+
+  return GetRealTicksNanos();
+}
 
+uint64_t Timer::GetRealTicksNanos() {
   // Choreographer vsync timestamp is based on.
   struct timespec tp;
   const int status = clock_gettime(CLOCK_MONOTONIC, &tp);
@@ -111,6 +122,28 @@ uint64_t Timer::GetTicksNanos() {
   return result;
 }
 
+double Timer::GetVirtualSeconds() {
+  if (useVirtualSeconds.load(std::memory_order_acquire))
+    return getVirtualSeconds();
+
+  return double(GetTicksNanos()) * (1.0 / NanosPerSecond);
+}
+
+uint64_t Timer::GetVirtualTicksNanos() {
+  if (useVirtualSeconds.load(std::memory_order_acquire))
+    return VirtualTicksNanos.load(std::memory_order_relaxed);
+
+  return GetTicksNanos();
+}
+
+bool Timer::SetClockSource(ClockSourceType source) {
+  return (source == ClockSource_System);
+}
+
+Timer::ClockSourceType Timer::GetClockSource() {
+  return ClockSource_System;
+}
+
 void Timer::initializeTimerSystem() {
   // Empty for this platform.
 }
@@ -353,16 +386,16 @@ double Timer::GetSeconds() {
 }
 
 double Timer::GetVirtualSeconds() {
-  if (useVirtualSeconds)
-    return VirtualSeconds;
+  if (useVirtualSeconds.load(std::memory_order_acquire))
+    return getVirtualSeconds();
 
   return Win32_PerfTimer.GetTimeSecondsDouble();
 }
 
 // Delegate to PerformanceTimer.
 uint64_t Timer::GetVirtualTicksNanos() {
-  if (useVirtualSeconds)
-    return (uint64_t)(VirtualSeconds * NanosPerSecond);
+  if (useVirtualSeconds.load(std::memory_order_acquire))
+    return VirtualTicksNanos.load(std::memory_order_relaxed);
 
   return Win32_PerfTimer.GetTimeNanos();
 }
@@ -371,6 +404,19 @@ uint64_t Timer::GetTicksNanos() {
   return Win32_PerfTimer.GetTimeNanos();
 }
 
+uint64_t Timer::GetRealTicksNanos() {
+  return Win32_PerfTimer.GetTimeNanos();
+}
+
+// QueryPerformanceCounter already reads the invariant TSC where there is one.
+bool Timer::SetClockSource(ClockSourceType source) {
+  return (source == ClockSource_System);
+}
+
+Timer::ClockSourceType Timer::GetClockSource() {
+  return ClockSource_System;
+}
+
 // Windows version also provides the performance frequency inverse.
 double Timer::GetPerfFrequencyInverse() {
   return Win32_PerfTimer.GetFrequencyInverse();
@@ -389,37 +435,343 @@ void Timer::shutdownTimerSystem() {
 
 #else // C++11 standard compliant platforms
 
-double Timer::GetSeconds() {
-  if (useVirtualSeconds)
-    return VirtualSeconds;
+// The clock which the TSC clock is calibrated against, and falls back to.
+static uint64_t GetSystemTicksNanos() {
+  using Uint64Nanoseconds = std::chrono::duration<uint64_t, std::chrono::nanoseconds::period>;
 
-  using FpSeconds = std::chrono::duration<double, std::chrono::seconds::period>;
+  auto now = std::chrono::steady_clock::now();
+  return Uint64Nanoseconds(now.time_since_epoch()).count();
+}
+
+#if defined(OVR_TIMER_TSC_AVAILABLE)
+
+// This helper class implements a clock that reads the CPU time stamp counter, which takes a
+// few nanoseconds where the system clock can take tens, or a system call under some
+// hypervisors. It's only used where the TSC is invariant, ticking at a constant rate in all
+// power states and in sync across cores.
+//
+// The TSC is converted to nanoseconds with a base and a 32.32 fixed point rate, which are
+// published with a sequence lock. The first reader after each CalibrationIntervalNanos
+// compares the result with the system clock and adjusts the rate to slew away the difference
+// over the next interval, so the clock tracks the system clock without stepping back. If the
+// TSC misbehaves, the clock disables itself and GetTicksNanos uses the system clock, offset so
+// that time doesn't go backward.
+struct TscTimer {
+  enum : uint64_t {
+    CalibrationIntervalNanos = 1000000000,
+    InitialCalibrationNanos = 2000000,
+    MaxSlewPerInterval = CalibrationIntervalNanos / 2000, // 500 ppm
+    MaxLargeSlewPerInterval = CalibrationIntervalNanos / 100, // For errors over MaxErrorNanos.
+    MaxErrorNanos = 10000000 // The system clock being further ahead is stepped to.
+  };
+
+  bool Initialize();
+
+  uint64_t GetTimeNanos() {
+    uint64_t tsc, nanos;
+    if (readNanos(tsc, nanos)) {
+      if (tsc < NextCalibrationTsc.load(std::memory_order_relaxed))
+        return nanos;
+
+      calibrate(tsc);
+      if (Available.load(std::memory_order_acquire) && readNanos(tsc, nanos))
+        return nanos;
+    }
+
+    disable();
+    return getSystemNanos();
+  }
+
+  // The system clock, plus the offset applied when the TSC is disabled.
+  uint64_t getSystemNanos() const {
+    return GetSystemTicksNanos() + SystemOffsetNanos.load(std::memory_order_relaxed);
+  }
+
+  // Reads the TSC and converts it to nanoseconds. Returns false if the TSC went backward.
+  bool readNanos(uint64_t& tsc, uint64_t& nanos) const;
+
+  uint64_t toNanos(uint64_t tsc) const;
+  void calibrate(uint64_t tsc);
+  void publish(uint64_t tscBase, uint64_t nanosBase, uint64_t multiplier);
+  void disable();
+
+  // Samples both clocks at as close to the same time as possible.
+  void sampleClocks(uint64_t& tsc, uint64_t& nanos) const;
+
+  std::atomic<bool> Enabled = {false}; // Used by GetTicksNanos.
+  std::atomic<bool> Available = {false}; // Calibrated and behaving.
+  std::atomic<uint64_t> SystemOffsetNanos = {0};
+
+  std::atomic<uint32_t> Sequence = {0}; // Odd while the following are being written.
+  std::atomic<uint64_t> TscBase = {0};
+  std::atomic<uint64_t> NanosBase = {0};
+  std::atomic<uint64_t> Multiplier = {0}; // Nanoseconds per tick, in 32.32 fixed point.
 
-  auto now = std::chrono::high_resolution_clock::now();
-  return FpSeconds(now.time_since_epoch()).count();
+  std::atomic<uint64_t> NextCalibrationTsc = {UINT64_MAX};
+  std::atomic<bool> Calibrating = {false};
+
+  // Used by the calibrating thread only.
+  uint64_t RefTsc = 0;
+  uint64_t RefNanos = 0;
+  uint64_t MeasuredMultiplier = 0; // The last measured rate, before slewing.
+};
+
+static TscTimer Posix_TscTimer;
+
+void TscTimer::sampleClocks(uint64_t& tsc, uint64_t& nanos) const {
+  // Keep the sample which was least likely to be interrupted between the TSC reads.
+  uint64_t bestSpan = UINT64_MAX;
+  for (int i = 0; i < 5; ++i) {
+    const uint64_t before = __rdtsc();
+    const uint64_t systemNanos = getSystemNanos();
+    const uint64_t after = __rdtsc();
+    if ((after >= before) && (after - before < bestSpan)) {
+      bestSpan = after - before;
+      tsc = before + (after - before) / 2;
+      nanos = systemNanos;
+    }
+  }
 }
 
-double Timer::GetVirtualSeconds() {
-  if (useVirtualSeconds)
-    return VirtualSeconds;
+bool TscTimer::Initialize() {
+  unsigned eax, ebx, ecx, edx;
+  if (!__get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) || !(edx & (1u << 8)))
+    return false; // No invariant TSC.
+
+  uint64_t tsc0 = 0, nanos0 = 0, tsc1 = 0, nanos1 = 0;
+  sampleClocks(tsc0, nanos0);
+  std::this_thread::sleep_for(std::chrono::nanoseconds(InitialCalibrationNanos));
+  sampleClocks(tsc1, nanos1);
+
+  if ((tsc1 <= tsc0) || (nanos1 <= nanos0))
+    return false;
+
+  // Reject rates outside of 100 MHz to 10 GHz.
+  const uint64_t multiplier =
+      uint64_t(((unsigned __int128)(nanos1 - nanos0) << 32) / (tsc1 - tsc0));
+  if ((multiplier < (uint64_t(1) << 32) / 10) || (multiplier > (uint64_t(10) << 32)))
+    return false;
+
+  RefTsc = tsc1;
+  RefNanos = nanos1;
+  MeasuredMultiplier = multiplier;
+  publish(tsc1, nanos1, multiplier);
+  NextCalibrationTsc.store(
+      tsc1 + uint64_t(((unsigned __int128)CalibrationIntervalNanos << 32) / multiplier),
+      std::memory_order_relaxed);
+  Available.store(true, std::memory_order_relaxed);
+  return true;
+}
+
+void TscTimer::publish(uint64_t tscBase, uint64_t nanosBase, uint64_t multiplier) {
+  const uint32_t sequence = Sequence.load(std::memory_order_relaxed);
+  Sequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  TscBase.store(tscBase, std::memory_order_relaxed);
+  NanosBase.store(nanosBase, std::memory_order_relaxed);
+  Multiplier.store(multiplier, std::memory_order_relaxed);
+
+  Sequence.store(sequence + 2, std::memory_order_release);
+}
+
+bool TscTimer::readNanos(uint64_t& tsc, uint64_t& nanos) const {
+  for (;;) {
+    const uint32_t sequence = Sequence.load(std::memory_order_acquire);
+    const uint64_t tscBase = TscBase.load(std::memory_order_relaxed);
+    const uint64_t nanosBase = NanosBase.load(std::memory_order_relaxed);
+    const uint64_t multiplier = Multiplier.load(std::memory_order_relaxed);
+
+    // The TSC is read after the base, so it's behind the base only if the TSC went backward,
+    // or by a few ticks if it's read early by out of order execution.
+    tsc = __rdtsc();
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (((sequence & 1) == 0) && (Sequence.load(std::memory_order_relaxed) == sequence)) {
+      if (tsc >= tscBase) {
+        nanos = nanosBase + uint64_t(((unsigned __int128)(tsc - tscBase) * multiplier) >> 32);
+        return true;
+      }
 
-  using FpSeconds = std::chrono::duration<double, std::chrono::seconds::period>;
+      nanos = nanosBase; // Never less than the base, which may already have been returned.
+      return (((unsigned __int128)(tscBase - tsc) * multiplier) >> 32) < MaxErrorNanos;
+    }
+  }
+}
+
+uint64_t TscTimer::toNanos(uint64_t tsc) const {
+  for (;;) {
+    const uint32_t sequence = Sequence.load(std::memory_order_acquire);
+    const uint64_t tscBase = TscBase.load(std::memory_order_relaxed);
+    const uint64_t nanosBase = NanosBase.load(std::memory_order_relaxed);
+    const uint64_t multiplier = Multiplier.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (((sequence & 1) == 0) && (Sequence.load(std::memory_order_relaxed) == sequence)) {
+      // The TSC can be behind the base if it was read before a recalibration.
+      if (tsc >= tscBase)
+        return nanosBase + uint64_t(((unsigned __int128)(tsc - tscBase) * multiplier) >> 32);
+      return nanosBase - uint64_t(((unsigned __int128)(tscBase - tsc) * multiplier) >> 32);
+    }
+  }
+}
+
+void TscTimer::calibrate(uint64_t tsc) {
+  if (Calibrating.exchange(true, std::memory_order_acquire))
+    return; // Another thread is at it.
+
+  if (tsc < NextCalibrationTsc.load(std::memory_order_relaxed)) {
+    Calibrating.store(false, std::memory_order_release);
+    return;
+  }
+
+  uint64_t sampleTsc = 0, systemNanos = 0;
+  sampleClocks(sampleTsc, systemNanos);
+  const uint64_t clockNanos = toNanos(sampleTsc);
+
+  // The rate over the last interval, measured against the system clock.
+  const bool sane = (sampleTsc > RefTsc) && (systemNanos > RefNanos);
+  const uint64_t measured = sane
+      ? uint64_t(((unsigned __int128)(systemNanos - RefNanos) << 32) / (sampleTsc - RefTsc))
+      : 0;
+  // Compared with the last measured rate, as the published one includes the slew.
+  const uint64_t current = MeasuredMultiplier;
+
+  // A rate change of over 1% means the TSC was reset or isn't invariant after all, such as
+  // after a suspend on some systems, or a VM migration.
+  if (!sane || (measured < current - current / 100) || (measured > current + current / 100)) {
+    disable();
+    Calibrating.store(false, std::memory_order_release);
+    return;
+  }
+
+  const int64_t error = int64_t(systemNanos - clockNanos);
+
+  if (error > int64_t(MaxErrorNanos)) {
+    publish(sampleTsc, systemNanos, measured); // Stepping forward is safe.
+  } else {
+    // Run fast or slow by the error over the next interval, within the slew limit. Being
+    // ahead of the system clock is never stepped back, as times already returned would be
+    // repeated, but a large error is slewed faster.
+    const int64_t maxSlew = (error < -int64_t(MaxErrorNanos)) ? int64_t(MaxLargeSlewPerInterval)
+                                                                : int64_t(MaxSlewPerInterval);
+    int64_t slew = error;
+    if (slew > maxSlew)
+      slew = maxSlew;
+    else if (slew < -maxSlew)
+      slew = -maxSlew;
+    const uint64_t adjusted = uint64_t(
+        ((unsigned __int128)measured * uint64_t(int64_t(CalibrationIntervalNanos) + slew)) /
+        CalibrationIntervalNanos);
+
+    // The new rate starts from the current time, so that the clock doesn't go backward for
+    // readers that used the old rate since sampleTsc.
+    const uint64_t publishTsc = __rdtsc();
+    publish(publishTsc, toNanos(publishTsc), adjusted);
+  }
+
+  RefTsc = sampleTsc;
+  RefNanos = systemNanos;
+  MeasuredMultiplier = measured;
+  NextCalibrationTsc.store(
+      sampleTsc + uint64_t(((unsigned __int128)CalibrationIntervalNanos << 32) / measured),
+      std::memory_order_relaxed);
+  Calibrating.store(false, std::memory_order_release);
+}
+
+void TscTimer::disable() {
+  // Times up to the end of the current calibration interval may have been returned, so the
+  // system clock is offset to continue from no earlier than that. A reader that saw the
+  // interval's end before calibrating can be a little past it, hence the margin.
+  const uint64_t nextCalibrationTsc = NextCalibrationTsc.load(std::memory_order_relaxed);
+  if (nextCalibrationTsc != UINT64_MAX) {
+    const uint64_t intervalEndNanos = toNanos(nextCalibrationTsc) + MaxErrorNanos;
+    const uint64_t systemNanos = getSystemNanos();
+
+    if (intervalEndNanos > systemNanos) {
+      const uint64_t offset = SystemOffsetNanos.load(std::memory_order_relaxed) +
+          (intervalEndNanos - systemNanos);
+      uint64_t current = SystemOffsetNanos.load(std::memory_order_relaxed);
+      while ((current < offset) &&
+             !SystemOffsetNanos.compare_exchange_weak(current, offset, std::memory_order_relaxed))
+        ;
+    }
+  }
+
+  Available.store(false, std::memory_order_release);
+  Enabled.store(false, std::memory_order_release);
+  NextCalibrationTsc.store(UINT64_MAX, std::memory_order_relaxed);
+}
+
+#endif // OVR_TIMER_TSC_AVAILABLE
+
+double Timer::GetSeconds() {
+  if (useVirtualSeconds.load(std::memory_order_acquire))
+    return getVirtualSeconds();
 
-  auto now = std::chrono::high_resolution_clock::now();
-  return FpSeconds(now.time_since_epoch()).count();
+  return double(GetTicksNanos()) * (1.0 / NanosPerSecond);
+}
+
+double Timer::GetVirtualSeconds() {
+  if (useVirtualSeconds.load(std::memory_order_acquire))
+    return getVirtualSeconds();
+
+  return double(GetTicksNanos()) * (1.0 / NanosPerSecond);
 }
 
 uint64_t Timer::GetTicksNanos() {
-  if (useVirtualSeconds)
-    return (uint64_t)(VirtualSeconds * NanosPerSecond);
+  if (useVirtualSeconds.load(std::memory_order_acquire))
+    return VirtualTicksNanos.load(std::memory_order_relaxed);
 
-  using Uint64Nanoseconds = std::chrono::duration<uint64_t, std::chrono::nanoseconds::period>;
+  return GetRealTicksNanos();
+}
 
-  auto now = std::chrono::high_resolution_clock::now();
-  return Uint64Nanoseconds(now.time_since_epoch()).count();
+uint64_t Timer::GetRealTicksNanos() {
+#if defined(OVR_TIMER_TSC_AVAILABLE)
+  if (Posix_TscTimer.Enabled.load(std::memory_order_acquire))
+    return Posix_TscTimer.GetTimeNanos();
+  return Posix_TscTimer.getSystemNanos();
+#else
+  return GetSystemTicksNanos();
+#endif
+}
+
+uint64_t Timer::GetVirtualTicksNanos() {
+  if (useVirtualSeconds.load(std::memory_order_acquire))
+    return VirtualTicksNanos.load(std::memory_order_relaxed);
+
+  return GetTicksNanos();
+}
+
+bool Timer::SetClockSource(ClockSourceType source) {
+#if defined(OVR_TIMER_TSC_AVAILABLE)
+  if (source == ClockSource_TSC) {
+    if (!Posix_TscTimer.Available.load(std::memory_order_relaxed))
+      return false;
+    Posix_TscTimer.Enabled.store(true, std::memory_order_relaxed);
+    return true;
+  }
+  Posix_TscTimer.Enabled.store(false, std::memory_order_relaxed);
+  return true;
+#else
+  return (source == ClockSource_System);
+#endif
 }
 
-void Timer::initializeTimerSystem() {}
+Timer::ClockSourceType Timer::GetClockSource() {
+#if defined(OVR_TIMER_TSC_AVAILABLE)
+  if (Posix_TscTimer.Enabled.load(std::memory_order_relaxed))
+    return ClockSource_TSC;
+#endif
+  return ClockSource_System;
+}
+
+void Timer::initializeTimerSystem() {
+#if defined(OVR_TIMER_TSC_AVAILABLE)
+  if (!Posix_TscTimer.Available.load(std::memory_order_relaxed) && Posix_TscTimer.Initialize())
+    Posix_TscTimer.Enabled.store(true, std::memory_order_relaxed);
+#endif
+}
 
 void Timer::shutdownTimerSystem() {}
 
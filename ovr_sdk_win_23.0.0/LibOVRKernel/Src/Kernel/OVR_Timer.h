@@ -28,6 +28,7 @@ limitations under the License.
 #ifndef OVR_Timer_h
 #define OVR_Timer_h
 
+#include <atomic>
 #include <chrono>
 #include "OVR_Types.h"
 
@@ -47,6 +48,11 @@ class Timer {
     NanosPerSecond = 1000 * 1000 * 1000, // Nanoseconds in one second.
   };
 
+  enum ClockSourceType {
+    ClockSource_System, // The OS monotonic clock.
+    ClockSource_TSC // The CPU time stamp counter, calibrated against the OS clock.
+  };
+
   // ***** Timing APIs for Application
 
   // These APIs should be used to guide animation and other program functions
@@ -64,6 +70,20 @@ class Timer {
   // This may return a recorded time if Replaying a recording
   static uint64_t OVR_STDCALL GetVirtualTicksNanos();
 
+  // As GetTicksNanos, but never returns a recorded time. Used for scheduling and timeouts,
+  // such as by the LongPollThread and WatchDog, which must keep running in real time during
+  // a replay.
+  static uint64_t OVR_STDCALL GetRealTicksNanos();
+
+  // Selects the clock behind GetTicksNanos and GetSeconds, and returns false if it isn't
+  // available. On x86-64 Linux and Mac, the TSC clock is selected at startup if the CPU has an
+  // invariant TSC. It reads in a few nanoseconds, and is recalibrated against the OS clock
+  // each second, slewing rather than stepping to stay in sync with it. If the TSC is found to
+  // be unreliable, the OS clock is selected instead. Elsewhere only the OS clock is available,
+  // which on Windows is already TSC based where possible.
+  static bool SetClockSource(ClockSourceType source);
+  static ClockSourceType GetClockSource();
+
 #ifdef OVR_OS_MS
   static double OVR_STDCALL GetPerfFrequencyInverse();
 
@@ -84,8 +104,19 @@ class Timer {
 
   // for recorded data playback
   static void SetVirtualSeconds(double virtualSeconds, bool enable = true) {
-    VirtualSeconds = virtualSeconds;
-    useVirtualSeconds = enable;
+    SetVirtualTicksNanos(
+        (virtualSeconds > 0.0) ? uint64_t(virtualSeconds * NanosPerSecond) : 0, enable);
+  }
+
+  // Sets the virtual time exactly, for deterministic replays (see TimeReplayer). The virtual
+  // time can be set from any thread while others read it.
+  static void SetVirtualTicksNanos(uint64_t virtualNanos, bool enable = true) {
+    VirtualTicksNanos.store(virtualNanos, std::memory_order_relaxed);
+    useVirtualSeconds.store(enable, std::memory_order_release);
+  }
+
+  static bool IsVirtualTimeEnabled() {
+    return useVirtualSeconds.load(std::memory_order_relaxed);
   }
 
  private:
@@ -95,8 +126,12 @@ class Timer {
   static void shutdownTimerSystem();
 
   // for recorded data playback.
-  static double VirtualSeconds;
-  static bool useVirtualSeconds;
+  static std::atomic<uint64_t> VirtualTicksNanos;
+  static std::atomic<bool> useVirtualSeconds;
+
+  static double getVirtualSeconds() {
+    return double(VirtualTicksNanos.load(std::memory_order_relaxed)) * (1.0 / NanosPerSecond);
+  }
 
 #if defined(OVR_OS_ANDROID)
 // Android-specific data
@@ -27,6 +27,7 @@ limitations under the License.
 ************************************************************************************/
 
 #include "OVR_UTF8Util.h"
+#include "OVR_Std.h"
 #include <string.h>
 #include <wchar.h>
 
@@ -50,14 +51,35 @@ limitations under the License.
 namespace OVR {
 namespace UTF8Util {
 
+// The functions below handle runs of 7-bit ASCII chars with OVR_asciispan, which checks
+// 16 or 32 chars per instruction, and copy or count them in bulk. Only the non-ASCII
+// chars go through EncodeChar/DecodeNextChar_Advance0, so the results are identical.
+
 size_t Strlcpy(char* pDestUTF8, size_t destCharCount, const wchar_t* pSrcUCS, size_t sourceLength) {
   if (sourceLength == (size_t)-1)
     sourceLength = wcslen(pSrcUCS);
 
   size_t destLength = 0;
 
-  size_t i;
-  for (i = 0; i < sourceLength; ++i) {
+  size_t i = 0;
+  while (i < sourceLength) {
+    const size_t asciiCount = OVR_asciispan(pSrcUCS + i, sourceLength - i);
+
+    if (asciiCount) {
+      // Leave room for the trailing '\0'.
+      const size_t room = (destLength < destCharCount) ? (destCharCount - 1 - destLength) : 0;
+      const size_t copyCount = (asciiCount < room) ? asciiCount : room;
+
+      for (size_t j = 0; j < copyCount; ++j)
+        pDestUTF8[destLength + j] = (char)pSrcUCS[i + j];
+      destLength += copyCount;
+      i += copyCount;
+
+      if (copyCount < asciiCount) // If we ran out of space...
+        break;
+      continue;
+    }
+
     char buff[6]; // longest utf8 encoding just to be safe
     intptr_t count = 0;
 
@@ -70,6 +92,7 @@ size_t Strlcpy(char* pDestUTF8, size_t destCharCount, const wchar_t* pSrcUCS, si
 
     memcpy(pDestUTF8 + destLength, buff, count);
     destLength += (size_t)count;
+    ++i;
   }
 
   // Should be true for all cases other than destCharCount == 0.
@@ -80,8 +103,13 @@ size_t Strlcpy(char* pDestUTF8, size_t destCharCount, const wchar_t* pSrcUCS, si
   // Note a very long wchar string with lots of multibyte encodings can overflow destLength
   // This should be okay since we'll just treat those cases (likely to be originating
   // from an attacker) as shorter strings
-  while (i < sourceLength)
-    destLength += GetEncodeCharSize(pSrcUCS[i++]);
+  while (i < sourceLength) {
+    const size_t asciiCount = OVR_asciispan(pSrcUCS + i, sourceLength - i);
+    destLength += asciiCount;
+    i += asciiCount;
+    if (i < sourceLength)
+      destLength += GetEncodeCharSize(pSrcUCS[i++]);
+  }
 
   // Return the intended strlen of pDestUTF8.
   return destLength;
@@ -94,6 +122,20 @@ size_t Strlcpy(wchar_t* pDestUCS, size_t destCharCount, const char* pSrcUTF8, si
   size_t destLength = 0, requiredLength = 0;
 
   for (const char* pSrcUTF8End = (pSrcUTF8 + sourceLength); pSrcUTF8 < pSrcUTF8End;) {
+    const size_t asciiCount = OVR_asciispan(pSrcUTF8, (size_t)(pSrcUTF8End - pSrcUTF8));
+
+    if (asciiCount) {
+      const size_t room = (destLength < destCharCount) ? (destCharCount - 1 - destLength) : 0;
+      const size_t copyCount = (asciiCount < room) ? asciiCount : room;
+
+      for (size_t j = 0; j < copyCount; ++j)
+        pDestUCS[destLength + j] = (wchar_t)pSrcUTF8[j];
+      destLength += copyCount;
+      requiredLength += asciiCount;
+      pSrcUTF8 += asciiCount;
+      continue;
+    }
+
     uint32_t c = DecodeNextChar_Advance0(&pSrcUTF8);
     OVR_ASSERT_M(
         pSrcUTF8 <= (pSrcUTF8 + sourceLength), "Strlcpy sourceLength was not on a UTF8 boundary.");
@@ -125,24 +167,97 @@ intptr_t GetLength(const char* buf, intptr_t buflen) {
 
   if (buflen != -1) {
     while (p - buf < buflen) {
-      // We should be able to have ASStrings with 0 in the middle.
+      // Each ASCII byte is one character, including 0 bytes; we should be able to have
+      // ASStrings with 0 in the middle.
+      const size_t asciiCount = OVR_asciispan(p, (size_t)(buflen - (p - buf)));
+      if (asciiCount) {
+        length += (intptr_t)asciiCount;
+        p += asciiCount;
+        continue;
+      }
+
       UTF8Util::DecodeNextChar_Advance0(&p);
       length++;
     }
   } else {
-    while (UTF8Util::DecodeNextChar_Advance0(&p))
+    const char* pEnd = buf + strlen(buf);
+
+    for (;;) {
+      const size_t asciiCount = OVR_asciispan(p, (size_t)(pEnd - p));
+      length += (intptr_t)asciiCount;
+      p += asciiCount;
+
+      if (p >= pEnd || !UTF8Util::DecodeNextChar_Advance0(&p))
+        break;
       length++;
+    }
   }
 
   return length;
 }
 
+bool IsValid(const char* putf8str, intptr_t length) {
+  const uint8_t* p = (const uint8_t*)putf8str;
+  const uint8_t* pEnd = p + ((length == -1) ? strlen(putf8str) : (size_t)length);
+
+  while (p < pEnd) {
+    p += OVR_asciispan((const char*)p, (size_t)(pEnd - p));
+    if (p == pEnd)
+      break;
+
+    // Valid lead bytes, and the range of the byte following each, per RFC 3629 table 3-7.
+    const uint8_t c = *p;
+    size_t sequenceLength;
+    uint8_t secondMin = 0x80, secondMax = 0xBF;
+
+    if (c >= 0xC2 && c <= 0xDF)
+      sequenceLength = 2;
+    else if (c >= 0xE0 && c <= 0xEF) {
+      sequenceLength = 3;
+      if (c == 0xE0)
+        secondMin = 0xA0; // overlong
+      else if (c == 0xED)
+        secondMax = 0x9F; // surrogates
+    } else if (c >= 0xF0 && c <= 0xF4) {
+      sequenceLength = 4;
+      if (c == 0xF0)
+        secondMin = 0x90; // overlong
+      else if (c == 0xF4)
+        secondMax = 0x8F; // above U+10FFFF
+    } else
+      return false;
+
+    if ((size_t)(pEnd - p) < sequenceLength)
+      return false;
+    if (p[1] < secondMin || p[1] > secondMax)
+      return false;
+    for (size_t i = 2; i < sequenceLength; ++i) {
+      if ((p[i] & 0xC0) != 0x80)
+        return false;
+    }
+
+    p += sequenceLength;
+  }
+
+  return true;
+}
+
 uint32_t GetCharAt(intptr_t index, const char* putf8str, intptr_t length) {
   const char* buf = putf8str;
   uint32_t c = 0;
 
   if (length != -1) {
     while (buf - putf8str < length) {
+      const size_t asciiCount = OVR_asciispan(buf, (size_t)(length - (buf - putf8str)));
+      if (asciiCount) {
+        if ((size_t)index < asciiCount)
+          return (uint32_t)buf[index];
+        c = (uint32_t)buf[asciiCount - 1];
+        index -= (intptr_t)asciiCount;
+        buf += asciiCount;
+        continue;
+      }
+
       c = UTF8Util::DecodeNextChar_Advance0(&buf);
       if (index == 0)
         return c;
@@ -172,6 +287,16 @@ intptr_t GetByteIndex(intptr_t index, const char* putf8str, intptr_t byteLength)
   if (byteLength >= 0) {
     const char* lastValid = putf8str;
     while ((buf - putf8str) < byteLength && index > 0) {
+      size_t asciiCount = OVR_asciispan(buf, (size_t)(byteLength - (buf - putf8str)));
+      if (asciiCount) {
+        if ((size_t)index < asciiCount)
+          asciiCount = (size_t)index;
+        lastValid = buf + asciiCount - 1;
+        buf += asciiCount;
+        index -= (intptr_t)asciiCount;
+        continue;
+      }
+
       lastValid = buf;
       // XXX this may read up to 5 bytes past byteLength
       UTF8Util::DecodeNextChar_Advance0(&buf);
@@ -206,6 +331,15 @@ intptr_t GetByteIndexChecked(intptr_t index, const char* putf8str, intptr_t byte
 
   if (byteLength >= 0) {
     while ((buf - putf8str) < byteLength && index > 0) {
+      size_t asciiCount = OVR_asciispan(buf, (size_t)(byteLength - (buf - putf8str)));
+      if (asciiCount) {
+        if ((size_t)index < asciiCount)
+          asciiCount = (size_t)index;
+        buf += asciiCount;
+        index -= (intptr_t)asciiCount;
+        continue;
+      }
+
       // XXX this may read up to 5 bytes past byteLength
       UTF8Util::DecodeNextChar_Advance0(&buf);
       index--;
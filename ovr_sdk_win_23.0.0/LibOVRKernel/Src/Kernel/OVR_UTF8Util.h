@@ -84,6 +84,12 @@ size_t Strlcpy(
 // If source length is specified (in bytes), null 0 character is counted properly.
 intptr_t GetLength(const char* putf8str, intptr_t length = -1);
 
+// Returns true if the string is well-formed UTF-8 as defined by RFC 3629: no invalid or
+// truncated sequences, no overlong encodings, no surrogates (U+D800..U+DFFF) and nothing
+// above U+10FFFF. Runs of ASCII are checked 16 or 32 bytes at a time.
+// If length is -1 then the string is 0-terminated, otherwise 0 bytes are allowed.
+bool IsValid(const char* putf8str, intptr_t length = -1);
+
 // Gets a decoded UTF8 character at index; you can access up to the index returned
 // by GetLength. 0 will be returned for out of bounds access.
 uint32_t GetCharAt(intptr_t index, const char* putf8str, intptr_t length = -1);
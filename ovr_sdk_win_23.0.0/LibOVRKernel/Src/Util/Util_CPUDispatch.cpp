@@ -0,0 +1,185 @@
+/************************************************************************************
+
+Filename    :   Util_CPUDispatch.cpp
+Content     :   Runtime selection of SIMD implementations by CPU tier
+Created     :   October 18, 2026
+Notes       :
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+#include "Util_CPUDispatch.h"
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include "Kernel/OVR_Atomic.h"
+#include "Util_SystemInfo.h"
+
+namespace OVR {
+namespace Util {
+
+static const char* const CPUDispatchTierNames[] =
+    {"Scalar", "SSE2", "SSE41", "AVX2", "AVX512", "NEON"};
+static_assert(
+    OVR_ARRAY_COUNT(CPUDispatchTierNames) == (size_t)CPUDispatchTier::Count,
+    "CPUDispatchTierNames mismatch");
+
+const char* GetCPUDispatchTierName(CPUDispatchTier tier) {
+  if ((unsigned)tier < (unsigned)CPUDispatchTier::Count)
+    return CPUDispatchTierNames[(int)tier];
+  return "Unknown";
+}
+
+bool CPUDispatchTierIncludes(CPUDispatchTier tier, CPUDispatchTier required) {
+  if (required == CPUDispatchTier::Scalar)
+    return true;
+  if ((tier == CPUDispatchTier::NEON) || (required == CPUDispatchTier::NEON))
+    return (tier == required);
+  return (tier >= required);
+}
+
+static CPUDispatchTier DetectHostCPUDispatchTier() {
+#if defined(OVR_CPU_X86) || defined(OVR_CPU_X86_64)
+  switch (GetSupportedCPUInstructionSet(nullptr, nullptr)) {
+    case CPUInstructionSet::AVX512:
+      return CPUDispatchTier::AVX512;
+    case CPUInstructionSet::AVX2:
+      return CPUDispatchTier::AVX2;
+    case CPUInstructionSet::SSE41:
+    case CPUInstructionSet::SSE42:
+    case CPUInstructionSet::AVX1:
+      return CPUDispatchTier::SSE41;
+    case CPUInstructionSet::SSE2:
+    case CPUInstructionSet::SSE3:
+    case CPUInstructionSet::SSSE3:
+      return CPUDispatchTier::SSE2;
+    default:
+      return CPUDispatchTier::Scalar;
+  }
+#elif defined(__aarch64__) || defined(_M_ARM64) || defined(OVR_CPU_ARM_NEON)
+  // NEON is part of the ARMv8 baseline, and 32 bit builds only enable it for CPUs that have it.
+  return CPUDispatchTier::NEON;
+#else
+  return CPUDispatchTier::Scalar;
+#endif
+}
+
+CPUDispatchTier GetHostCPUDispatchTier() {
+  static const CPUDispatchTier hostTier = DetectHostCPUDispatchTier();
+  return hostTier;
+}
+
+bool IsCPUDispatchTierSupported(CPUDispatchTier tier) {
+  return ((unsigned)tier < (unsigned)CPUDispatchTier::Count) &&
+      CPUDispatchTierIncludes(GetHostCPUDispatchTier(), tier);
+}
+
+namespace {
+
+// Returns the host tier, or the supported tier named by OVR_CPU_DISPATCH_TIER. The name is
+// compared exactly rather than with OVR_stricmp, as that is itself dispatched.
+CPUDispatchTier GetStartupTier() {
+  const CPUDispatchTier hostTier = GetHostCPUDispatchTier();
+  const char* name = getenv("OVR_CPU_DISPATCH_TIER");
+
+  if (name) {
+    for (int i = 0; i < (int)CPUDispatchTier::Count; i++) {
+      if ((strcmp(name, CPUDispatchTierNames[i]) == 0) &&
+          IsCPUDispatchTierSupported((CPUDispatchTier)i))
+        return (CPUDispatchTier)i;
+    }
+  }
+
+  return hostTier;
+}
+
+struct CPUDispatchRegistry {
+  CPUDispatchRegistry() : pHead(nullptr), StartupTier(GetStartupTier()), Tier(StartupTier) {}
+
+  Lock RegistryLock; // Protects the list, and serializes binding.
+  CPUDispatchBinding* pHead;
+  const CPUDispatchTier StartupTier;
+  std::atomic<CPUDispatchTier> Tier;
+};
+
+// Constructed on first use. Bindings construct it while registering, so it outlives them.
+CPUDispatchRegistry& GetRegistry() {
+  static CPUDispatchRegistry registry;
+  return registry;
+}
+
+} // namespace
+
+CPUDispatchTier GetCPUDispatchTier() {
+  return GetRegistry().Tier.load(std::memory_order_acquire);
+}
+
+bool SetCPUDispatchTier(CPUDispatchTier tier) {
+  if (!IsCPUDispatchTierSupported(tier))
+    return false;
+
+  CPUDispatchRegistry& registry = GetRegistry();
+  Lock::Locker locker(&registry.RegistryLock);
+
+  registry.Tier.store(tier, std::memory_order_release);
+  for (CPUDispatchBinding* binding = registry.pHead; binding; binding = binding->pNext)
+    binding->Bind(tier);
+
+  return true;
+}
+
+void ResetCPUDispatchTier() {
+  SetCPUDispatchTier(GetRegistry().StartupTier);
+}
+
+//-----------------------------------------------------------------------------
+// CPUDispatchBinding
+
+void CPUDispatchBinding::Register() {
+  CPUDispatchRegistry& registry = GetRegistry();
+  Lock::Locker locker(&registry.RegistryLock);
+
+  if (!Registered) {
+    Bind(registry.Tier.load(std::memory_order_relaxed));
+    pNext = registry.pHead;
+    registry.pHead = this;
+    Registered = true;
+  }
+}
+
+void CPUDispatchBinding::Unregister() {
+  if (!Registered)
+    return;
+
+  CPUDispatchRegistry& registry = GetRegistry();
+  Lock::Locker locker(&registry.RegistryLock);
+
+  for (CPUDispatchBinding** link = &registry.pHead; *link; link = &(*link)->pNext) {
+    if (*link == this) {
+      *link = pNext;
+      break;
+    }
+  }
+
+  pNext = nullptr;
+  Registered = false;
+}
+
+} // namespace Util
+} // namespace OVR
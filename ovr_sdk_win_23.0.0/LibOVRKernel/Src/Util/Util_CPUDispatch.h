@@ -0,0 +1,172 @@
+/************************************************************************************
+
+Filename    :   Util_CPUDispatch.h
+Content     :   Runtime selection of SIMD implementations by CPU tier
+Created     :   October 18, 2026
+Notes       :
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+#ifndef OVR_Util_CPUDispatch_h
+#define OVR_Util_CPUDispatch_h
+
+#include "Kernel/OVR_Types.h"
+
+// GCC and clang only allow vector intrinsics beyond the compiler's baseline in functions
+// compiled for them. MSVC allows them anywhere.
+#if defined(OVR_CC_MSVC) || !(defined(OVR_CPU_X86) || defined(OVR_CPU_X86_64))
+#define OVR_CPU_TARGET_SSE41
+#define OVR_CPU_TARGET_AVX2
+#define OVR_CPU_TARGET_AVX512
+#else
+#define OVR_CPU_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define OVR_CPU_TARGET_AVX2 __attribute__((target("avx2")))
+#define OVR_CPU_TARGET_AVX512 \
+  __attribute__((target("avx2,avx512f,avx512cd,avx512bw,avx512dq,avx512vl")))
+#endif
+
+namespace OVR {
+namespace Util {
+
+// CPUDispatchTier is a set of vector instructions which kernels may have an implementation for.
+// Each x86 tier includes the tiers below it. NEON includes only Scalar.
+enum class CPUDispatchTier {
+  Scalar,
+  SSE2,
+  SSE41,
+  AVX2,
+  AVX512, // AVX-512 F, CD, BW, DQ and VL, as for CPUInstructionSet::AVX512.
+  NEON,
+  Count
+};
+
+// Returns a name such as "AVX2", as accepted by the OVR_CPU_DISPATCH_TIER variable.
+const char* GetCPUDispatchTierName(CPUDispatchTier tier);
+
+// Returns true if code written for the required tier can run at the given tier.
+bool CPUDispatchTierIncludes(CPUDispatchTier tier, CPUDispatchTier required);
+
+// Returns the highest tier which the CPU and OS support, and which this build has code for.
+CPUDispatchTier GetHostCPUDispatchTier();
+
+// Returns true if the host can run code written for the given tier.
+bool IsCPUDispatchTierSupported(CPUDispatchTier tier);
+
+// Returns the tier which CPUDispatchTables bind to. This is the host tier unless it was
+// lowered by SetCPUDispatchTier, or by setting the OVR_CPU_DISPATCH_TIER environment variable
+// to a tier name before the first call.
+CPUDispatchTier GetCPUDispatchTier();
+
+// Rebinds every CPUDispatchTable to the given tier, so that tests can check each
+// implementation against the scalar one on a single machine. Returns false, and changes
+// nothing, if the host doesn't support the tier. This must not be called while other threads
+// may be using the kernels, as tables are rebound in place.
+bool SetCPUDispatchTier(CPUDispatchTier tier);
+
+// Returns to the tier which was in effect at startup.
+void ResetCPUDispatchTier();
+
+//-----------------------------------------------------------------------------
+// CPUDispatchBinding
+//
+// Base of CPUDispatchTable. All live bindings are kept in a list so that SetCPUDispatchTier
+// can rebind them.
+
+class CPUDispatchBinding {
+ public:
+  CPUDispatchBinding() : pNext(nullptr), Registered(false) {}
+  virtual ~CPUDispatchBinding() {
+    Unregister();
+  }
+
+ protected:
+  // Binds to the current tier and adds this to the list. The binding and the insertion are
+  // atomic with respect to SetCPUDispatchTier.
+  void Register();
+  void Unregister();
+
+  virtual void Bind(CPUDispatchTier tier) = 0;
+
+ private:
+  friend bool SetCPUDispatchTier(CPUDispatchTier tier);
+
+  CPUDispatchBinding* pNext;
+  bool Registered;
+
+  OVR_NON_COPYABLE(CPUDispatchBinding);
+};
+
+//-----------------------------------------------------------------------------
+// CPUDispatchTable
+//
+// Holds a struct of function pointers which is selected for the current tier on construction
+// and again on each SetCPUDispatchTier call. The select function fills in the best
+// implementation of each function for the tier, testing for tiers with CPUDispatchTierIncludes.
+// Calls through the table cost one indirect call, the same as calling through a function
+// pointer.
+//
+// Tables should be function-local statics, so that they're bound on first use, which is
+// thread-safe, and so that they can be used during static initialization.
+//
+// Example usage:
+//     static MathKernels SelectMathKernels(Util::CPUDispatchTier tier) {
+//       MathKernels kernels = {TransformScalar};
+//       if (Util::CPUDispatchTierIncludes(tier, Util::CPUDispatchTier::AVX2))
+//         kernels.Transform = TransformAVX2;
+//       return kernels;
+//     }
+//
+//     static const MathKernels& GetMathKernels() {
+//       static Util::CPUDispatchTable<MathKernels> table(SelectMathKernels);
+//       return table.Get();
+//     }
+
+template <typename Table>
+class CPUDispatchTable : public CPUDispatchBinding {
+ public:
+  typedef Table (*SelectFunc)(CPUDispatchTier tier);
+
+  explicit CPUDispatchTable(SelectFunc select) : Select(select), Value() {
+    Register();
+  }
+  ~CPUDispatchTable() {
+    // Unregistered here rather than in the base destructor, so that Bind isn't called on a
+    // partly destroyed table.
+    Unregister();
+  }
+
+  const Table& Get() const {
+    return Value;
+  }
+
+ protected:
+  void Bind(CPUDispatchTier tier) override {
+    Value = Select(tier);
+  }
+
+ private:
+  SelectFunc Select;
+  Table Value;
+};
+
+} // namespace Util
+} // namespace OVR
+
+#endif // OVR_Util_CPUDispatch_h
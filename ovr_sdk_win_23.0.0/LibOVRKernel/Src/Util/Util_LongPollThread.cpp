@@ -27,6 +27,15 @@ limitations under the License.
 
 #include "Util_LongPollThread.h"
 #include "Util_Watchdog.h"
+#include "Kernel/OVR_Alg.h"
+
+#if defined(OVR_OS_LINUX) || defined(OVR_OS_ANDROID)
+#include <errno.h>
+#include <poll.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#define OVR_TIMERFD_AVAILABLE
+#endif
 
 OVR_DEFINE_SINGLETON(OVR::Util::LongPollThread);
 
@@ -37,7 +46,11 @@ void LongPollThread::AddPollFunc(CallbackListener<PollFunc>* func) {
   PollSubject.AddListener(func);
 }
 
-LongPollThread::LongPollThread() : Terminated(false) {
+LongPollThread::LongPollThread()
+    : Terminated(false),
+      Timers(Timer::GetRealTicksNanos() / TimerTickNanos),
+      pRunningTimer(nullptr),
+      RunningGeneration(0) {
   LongPollThreadHandle = std::make_unique<std::thread>([this] { this->Run(); });
 
   // Must be at end of function
@@ -54,6 +67,143 @@ void LongPollThread::OnThreadDestroy() {
   LongPollThreadHandle->join();
 }
 
+void LongPollThread::ScheduleTimer(
+    PollTimer* timer,
+    PollFunc func,
+    uint64_t delayNanos,
+    uint64_t periodNanos) {
+  ScheduleTimerAt(timer, func, Timer::GetRealTicksNanos() + delayNanos, periodNanos);
+}
+
+void LongPollThread::ScheduleTimerAt(
+    PollTimer* timer,
+    PollFunc func,
+    uint64_t deadlineNanos,
+    uint64_t periodNanos) {
+  {
+    std::lock_guard<std::mutex> lock(TimerLock);
+    OVR_ASSERT(!timer->pScheduler || (timer->pScheduler == this));
+
+    Timers.Remove(timer);
+    timer->pScheduler = this;
+    timer->Func = func;
+    timer->PeriodTicks = (periodNanos + TimerTickNanos - 1) / TimerTickNanos;
+    timer->Generation++;
+    Timers.Insert(timer, (deadlineNanos + TimerTickNanos - 1) / TimerTickNanos);
+  }
+
+  TimersChanged.SetEvent();
+}
+
+void LongPollThread::cancelTimer(PollTimer* timer) {
+  std::unique_lock<std::mutex> lock(TimerLock);
+
+  Timers.Remove(timer);
+  timer->Generation++;
+
+  if (pRunningTimer == timer) {
+    if (std::this_thread::get_id() == LongPollThreadHandle->get_id()) {
+      // Cancelled by its own callback, after which the timer may be destroyed.
+      pRunningTimer = nullptr;
+    } else {
+      TimerDone.wait(lock, [this, timer] { return pRunningTimer != timer; });
+    }
+  }
+
+  timer->Func.Invalidate();
+}
+
+void LongPollThread::runTimers(uint64_t nowNanos) {
+  std::unique_lock<std::mutex> lock(TimerLock);
+  Timers.Advance(nowNanos / TimerTickNanos);
+
+  while (TimerWheel::Entry* entry = Timers.PopExpired()) {
+    PollTimer* timer = static_cast<PollTimer*>(entry);
+    const uint64_t expiryTick = entry->GetExpiryTick();
+    PollFunc func = timer->Func;
+    pRunningTimer = timer;
+    RunningGeneration = timer->Generation;
+
+    lock.unlock();
+    if (func.IsValid())
+      func();
+    lock.lock();
+
+    // Periodic timers go back on the wheel, unless the callback was cancelled or rescheduled
+    // while it ran.
+    if (pRunningTimer == timer) {
+      pRunningTimer = nullptr;
+
+      if ((timer->Generation == RunningGeneration) && (timer->PeriodTicks != 0)) {
+        const uint64_t period = timer->PeriodTicks;
+        const uint64_t currentTick = Timers.GetCurrentTick();
+        uint64_t nextTick = expiryTick + period;
+        if (nextTick <= currentTick)
+          nextTick += ((currentTick - nextTick) / period + 1) * period;
+        Timers.Insert(timer, nextTick);
+      }
+    }
+
+    TimerDone.notify_all();
+  }
+}
+
+uint64_t LongPollThread::getNextTimerNanos() {
+  std::lock_guard<std::mutex> lock(TimerLock);
+  const uint64_t tick = Timers.GetNextEventTick();
+  return (tick != UINT64_MAX) ? (tick * TimerTickNanos) : UINT64_MAX;
+}
+
+void LongPollThread::waitUntil(uint64_t deadlineNanos, int timerFd) {
+  const uint64_t now = Timer::GetRealTicksNanos();
+  if (deadlineNanos <= now)
+    return;
+  const uint64_t delay = deadlineNanos - now;
+
+#if defined(OVR_TIMERFD_AVAILABLE)
+  // The timerfd wakes us with sub-millisecond precision, where a poll timeout would round up
+  // to whole milliseconds.
+  const int wakeFd = WakeEvent.GetPollFd();
+  const int changedFd = TimersChanged.GetPollFd();
+
+  if ((timerFd >= 0) && (wakeFd >= 0) && (changedFd >= 0)) {
+    itimerspec spec = {};
+    spec.it_value.tv_sec = time_t(delay / 1000000000);
+    spec.it_value.tv_nsec = long(delay % 1000000000);
+
+    if (timerfd_settime(timerFd, 0, &spec, nullptr) == 0) {
+      pollfd fds[3] = {{timerFd, POLLIN, 0}, {wakeFd, POLLIN, 0}, {changedFd, POLLIN, 0}};
+      while ((poll(fds, 3, -1) < 0) && (errno == EINTR))
+        ;
+      return;
+    }
+  }
+#else
+  OVR_UNUSED(timerFd);
+#endif
+
+  Event* events[] = {&WakeEvent, &TimersChanged};
+  Event::WaitAny(events, 2, unsigned((delay + 999999) / 1000000));
+}
+
+void PollTimer::Cancel() {
+  if (pScheduler)
+    pScheduler->cancelTimer(this);
+}
+
+bool PollTimer::IsScheduled() const {
+  if (!pScheduler)
+    return false;
+
+  std::lock_guard<std::mutex> lock(pScheduler->TimerLock);
+  if (IsInserted())
+    return true;
+
+  // A periodic timer is off the wheel while its callback runs.
+  return (pScheduler->pRunningTimer == this) && (pScheduler->RunningGeneration == Generation) &&
+      (PeriodTicks != 0);
+}
+
 void LongPollThread::Wake() {
   WakeEvent.SetEvent();
 }
@@ -70,16 +220,41 @@ void LongPollThread::OnSystemDestroy() {
 void LongPollThread::Run() {
   Thread::SetCurrentThreadName("LongPoll");
   WatchDog watchdog("LongPoll");
+  unsigned attributesVersion = 0;
+  uint64_t nextPollNanos = 0;
+
+  int timerFd = -1;
+#if defined(OVR_TIMERFD_AVAILABLE)
+  timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+#endif
 
   // While not terminated,
   do {
+    Thread::UpdateBackgroundThreadAttributes(attributesVersion);
     watchdog.Feed(10000);
 
-    PollSubject.Call();
+    // Poll functions run every WakeupInterval, or right away after a Wake.
+    const uint64_t now = Timer::GetRealTicksNanos();
+    if (now >= nextPollNanos) {
+      PollSubject.Call();
+      nextPollNanos = now + uint64_t(WakeupInterval) * 1000000;
+    }
+
+    runTimers(Timer::GetRealTicksNanos());
 
-    WakeEvent.Wait(WakeupInterval);
-    WakeEvent.ResetEvent();
+    waitUntil(Alg::Min(nextPollNanos, getNextTimerNanos()), timerFd);
+
+    if (WakeEvent.Wait(0)) {
+      WakeEvent.ResetEvent();
+      nextPollNanos = 0;
+    }
+    TimersChanged.ResetEvent();
   } while (!Terminated.load(std::memory_order_acquire));
+
+#if defined(OVR_TIMERFD_AVAILABLE)
+  if (timerFd >= 0)
+    close(timerFd);
+#endif
 }
 
 } // namespace Util
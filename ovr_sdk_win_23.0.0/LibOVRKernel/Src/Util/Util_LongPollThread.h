@@ -26,6 +26,8 @@ limitations under the License.
 #ifndef OVR_Util_LongPollThread_h
 #define OVR_Util_LongPollThread_h
 
+#include <condition_variable>
+#include <mutex>
 #include <thread>
 #include "Kernel/OVR_Allocator.h"
 #include "Kernel/OVR_Atomic.h"
@@ -34,38 +36,118 @@ limitations under the License.
 #include "Kernel/OVR_System.h"
 #include "Kernel/OVR_Threads.h"
 #include "Kernel/OVR_Timer.h"
+#include "Util_TimerWheel.h"
 
 namespace OVR {
 namespace Util {
 
+class LongPollThread;
+
+//-----------------------------------------------------------------------------
+// PollTimer
+//
+// A callback scheduled on the LongPollThread with ScheduleTimer, to run once or periodically.
+// The timer is owned by the caller, and destroying it cancels it. Timers must be cancelled
+// before the LongPollThread singleton is destroyed at system shutdown.
+
+class PollTimer : private TimerWheel::Entry {
+ public:
+  PollTimer() : pScheduler(nullptr), PeriodTicks(0), Generation(0) {}
+  ~PollTimer() {
+    Cancel();
+  }
+
+  // Stops the timer. If its callback is running on another thread, waits for it to return, so
+  // that afterwards the callback won't be running or called again. A callback may also cancel
+  // or destroy its own timer.
+  void Cancel();
+
+  bool IsScheduled() const;
+
+ private:
+  friend class LongPollThread;
+
+  LongPollThread* pScheduler;
+  Delegate<void()> Func;
+  uint64_t PeriodTicks;
+  unsigned Generation; // Changed by each ScheduleTimer and Cancel.
+
+  OVR_NON_COPYABLE(PollTimer);
+};
+
 //-----------------------------------------------------------------------------
 // LongPollThread
 
-// This thread runs long-polling subsystems that wake up every second or so
+// This thread runs long-polling subsystems that wake up every second or so, as well as timers
+// with their own deadlines and periods.
 // The motivation is to reduce the number of threads that are running to minimize the risk of
 // deadlock
+//
+// Timers are kept in a TimerWheel with TimerTickNanos resolution, and the thread sleeps until
+// the next one is due, on a timerfd on Linux. Timer callbacks run on the LongPoll thread, so
+// they should be short and must not block on other timers.
+//
+// Example usage:
+//     PollTimer FlushTimer; // Member of the subsystem.
+//     ...
+//     LongPollThread::GetInstance()->ScheduleTimer(
+//         &FlushTimer, PollFunc::FromMember<Subsystem, &Subsystem::Flush>(this),
+//         10000000, 10000000); // In 10 ms, then every 10 ms.
+
 class LongPollThread : public SystemSingletonBase<LongPollThread> {
   OVR_DECLARE_SINGLETON(LongPollThread);
   virtual void OnThreadDestroy() override;
 
  public:
-  typedef Delegate0<void> PollFunc;
+  typedef Delegate<void()> PollFunc;
   static const int WakeupInterval = 1000; // milliseconds
+  static const uint64_t TimerTickNanos = 100000; // Timer resolution.
 
   void AddPollFunc(CallbackListener<PollFunc>* func);
 
+  // Runs func on the LongPoll thread after delayNanos, and then every periodNanos if that's
+  // nonzero. Times are rounded up to TimerTickNanos. If the timer is already scheduled, its
+  // callback and schedule are replaced. Periods missed because the thread was busy are
+  // skipped rather than run late in a burst.
+  void ScheduleTimer(
+      PollTimer* timer,
+      PollFunc func,
+      uint64_t delayNanos,
+      uint64_t periodNanos = 0);
+
+  // As ScheduleTimer, with the first deadline in Timer::GetRealTicksNanos time.
+  void ScheduleTimerAt(
+      PollTimer* timer,
+      PollFunc func,
+      uint64_t deadlineNanos,
+      uint64_t periodNanos = 0);
+
   void Wake();
 
   // debug method for assertion to maintain initialization order for this singleton
   static bool IsInitialized();
 
  protected:
+  friend class PollTimer;
+
   CallbackEmitter<PollFunc> PollSubject;
 
   std::atomic<bool> Terminated;
   Event WakeEvent;
   std::unique_ptr<std::thread> LongPollThreadHandle;
 
+  std::mutex TimerLock; // Protects the following, and the scheduling state of PollTimers.
+  std::condition_variable TimerDone; // Notified when a timer callback returns.
+  TimerWheel Timers;
+  PollTimer* pRunningTimer; // Timer whose callback is running, unless it was cancelled.
+  unsigned RunningGeneration; // Generation of pRunningTimer when its callback started.
+  Event TimersChanged; // Set when a timer is scheduled, to recompute the wait.
+
+  void cancelTimer(PollTimer* timer);
+  void runTimers(uint64_t nowNanos);
+  uint64_t getNextTimerNanos();
+  void waitUntil(uint64_t deadlineNanos, int timerFd);
+
   void fireTermination();
 
   void Run();
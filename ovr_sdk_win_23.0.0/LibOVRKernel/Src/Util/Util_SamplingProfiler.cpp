@@ -0,0 +1,747 @@
+/************************************************************************************
+
+Filename    :   Util_SamplingProfiler.cpp
+Content     :   In-process sampling CPU profiler with flame graph output
+Created     :   October 18, 2026
+Notes       :
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+#include "Util_SamplingProfiler.h"
+#include "Util_SystemInfo.h"
+
+#include "Kernel/OVR_Alg.h"
+#include "Kernel/OVR_Win32_IncludeWindows.h"
+
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sstream>
+
+#if defined(OVR_OS_LINUX) || defined(OVR_OS_MAC)
+#include <pthread.h>
+#include <sys/time.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#if defined(OVR_OS_LINUX)
+#include <fcntl.h>
+#include <sys/syscall.h>
+#endif
+#endif
+
+// OVR_PROFILER_SIGNAL_FRAME is defined where the registers needed to walk the interrupted stack
+// can be read from a signal handler's context.
+#if defined(OVR_OS_LINUX) && (defined(__x86_64__) || defined(__i386__) || defined(__aarch64__))
+#define OVR_PROFILER_SIGNAL_FRAME 1
+#elif defined(OVR_OS_MAC) && (defined(__x86_64__) || defined(__aarch64__))
+#define OVR_PROFILER_SIGNAL_FRAME 1
+#endif
+
+namespace OVR {
+namespace Util {
+
+// Drains are this far apart at most, which bounds the sample rate the buffer can hold to
+// SampleBufferSize samples per interval.
+static const unsigned DrainIntervalMs = 100;
+
+// Returns the name of the thread with the given id while it's alive, for labelling its stacks.
+static std::string GetProfiledThreadName(uint32_t threadSysId) {
+  char name[64] = {};
+
+#if defined(OVR_OS_LINUX)
+  char path[64];
+  snprintf(path, sizeof(path), "/proc/self/task/%u/comm", threadSysId);
+
+  FILE* file = fopen(path, "r");
+  if (file) {
+    if (!fgets(name, sizeof(name), file))
+      name[0] = '\0';
+    fclose(file);
+  }
+#endif
+
+  std::string result(name);
+  while (!result.empty() && (result.back() == '\n' || result.back() == ' '))
+    result.pop_back();
+  if (result.empty()) {
+    snprintf(name, sizeof(name), "Thread %u", threadSysId);
+    result = name;
+  }
+
+  // ';' separates frames in the folded format, so it can't appear within names.
+  for (char& c : result) {
+    if (c == ';')
+      c = ':';
+    else if (c == '\n' || c == '\r')
+      c = ' ';
+  }
+  return result;
+}
+
+#if !defined(OVR_OS_MS)
+
+// The running profiler, for the signal handler, or null if none is running.
+static std::atomic<SamplingProfiler*> SignalProfiler(nullptr);
+
+// Number of signal handlers currently running, which Stop waits to reach 0 after clearing
+// SignalProfiler.
+static std::atomic<int> ActiveSignalHandlers(0);
+
+#if defined(OVR_PROFILER_SIGNAL_FRAME)
+// Reads the registers of the interrupted code from a signal handler's context.
+static void
+GetSignalFrame(void* context, void** pc, void** framePointer, void** stackPointer) {
+  const ucontext_t* uc = (const ucontext_t*)context;
+
+#if defined(OVR_OS_LINUX) && defined(__x86_64__)
+  *pc = (void*)uc->uc_mcontext.gregs[REG_RIP];
+  *framePointer = (void*)uc->uc_mcontext.gregs[REG_RBP];
+  *stackPointer = (void*)uc->uc_mcontext.gregs[REG_RSP];
+#elif defined(OVR_OS_LINUX) && defined(__i386__)
+  *pc = (void*)uc->uc_mcontext.gregs[REG_EIP];
+  *framePointer = (void*)uc->uc_mcontext.gregs[REG_EBP];
+  *stackPointer = (void*)uc->uc_mcontext.gregs[REG_ESP];
+#elif defined(OVR_OS_LINUX) && defined(__aarch64__)
+  *pc = (void*)uc->uc_mcontext.pc;
+  *framePointer = (void*)uc->uc_mcontext.regs[29];
+  *stackPointer = (void*)uc->uc_mcontext.sp;
+#elif defined(OVR_OS_MAC) && defined(__x86_64__)
+  *pc = (void*)uc->uc_mcontext->__ss.__rip;
+  *framePointer = (void*)uc->uc_mcontext->__ss.__rbp;
+  *stackPointer = (void*)uc->uc_mcontext->__ss.__rsp;
+#elif defined(OVR_OS_MAC) && defined(__aarch64__)
+  *pc = (void*)__darwin_arm_thread_state64_get_pc(uc->uc_mcontext->__ss);
+  *framePointer = (void*)__darwin_arm_thread_state64_get_fp(uc->uc_mcontext->__ss);
+  *stackPointer = (void*)__darwin_arm_thread_state64_get_sp(uc->uc_mcontext->__ss);
+#endif
+}
+
+#if defined(OVR_OS_LINUX)
+// The stacks of sampled threads, found on their first samples. Each entry is claimed by a
+// thread and then only accessed by that thread, or a later one given the same id. Entries of
+// threads which have exited aren't reclaimed, so once the table is full, threads without an
+// entry look up their stacks on every sample.
+struct StackRangeEntry {
+  std::atomic<uint32_t> ThreadSysId;
+  uintptr_t Low;
+  uintptr_t High;
+};
+
+static const size_t StackRangeTableSize = 1024;
+static StackRangeEntry StackRangeTable[StackRangeTableSize];
+
+// Finds the memory mapping containing address in /proc/self/maps, whose lines start with
+// "low-high " in hex. Uses only async-signal-safe calls.
+static bool FindMapping(uintptr_t address, uintptr_t& low, uintptr_t& high) {
+  const int fd = open("/proc/self/maps", O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return false;
+
+  char buffer[1024];
+  uintptr_t values[2] = {0, 0};
+  int field = 0; // 2 while skipping the rest of a line.
+  bool found = false;
+  ssize_t count;
+
+  while (!found && ((count = read(fd, buffer, sizeof(buffer))) > 0)) {
+    for (ssize_t i = 0; (i < count) && !found; ++i) {
+      const char c = buffer[i];
+      if (c == '\n') {
+        values[0] = values[1] = 0;
+        field = 0;
+      } else if (field < 2) {
+        if ((c >= '0') && (c <= '9'))
+          values[field] = (values[field] << 4) | uintptr_t(c - '0');
+        else if ((c >= 'a') && (c <= 'f'))
+          values[field] = (values[field] << 4) | uintptr_t(c - 'a' + 10);
+        else if (++field == 2)
+          found = (address >= values[0]) && (address < values[1]);
+      }
+    }
+  }
+
+  close(fd);
+  low = values[0];
+  high = values[1];
+  return found;
+}
+#endif
+
+// Finds the range of the interrupted thread's stack, from a signal handler.
+static bool
+GetStackRange(uint32_t threadSysId, uintptr_t stackPointer, uintptr_t* low, uintptr_t* high) {
+#if defined(OVR_OS_LINUX)
+  StackRangeEntry* entry = nullptr;
+  for (size_t i = 0; i < StackRangeTableSize; ++i) {
+    StackRangeEntry& candidate = StackRangeTable[(threadSysId + i) % StackRangeTableSize];
+    uint32_t id = candidate.ThreadSysId.load(std::memory_order_acquire);
+    if ((id == 0) &&
+        candidate.ThreadSysId.compare_exchange_strong(id, threadSysId, std::memory_order_acquire))
+      id = threadSysId;
+    if (id == threadSysId) {
+      entry = &candidate;
+      break;
+    }
+  }
+
+  // A thread given the id of one which has exited may have a different stack.
+  if (entry && (stackPointer >= entry->Low) && (stackPointer < entry->High)) {
+    *low = entry->Low;
+    *high = entry->High;
+    return true;
+  }
+
+  if (!FindMapping(stackPointer, *low, *high))
+    return false;
+
+  if (entry) {
+    entry->Low = *low;
+    entry->High = *high;
+  }
+  return true;
+
+#else
+  OVR_UNUSED(threadSysId);
+  const pthread_t self = pthread_self();
+  *high = (uintptr_t)pthread_get_stackaddr_np(self);
+  *low = *high - pthread_get_stacksize_np(self);
+  return (stackPointer >= *low) && (stackPointer < *high);
+#endif
+}
+#endif
+
+void SamplingProfiler::OnProfileSignal(int, siginfo_t*, void* context) {
+  const int savedErrno = errno; // The interrupted code may be about to read errno.
+  ActiveSignalHandlers.fetch_add(1);
+
+#if defined(OVR_PROFILER_SIGNAL_FRAME)
+  SamplingProfiler* profiler = SignalProfiler.load();
+
+  if (profiler) {
+    void *pc, *framePointer, *stackPointer;
+    GetSignalFrame(context, &pc, &framePointer, &stackPointer);
+
+#if defined(OVR_OS_LINUX)
+    uint32_t threadSysId = (uint32_t)syscall(SYS_gettid);
+#else
+    uint32_t threadSysId = (uint32_t)pthread_mach_thread_np(pthread_self());
+#endif
+
+    // The frame pointer chain is only followed within the thread's stack, as the interrupted
+    // code may be using the frame pointer register for other values. Where the stack can't be
+    // found, only pc is recorded.
+    uintptr_t stackLow = 0, stackHigh = 0;
+    if (!GetStackRange(threadSysId, (uintptr_t)stackPointer, &stackLow, &stackHigh))
+      framePointer = nullptr;
+
+    void* addressArray[MaxSampleFrames];
+    size_t frameCount = SymbolLookup::CaptureBacktraceFromFrame(
+        addressArray, MaxSampleFrames, pc, framePointer, stackPointer, (void*)stackHigh);
+
+    profiler->RecordSample(threadSysId, addressArray, frameCount);
+  }
+#else
+  OVR_UNUSED(context);
+#endif
+
+  ActiveSignalHandlers.fetch_sub(1);
+  errno = savedErrno;
+}
+
+#endif // !defined(OVR_OS_MS)
+
+//-----------------------------------------------------------------------------
+// SamplingProfiler
+
+SamplingProfiler* SamplingProfiler::GetInstance() {
+  static SamplingProfiler samplingProfiler;
+  return &samplingProfiler;
+}
+
+SamplingProfiler::SamplingProfiler()
+    : ControlLock(),
+      Running(false),
+      Frequency(DefaultFrequency),
+      Traces(nullptr),
+      SampleBuffer(nullptr),
+      SampleWriteIndex(0),
+      DroppedSampleCount(0),
+      CountsLock(),
+      SampleCounts(),
+      SampleCount(0),
+      ThreadNames(),
+      CollectorThread(),
+      StopEvent()
+#if defined(OVR_OS_MS)
+      ,
+      ThreadCycleTimes()
+#endif
+{
+#if !defined(OVR_OS_MS)
+  memset(&PreviousAction, 0, sizeof(PreviousAction));
+#endif
+}
+
+SamplingProfiler::~SamplingProfiler() {
+  Stop();
+  delete Traces;
+  delete[] SampleBuffer;
+}
+
+bool SamplingProfiler::Start(unsigned frequency) {
+  Lock::Locker locker(&ControlLock);
+
+#if !defined(OVR_OS_MS) && !defined(OVR_PROFILER_SIGNAL_FRAME)
+  OVR_UNUSED(frequency);
+  return false; // We don't know how to read the interrupted registers on this platform.
+#else
+  if (Running.load())
+    return false;
+
+  if (!Traces) {
+    Traces = new StackTraceTable;
+    SampleBuffer = new std::atomic<uint64_t>[SampleBufferSize];
+    for (size_t i = 0; i < SampleBufferSize; ++i)
+      SampleBuffer[i].store(0, std::memory_order_relaxed);
+  }
+
+  if (!Traces->IsValid())
+    return false;
+
+  Frequency = Alg::Clamp(frequency, 1u, (unsigned)MaxFrequency);
+  StopEvent.ResetEvent();
+  Running.store(true, std::memory_order_release);
+
+  if (!StartSampling()) {
+    Running.store(false, std::memory_order_release);
+    return false;
+  }
+
+  CollectorThread = std::thread([this] { CollectorThreadFunc(); });
+  return true;
+#endif
+}
+
+void SamplingProfiler::Stop() {
+  Lock::Locker locker(&ControlLock);
+
+  if (!Running.load())
+    return;
+
+  StopSampling();
+  Running.store(false, std::memory_order_release);
+  StopEvent.SetEvent();
+
+  if (CollectorThread.joinable())
+    CollectorThread.join();
+
+  DrainSamples();
+}
+
+void SamplingProfiler::Reset() {
+  DrainSamples();
+
+  Lock::Locker locker(&CountsLock);
+  SampleCounts.clear();
+  SampleCount = 0;
+  DroppedSampleCount.store(0, std::memory_order_relaxed);
+}
+
+uint64_t SamplingProfiler::GetSampleCount() {
+  DrainSamples();
+
+  Lock::Locker locker(&CountsLock);
+  return SampleCount;
+}
+
+void SamplingProfiler::RecordSample(
+    uint32_t threadSysId,
+    void* const addressArray[],
+    size_t frameCount) {
+  const uint32_t traceId = Traces->Add(addressArray, frameCount);
+
+  if (traceId) {
+    const uint64_t sample = ((uint64_t)traceId << 32) | threadSysId;
+    const size_t index =
+        SampleWriteIndex.fetch_add(1, std::memory_order_relaxed) & (SampleBufferSize - 1);
+    uint64_t expected = 0;
+
+    // If the entry still holds a sample from a lap ago, the buffer is full.
+    if (SampleBuffer[index].compare_exchange_strong(
+            expected, sample, std::memory_order_release, std::memory_order_relaxed))
+      return;
+  }
+
+  DroppedSampleCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SamplingProfiler::DrainSamples() {
+  if (!SampleBuffer)
+    return;
+
+  // Entries are taken wherever they are rather than in order, as only their counts matter.
+  Lock::Locker locker(&CountsLock);
+
+  for (size_t i = 0; i < SampleBufferSize; ++i) {
+    if (SampleBuffer[i].load(std::memory_order_relaxed) == 0)
+      continue;
+
+    const uint64_t sample = SampleBuffer[i].exchange(0, std::memory_order_acquire);
+    ++SampleCounts[sample];
+    ++SampleCount;
+
+    // Names are read while the threads are likely still alive, as they can't be afterwards.
+    const uint32_t threadSysId = (uint32_t)sample;
+    if (ThreadNames.find(threadSysId) == ThreadNames.end())
+      ThreadNames[threadSysId] = GetProfiledThreadName(threadSysId);
+  }
+}
+
+bool SamplingProfiler::StartSampling() {
+#if defined(OVR_OS_MS)
+  ThreadCycleTimes.clear(); // The collector thread takes the samples.
+  return true;
+#else
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_sigaction = OnProfileSignal;
+  action.sa_flags = SA_SIGINFO | SA_RESTART;
+  sigemptyset(&action.sa_mask);
+
+  if (sigaction(SIGPROF, &action, &PreviousAction) != 0)
+    return false;
+
+  SignalProfiler.store(this);
+
+  // ITIMER_PROF counts the process's CPU time, and signals whichever thread is running when it
+  // expires, so threads are sampled in proportion to the CPU time they use.
+  struct itimerval timer;
+  timer.it_interval.tv_sec = 0;
+  timer.it_interval.tv_usec = (suseconds_t)(1000000 / Frequency);
+  timer.it_value = timer.it_interval;
+
+  if (setitimer(ITIMER_PROF, &timer, nullptr) != 0) {
+    SignalProfiler.store(nullptr);
+    sigaction(SIGPROF, &PreviousAction, nullptr);
+    return false;
+  }
+
+  return true;
+#endif
+}
+
+void SamplingProfiler::StopSampling() {
+#if !defined(OVR_OS_MS)
+  struct itimerval timer;
+  memset(&timer, 0, sizeof(timer));
+  setitimer(ITIMER_PROF, &timer, nullptr);
+
+  SignalProfiler.store(nullptr);
+  while (ActiveSignalHandlers.load() != 0)
+    std::this_thread::yield();
+
+  // A SIGPROF may still be pending. Its default action would terminate the process, so it's
+  // ignored instead if no other handler was installed.
+  struct sigaction restoredAction = PreviousAction;
+  if (!(restoredAction.sa_flags & SA_SIGINFO) && (restoredAction.sa_handler == SIG_DFL))
+    restoredAction.sa_handler = SIG_IGN;
+  sigaction(SIGPROF, &restoredAction, nullptr);
+#endif
+}
+
+void SamplingProfiler::CollectorThreadFunc() {
+  Thread::SetCurrentThreadName("SamplingProfiler");
+
+#if defined(OVR_OS_MS)
+  const unsigned sampleIntervalMs = Alg::Max(1000 / Frequency, 1u);
+  unsigned msSinceDrain = 0;
+
+  while (!StopEvent.Wait(sampleIntervalMs)) {
+    SampleThreads();
+
+    msSinceDrain += sampleIntervalMs;
+    if (msSinceDrain >= DrainIntervalMs) {
+      DrainSamples();
+      msSinceDrain = 0;
+    }
+  }
+#else
+  while (!StopEvent.Wait(DrainIntervalMs))
+    DrainSamples();
+#endif
+}
+
+#if defined(OVR_OS_MS)
+void SamplingProfiler::SampleThreads() {
+  enum { MaxThreadCount = 256 };
+  ThreadHandle threadHandleArray[MaxThreadCount];
+  ThreadSysId threadSysIdArray[MaxThreadCount];
+
+  size_t threadCount =
+      SymbolLookup::GetThreadList(threadHandleArray, threadSysIdArray, MaxThreadCount);
+  threadCount = Alg::Min(threadCount, (size_t)MaxThreadCount);
+
+  const ThreadSysId currentThreadSysId = (ThreadSysId)::GetCurrentThreadId();
+  std::unordered_map<ThreadSysId, uint64_t> threadCycleTimes;
+
+  for (size_t i = 0; i < threadCount; ++i) {
+    if (threadSysIdArray[i] == currentThreadSysId)
+      continue;
+
+    // Threads which haven't run since the last sample are skipped, so that, as with SIGPROF,
+    // samples reflect CPU use rather than time spent waiting.
+    ULONG64 cycleTime = 0;
+    if (::QueryThreadCycleTime((HANDLE)threadHandleArray[i], &cycleTime)) {
+      threadCycleTimes[threadSysIdArray[i]] = cycleTime;
+
+      auto it = ThreadCycleTimes.find(threadSysIdArray[i]);
+      if (it != ThreadCycleTimes.end() && it->second == cycleTime)
+        continue;
+    }
+
+    void* addressArray[MaxSampleFrames];
+    size_t frameCount = SymbolLookup::GetBacktraceFromThreadHandle(
+        addressArray, MaxSampleFrames, 0, threadHandleArray[i]);
+
+    if (frameCount)
+      RecordSample((uint32_t)threadSysIdArray[i], addressArray, frameCount);
+  }
+
+  ThreadCycleTimes.swap(threadCycleTimes); // Drops the threads which have exited.
+  SymbolLookup::DoneThreadList(threadHandleArray, threadSysIdArray, threadCount);
+}
+#endif
+
+std::string SamplingProfiler::GetFrameName(
+    uint64_t address,
+    SymbolLookup& symbolLookup,
+    ModuleInfoLookup& moduleInfoLookup,
+    std::unordered_map<uint64_t, std::string>& nameCache) {
+  auto it = nameCache.find(address);
+  if (it != nameCache.end())
+    return it->second;
+
+  std::string name;
+  SymbolInfo symbolInfo;
+  char buffer[64];
+
+  if (symbolLookup.LookupSymbol(address, symbolInfo) && symbolInfo.function[0]) {
+    name = symbolInfo.function;
+  } else {
+    // Without symbols, module offsets can still be resolved later with addr2line or a
+    // debugger, which a raw address can't once the process has exited.
+    const ModuleInfo* moduleInfo = moduleInfoLookup.GetModuleInfoForAddress(address);
+
+    if (moduleInfo) {
+      snprintf(
+          buffer,
+          sizeof(buffer),
+          "+0x%llx",
+          (unsigned long long)(address - moduleInfo->baseAddress));
+      name = moduleInfo->name;
+      name += buffer;
+    } else {
+      snprintf(buffer, sizeof(buffer), "0x%llx", (unsigned long long)address);
+      name = buffer;
+    }
+  }
+
+  for (char& c : name) {
+    if (c == ';')
+      c = ':';
+    else if (c == '\n' || c == '\r')
+      c = ' ';
+  }
+
+  nameCache[address] = name;
+  return name;
+}
+
+bool SamplingProfiler::WriteFoldedStacks(const char* filePath) {
+  OVR_DISABLE_MSVC_WARNING(4996) // 4996: This function or variable may be unsafe.
+
+  Lock::Locker locker(&ControlLock); // Keeps Traces from being created while we read it.
+
+  DrainSamples();
+
+  std::map<uint64_t, uint64_t> sampleCounts;
+  std::unordered_map<uint32_t, std::string> threadNames;
+  {
+    Lock::Locker countsLocker(&CountsLock);
+    sampleCounts = SampleCounts;
+    threadNames = ThreadNames;
+  }
+
+  FILE* file = fopen(filePath, "w");
+  if (!file)
+    return false;
+
+  const bool symbolLookupInitialized = SymbolLookup::Initialize();
+  SymbolLookup symbolLookup;
+  ModuleInfoLookup moduleInfoLookup;
+  std::unordered_map<uint64_t, std::string> nameCache;
+
+  // Samples whose stacks differ only in return addresses within the same functions have the
+  // same folded stack, so their counts are merged here.
+  std::map<std::string, uint64_t> stackCounts;
+
+  for (const auto& sampleCount : sampleCounts) {
+    const uint32_t traceId = (uint32_t)(sampleCount.first >> 32);
+    const uint32_t threadSysId = (uint32_t)sampleCount.first;
+
+    auto threadName = threadNames.find(threadSysId);
+    std::string stack = (threadName != threadNames.end()) ? threadName->second
+                                                          : GetProfiledThreadName(threadSysId);
+
+    void* addressArray[MaxSampleFrames];
+    size_t frameCount = Traces->GetTrace(traceId, addressArray, MaxSampleFrames);
+
+    // Traces are innermost first, while folded stacks are outermost first. Each frame but the
+    // first is a return address, which is looked up one byte back so that it's within the
+    // call instruction, as the return may be the start of another function.
+    for (size_t i = frameCount; i-- > 0;) {
+      uint64_t address = (uint64_t)(uintptr_t)addressArray[i] - (i ? 1 : 0);
+      stack += ';';
+      stack += GetFrameName(address, symbolLookup, moduleInfoLookup, nameCache);
+    }
+
+    stackCounts[stack] += sampleCount.second;
+  }
+
+  for (const auto& stackCount : stackCounts)
+    fprintf(file, "%s %llu\n", stackCount.first.c_str(), (unsigned long long)stackCount.second);
+
+  bool success = (ferror(file) == 0);
+  success = (fclose(file) == 0) && success;
+
+  if (symbolLookupInitialized)
+    SymbolLookup::Shutdown();
+
+  OVR_RESTORE_MSVC_WARNING()
+
+  return success;
+}
+
+} // namespace Util
+} // namespace OVR
+
+//-----------------------------------------------------------------------------
+// ProfilerStartDbgCmd
+const char* profilerStartDbgCmdName = "Profiler.Start";
+const char* profilerStartDbgCmdUsage = "[frequency]";
+const char* profilerStartDbgCmdDesc = "Starts the sampling CPU profiler.";
+const char* profilerStartDbgCmdDoc =
+    "Starts the sampling CPU profiler, with an optional sampling frequency in Hz (default 99).\n"
+    "Samples add to those of earlier runs. Use Profiler.Write to save them as folded stacks.\n"
+    "Example usage:\n"
+    "    Profiler.Start\n"
+    "    ... (wait for some time)\n"
+    "    Profiler.Stop\n"
+    "    Profiler.Write C:\\temp\\profile.folded\n";
+
+int ProfilerStartDbgCmd(const std::vector<std::string>& args, std::string* output) {
+  OVR::Util::SamplingProfiler* profiler = OVR::Util::SamplingProfiler::GetInstance();
+  unsigned frequency = OVR::Util::SamplingProfiler::DefaultFrequency;
+
+  if (args.size() >= 2) {
+    frequency = (unsigned)atoi(args[1].c_str());
+    if (frequency == 0) {
+      output->append("The frequency must be a positive number of Hz.");
+      return -1;
+    }
+  }
+
+  if (profiler->IsRunning()) {
+    output->append("The profiler is already running.");
+    return -1;
+  }
+
+  if (!profiler->Start(frequency)) {
+    output->append("The profiler couldn't be started on this platform.");
+    return -1;
+  }
+
+  std::stringstream strStream;
+  strStream << "Profiler started at " << profiler->GetFrequency() << " Hz.";
+  output->append(strStream.str());
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+// ProfilerStopDbgCmd
+const char* profilerStopDbgCmdName = "Profiler.Stop";
+const char* profilerStopDbgCmdUsage = "(no arguments)";
+const char* profilerStopDbgCmdDesc = "Stops the sampling CPU profiler.";
+const char* profilerStopDbgCmdDoc =
+    "Stops the sampling CPU profiler. The samples are kept for Profiler.Write.\n"
+    "Example usage:\n"
+    "    Profiler.Stop\n";
+
+int ProfilerStopDbgCmd(const std::vector<std::string>&, std::string* output) {
+  OVR::Util::SamplingProfiler* profiler = OVR::Util::SamplingProfiler::GetInstance();
+
+  if (!profiler->IsRunning()) {
+    output->append("The profiler isn't running.");
+    return -1;
+  }
+
+  profiler->Stop();
+
+  std::stringstream strStream;
+  strStream << "Profiler stopped with " << profiler->GetSampleCount() << " samples ("
+            << profiler->GetDroppedSampleCount() << " dropped).";
+  output->append(strStream.str());
+  return 0;
+}
+
+//-----------------------------------------------------------------------------
+// ProfilerWriteDbgCmd
+const char* profilerWriteDbgCmdName = "Profiler.Write";
+const char* profilerWriteDbgCmdUsage = "<filepath>";
+const char* profilerWriteDbgCmdDesc =
+    "Writes the sampling CPU profiler's samples as folded stacks.";
+const char* profilerWriteDbgCmdDoc =
+    "Writes the sampling CPU profiler's samples to a file as folded stacks, which flame graph\n"
+    "tools such as flamegraph.pl and speedscope read. May be used while the profiler runs.\n"
+    "Example usage:\n"
+    "    Profiler.Write C:\\temp\\profile.folded\n"
+    "    flamegraph.pl C:\\temp\\profile.folded > profile.svg\n";
+
+int ProfilerWriteDbgCmd(const std::vector<std::string>& args, std::string* output) {
+  if (args.size() < 2) {
+    output->append("Filepath first argument is required but was not supplied. See example usage.");
+    return -1;
+  }
+
+  OVR::Util::SamplingProfiler* profiler = OVR::Util::SamplingProfiler::GetInstance();
+  std::stringstream strStream;
+
+  if (!profiler->WriteFoldedStacks(args[1].c_str())) {
+    strStream << "Failed to write " << args[1];
+    output->append(strStream.str());
+    return -1;
+  }
+
+  strStream << profiler->GetSampleCount() << " samples written to " << args[1];
+  output->append(strStream.str());
+  return 0;
+}
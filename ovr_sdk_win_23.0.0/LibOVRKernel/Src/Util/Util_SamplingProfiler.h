@@ -0,0 +1,207 @@
+/************************************************************************************
+
+Filename    :   Util_SamplingProfiler.h
+Content     :   In-process sampling CPU profiler with flame graph output
+Created     :   October 18, 2026
+Notes       :
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+#ifndef OVR_Util_SamplingProfiler_h
+#define OVR_Util_SamplingProfiler_h
+
+#include <atomic>
+#include <map>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Kernel/OVR_Atomic.h"
+#include "Kernel/OVR_DebugHelp.h"
+#include "Kernel/OVR_Threads.h"
+#include "Kernel/OVR_Types.h"
+
+#if !defined(OVR_OS_MS)
+#include <signal.h>
+#endif
+
+namespace OVR {
+namespace Util {
+
+class ModuleInfoLookup;
+
+//-----------------------------------------------------------------------------
+// SamplingProfiler
+//
+// In-process sampling CPU profiler, for finding hot spots where an external profiler can't be
+// attached. While running, it samples the call stacks of the threads that are using CPU, and
+// WriteFoldedStacks writes the sample counts in the folded stack format read by flame graph
+// tools such as flamegraph.pl and speedscope: one line per distinct stack, of the form
+// "thread;outermost function;...;innermost function count".
+//
+// On Linux and Mac, a SIGPROF timer interrupts the threads in proportion to the CPU time they
+// use. The signal handler captures raw addresses with SymbolLookup::CaptureBacktraceFromFrame,
+// so stacks are only as deep as the frame pointer chain (see -fno-omit-frame-pointer). Function
+// names are found with dladdr, which needs the executable to be linked with -rdynamic.
+// On Windows, a sampler thread suspends each thread that ran since the last sample and reads
+// its stack with SymbolLookup::GetBacktraceFromThreadHandle.
+//
+// Stacks are stored once each in a StackTraceTable and samples are queued in a lock-free
+// buffer, which a collector thread drains into counts. Symbols are looked up only when the
+// counts are written, once per distinct address.
+//
+// The profiler can also be controlled with the Profiler.* debug commands below.
+//
+// Example usage:
+//     SamplingProfiler* profiler = SamplingProfiler::GetInstance();
+//     profiler->Start();
+//     ...
+//     profiler->Stop();
+//     profiler->WriteFoldedStacks("/tmp/session.folded");
+
+class SamplingProfiler {
+ public:
+  // The default is 99 rather than 100 Hz, so that sampling doesn't run in lockstep with
+  // periodic work.
+  enum { DefaultFrequency = 99, MaxFrequency = 1000 };
+
+  static SamplingProfiler* GetInstance();
+
+  // Starts sampling at the given frequency, in Hz. Samples add to those of earlier runs until
+  // Reset is called. Returns false if the profiler is already running, or if sampling isn't
+  // supported on this platform or couldn't be set up.
+  bool Start(unsigned frequency = DefaultFrequency);
+
+  // Stops sampling. The samples are kept for WriteFoldedStacks.
+  void Stop();
+
+  bool IsRunning() const {
+    return Running.load(std::memory_order_acquire);
+  }
+
+  unsigned GetFrequency() const {
+    return Frequency;
+  }
+
+  // Discards the samples taken so far.
+  void Reset();
+
+  // Writes the samples taken so far to the given file, in the folded stack format.
+  // May be called while running. Returns false if the file couldn't be written.
+  bool WriteFoldedStacks(const char* filePath);
+
+  // Returns the number of samples taken so far.
+  uint64_t GetSampleCount();
+
+  // Returns the number of samples lost because the sample buffer or stack table was full.
+  uint64_t GetDroppedSampleCount() const {
+    return DroppedSampleCount.load(std::memory_order_relaxed);
+  }
+
+ protected:
+  SamplingProfiler();
+  ~SamplingProfiler();
+
+  enum { SampleBufferSize = 16384, MaxSampleFrames = 64 };
+
+  // Adds a sample to the buffer. Lock-free and signal-safe.
+  void RecordSample(uint32_t threadSysId, void* const addressArray[], size_t frameCount);
+
+  // Moves samples from the buffer into SampleCounts.
+  void DrainSamples();
+
+  bool StartSampling();
+  void StopSampling();
+  void CollectorThreadFunc();
+
+#if defined(OVR_OS_MS)
+  void SampleThreads();
+#else
+  static void OnProfileSignal(int signal, siginfo_t* signalInfo, void* context);
+#endif
+
+  std::string GetFrameName(
+      uint64_t address,
+      SymbolLookup& symbolLookup,
+      ModuleInfoLookup& moduleInfoLookup,
+      std::unordered_map<uint64_t, std::string>& nameCache);
+
+  Lock ControlLock; // Serializes Start, Stop and the writing of results.
+  std::atomic<bool> Running;
+  unsigned Frequency;
+
+  // Created on the first Start and kept, as signal handlers may run after Stop returns.
+  StackTraceTable* Traces;
+  std::atomic<uint64_t>* SampleBuffer; // (trace id << 32 | thread id), or 0 for an empty entry.
+  std::atomic<size_t> SampleWriteIndex;
+  std::atomic<uint64_t> DroppedSampleCount;
+
+  Lock CountsLock; // Protects the members below.
+  std::map<uint64_t, uint64_t> SampleCounts; // Count for each sample value.
+  uint64_t SampleCount;
+  std::unordered_map<uint32_t, std::string> ThreadNames; // Names seen while threads were alive.
+
+  std::thread CollectorThread; // Drains the buffer and, on Windows, takes the samples.
+  Event StopEvent;
+
+#if defined(OVR_OS_MS)
+  std::unordered_map<ThreadSysId, uint64_t> ThreadCycleTimes; // As of the last sample.
+#else
+  struct sigaction PreviousAction;
+#endif
+
+  OVR_NON_COPYABLE(SamplingProfiler);
+};
+
+} // namespace Util
+} // namespace OVR
+
+// ProfilerStartDbgCmd
+//
+// This is a debug command that starts the SamplingProfiler, with an optional frequency.
+//
+extern const char* profilerStartDbgCmdName;
+extern const char* profilerStartDbgCmdUsage;
+extern const char* profilerStartDbgCmdDesc;
+extern const char* profilerStartDbgCmdDoc;
+extern int ProfilerStartDbgCmd(const std::vector<std::string>& args, std::string* output);
+
+// ProfilerStopDbgCmd
+//
+// This is a debug command that stops the SamplingProfiler.
+//
+extern const char* profilerStopDbgCmdName;
+extern const char* profilerStopDbgCmdUsage;
+extern const char* profilerStopDbgCmdDesc;
+extern const char* profilerStopDbgCmdDoc;
+extern int ProfilerStopDbgCmd(const std::vector<std::string>& args, std::string* output);
+
+// ProfilerWriteDbgCmd
+//
+// This is a debug command that writes the SamplingProfiler's samples to a file, as folded
+// stacks for flame graph tools.
+//
+extern const char* profilerWriteDbgCmdName;
+extern const char* profilerWriteDbgCmdUsage;
+extern const char* profilerWriteDbgCmdDesc;
+extern const char* profilerWriteDbgCmdDoc;
+extern int ProfilerWriteDbgCmd(const std::vector<std::string>& args, std::string* output);
+
+#endif // OVR_Util_SamplingProfiler_h
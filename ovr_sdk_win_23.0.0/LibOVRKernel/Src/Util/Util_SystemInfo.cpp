@@ -2174,6 +2174,8 @@ SystemMemoryInfo GetSystemMemoryInfo() {
   return smi;
 }
 
+#if defined(OVR_CPU_X86) || defined(OVR_CPU_X86_64)
+
 static void cpuid(int output[4], int functionNumber) {
 #if defined(_MSC_VER) || defined(__INTEL_COMPILER)
   __cpuidex(output, functionNumber, 0);
@@ -2187,30 +2189,37 @@ static void cpuid(int output[4], int functionNumber) {
 #endif
 }
 
-CPUInstructionSet GetSupportedCPUInstructionSet(bool* popcntSupported, bool* lzcntSupported) {
-  static CPUInstructionSet cpuIS = CPUInstructionSet::Unknown;
+// Returns the XCR0 register, which indicates the register state the OS saves on context switch.
+// Must only be called if cpuid reports OSXSAVE support.
+static uint64_t xgetbv0() {
+#if defined(_MSC_VER) || defined(__INTEL_COMPILER)
+  return _xgetbv(0);
+#elif defined(__GNUC__) || defined(__clang__)
+  uint32_t eax, edx;
+  __asm("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return ((uint64_t)edx << 32) | eax;
+#else
+  return 0;
+#endif
+}
 
-  if (cpuIS != CPUInstructionSet::Unknown)
-    return cpuIS;
+#endif // defined(OVR_CPU_X86) || defined(OVR_CPU_X86_64)
 
-  cpuIS = CPUInstructionSet::Basic;
+namespace {
+struct CPUFeatures {
+  CPUInstructionSet InstructionSet;
+  bool Popcnt;
+  bool Lzcnt;
+};
+} // namespace
 
+static CPUInstructionSet DetectCPUInstructionSet() {
+#if defined(OVR_CPU_X86) || defined(OVR_CPU_X86_64)
   int features[4] = {};
   cpuid(features, 0);
   if (features[0] == 0) // If there are no features...
-    return cpuIS;
-
-  // Check for lzcnt
-  if (lzcntSupported) {
-    cpuid(features, 0x80000001);
-    *lzcntSupported = ((features[2] & (1 << 5)) == 0);
-  }
-
-  // Check for popcnt
-  if (popcntSupported) {
-    cpuid(features, 1);
-    *popcntSupported = ((features[2] & (1 << 23)) == 0);
-  }
+    return CPUInstructionSet::Basic;
+  const int maxFunction = features[0];
 
   cpuid(features, 1);
 
@@ -2220,49 +2229,86 @@ CPUInstructionSet GetSupportedCPUInstructionSet(bool* popcntSupported, bool* lzc
       (features[3] & (1 << 24)) == 0 || // If FXSAVE is not supported...
       (features[3] & (1 << 25)) == 0) // If SSE is not supported...
   {
-    return cpuIS;
+    return CPUInstructionSet::Basic;
   }
-  cpuIS = CPUInstructionSet::SEE1;
 
   if ((features[3] & (1 << 26)) == 0) // If SSE2 is not supported...
-    return cpuIS;
-  cpuIS = CPUInstructionSet::SSE2;
+    return CPUInstructionSet::SEE1;
 
   if ((features[2] & (1 << 0)) == 0) // If SSE3 is not supported...
-    return cpuIS;
-  cpuIS = CPUInstructionSet::SSE3;
+    return CPUInstructionSet::SSE2;
 
   if ((features[2] & (1 << 9)) == 0) // If SSSE3 is not supported...
-    return cpuIS;
-  cpuIS = CPUInstructionSet::SSSE3;
+    return CPUInstructionSet::SSE3;
 
   if ((features[2] & (1 << 19)) == 0) // If SSE4.1 is not supported...
-    return cpuIS;
-  cpuIS = CPUInstructionSet::SSE41;
+    return CPUInstructionSet::SSSE3;
 
   if ((features[2] & (1 << 20)) == 0) // If SSE42 is not supproted...
-    return cpuIS;
-  cpuIS = CPUInstructionSet::SSE42;
+    return CPUInstructionSet::SSE41;
+
+  if ((features[2] & (1 << 27)) == 0) // If OSXSAVE is not supported...
+    return CPUInstructionSet::SSE42;
+
+  const uint64_t xcr0 = xgetbv0();
 
-#if defined(_MSC_VER)
-  if ((features[2] & (1 << 27)) == 0 || // If OSXSAVE is not supported...
-      (_xgetbv(0) & 6) != 6 || // If AVX is not recognized by the OS...
+  if ((xcr0 & 6) != 6 || // If AVX is not recognized by the OS...
       (features[2] & (1 << 28)) == 0) // If AVX is not supported by the CPU...
   {
-    return cpuIS;
+    return CPUInstructionSet::SSE42;
   }
-#else
-// To do: Implement this.
-#endif
 
-  cpuIS = CPUInstructionSet::AVX1;
+  if (maxFunction < 7)
+    return CPUInstructionSet::AVX1;
 
   cpuid(features, 7);
   if ((features[1] & (1 << 5)) == 0) // If AVX2 is not supported...
-    return cpuIS;
+    return CPUInstructionSet::AVX1;
+
+  // F, DQ, CD, BW and VL.
+  const int avx512Bits = (1 << 16) | (1 << 17) | (1 << 28) | (1 << 30) | (1 << 31);
+  if ((xcr0 & 0xE6) != 0xE6 || // If the opmask and ZMM state is not saved by the OS...
+      (features[1] & avx512Bits) != avx512Bits) // If AVX-512 is not supported by the CPU...
+  {
+    return CPUInstructionSet::AVX2;
+  }
+
+  return CPUInstructionSet::AVX512;
+#else
+  return CPUInstructionSet::Unknown;
+#endif
+}
+
+static CPUFeatures DetectCPUFeatures() {
+  CPUFeatures result = {DetectCPUInstructionSet(), false, false};
+
+#if defined(OVR_CPU_X86) || defined(OVR_CPU_X86_64)
+  int features[4] = {};
+  cpuid(features, 0);
+  if (features[0] >= 1) {
+    cpuid(features, 1);
+    result.Popcnt = ((features[2] & (1 << 23)) != 0);
+  }
+
+  cpuid(features, 0x80000000);
+  if ((unsigned)features[0] >= 0x80000001u) {
+    cpuid(features, 0x80000001);
+    result.Lzcnt = ((features[2] & (1 << 5)) != 0);
+  }
+#endif
+
+  return result;
+}
+
+CPUInstructionSet GetSupportedCPUInstructionSet(bool* popcntSupported, bool* lzcntSupported) {
+  static const CPUFeatures features = DetectCPUFeatures();
+
+  if (popcntSupported)
+    *popcntSupported = features.Popcnt;
+  if (lzcntSupported)
+    *lzcntSupported = features.Lzcnt;
 
-  cpuIS = CPUInstructionSet::AVX2;
-  return cpuIS;
+  return features.InstructionSet;
 }
 
 //-----------------------------------------------------------------------------
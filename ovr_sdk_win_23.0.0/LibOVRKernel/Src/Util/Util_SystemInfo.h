@@ -448,13 +448,15 @@ enum class CPUInstructionSet {
   SSE41,
   SSE42,
   AVX1,
-  AVX2
+  AVX2,
+  AVX512 // AVX-512 F, CD, BW, DQ and VL, the Skylake-SP subset.
 };
 
 //-----------------------------------------------------------------------------
 // Indicates the minimum instruction set that the CPU + OS support. Note that an older OS may
 // not properly support a given CPU instruction set, usually because it doesn't know how to
-// preserve its registers on context switch.
+// preserve its registers on context switch. popcntSupported and lzcntSupported may be null.
+// Returns Unknown on non-x86 CPUs.
 
 CPUInstructionSet GetSupportedCPUInstructionSet(bool* popcntSupported, bool* lzcntSupported);
 
@@ -0,0 +1,221 @@
+/************************************************************************************
+
+Filename    :   Util_TimerWheel.cpp
+Content     :   Hierarchical timer wheel
+Created     :   October 18, 2026
+Notes       :
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+#include "Util_TimerWheel.h"
+
+#include "Kernel/OVR_Alg.h"
+
+namespace OVR {
+namespace Util {
+
+// Mask of the slots after the given one.
+static uint64_t SlotsAfter(unsigned slot) {
+  return (slot + 1 < 64) ? (~uint64_t(0) << (slot + 1)) : 0;
+}
+
+TimerWheel::TimerWheel(uint64_t currentTick) : CurrentTick(currentTick), Count(0) {
+  for (int level = 0; level < LevelCount; ++level) {
+    Occupied[level] = 0;
+    for (int slot = 0; slot < SlotCount; ++slot)
+      Slots[level][slot].pPrev = Slots[level][slot].pNext = &Slots[level][slot];
+  }
+  Overflow.pPrev = Overflow.pNext = &Overflow;
+  Expired.pPrev = Expired.pNext = &Expired;
+}
+
+TimerWheel::~TimerWheel() {
+  // Detach any remaining entries, so that their owners see them as not inserted.
+  for (int level = 0; level < LevelCount; ++level) {
+    for (int slot = 0; slot < SlotCount; ++slot) {
+      while (Slots[level][slot].pNext != &Slots[level][slot])
+        unlink(Slots[level][slot].pNext);
+    }
+  }
+  while (Overflow.pNext != &Overflow)
+    unlink(Overflow.pNext);
+  while (Expired.pNext != &Expired)
+    unlink(Expired.pNext);
+}
+
+TimerWheel::Entry* TimerWheel::getHead(int location) {
+  if (location == Location_Overflow)
+    return &Overflow;
+  if (location == Location_Expired)
+    return &Expired;
+  return &Slots[location / SlotCount][location % SlotCount];
+}
+
+void TimerWheel::link(Entry* head, Entry* entry, int location) {
+  entry->pPrev = head->pPrev;
+  entry->pNext = head;
+  head->pPrev->pNext = entry;
+  head->pPrev = entry;
+  entry->Location = location;
+}
+
+void TimerWheel::unlink(Entry* entry) {
+  entry->pPrev->pNext = entry->pNext;
+  entry->pNext->pPrev = entry->pPrev;
+  entry->pPrev = entry->pNext = nullptr;
+}
+
+void TimerWheel::place(Entry* entry) {
+  const uint64_t expiry = entry->ExpiryTick;
+
+  if (expiry <= CurrentTick) {
+    link(&Expired, entry, Location_Expired);
+    return;
+  }
+
+  // The entry goes on the lowest level whose slots cover both now and its expiry. Its slot on
+  // that level is then always after the current one.
+  for (int level = 0; level < LevelCount; ++level) {
+    const int shift = SlotBits * (level + 1);
+    if ((expiry >> shift) == (CurrentTick >> shift)) {
+      const unsigned slot = unsigned(expiry >> (SlotBits * level)) & (SlotCount - 1);
+      link(&Slots[level][slot], entry, level * SlotCount + slot);
+      Occupied[level] |= uint64_t(1) << slot;
+      return;
+    }
+  }
+
+  link(&Overflow, entry, Location_Overflow);
+}
+
+void TimerWheel::redistribute(Entry* head) {
+  // Detach the list first, as entries may be placed back on it.
+  Entry* entry = head->pNext;
+  head->pPrev->pNext = nullptr;
+  head->pPrev = head->pNext = head;
+
+  while (entry) {
+    Entry* next = entry->pNext;
+    place(entry);
+    entry = next;
+  }
+}
+
+void TimerWheel::Insert(Entry* entry, uint64_t expiryTick) {
+  OVR_ASSERT(!entry->IsInserted());
+  entry->ExpiryTick = expiryTick;
+  place(entry);
+  ++Count;
+}
+
+void TimerWheel::Remove(Entry* entry) {
+  if (!entry->IsInserted())
+    return;
+
+  const int location = entry->Location;
+  unlink(entry);
+  --Count;
+
+  if (location >= 0) {
+    Entry* head = getHead(location);
+    if (head->pNext == head)
+      Occupied[location / SlotCount] &= ~(uint64_t(1) << (location % SlotCount));
+  }
+}
+
+TimerWheel::Entry* TimerWheel::PopExpired() {
+  if (Expired.pNext == &Expired)
+    return nullptr;
+
+  Entry* entry = Expired.pNext;
+  unlink(entry);
+  --Count;
+  return entry;
+}
+
+uint64_t TimerWheel::GetNextEventTick() const {
+  if (Expired.pNext != &Expired)
+    return CurrentTick;
+  return getNextStepTick();
+}
+
+uint64_t TimerWheel::getNextStepTick() const {
+  // Each level's events come after all of the lower levels', so the first occupied level has
+  // the next one: an expiry on level 0, or the start of a slot to redistribute above it.
+  for (int level = 0; level < LevelCount; ++level) {
+    const int shift = SlotBits * level;
+    const unsigned currentSlot = unsigned(CurrentTick >> shift) & (SlotCount - 1);
+    const uint64_t pending = Occupied[level] & SlotsAfter(currentSlot);
+    if (pending) {
+      const uint64_t levelStart = (CurrentTick >> (shift + SlotBits)) << (shift + SlotBits);
+      return levelStart + (uint64_t(Alg::CountTrailing0Bits(pending)) << shift);
+    }
+  }
+
+  if (Overflow.pNext != &Overflow) {
+    const int shift = SlotBits * LevelCount;
+    return ((CurrentTick >> shift) + 1) << shift;
+  }
+
+  return UINT64_MAX;
+}
+
+void TimerWheel::step() {
+  const uint64_t tick = CurrentTick;
+
+  if ((tick & ((uint64_t(1) << (SlotBits * LevelCount)) - 1)) == 0)
+    redistribute(&Overflow);
+
+  // Redistribute from the top down, as entries from one level can land on those below it.
+  for (int level = LevelCount - 1; level > 0; --level) {
+    const int shift = SlotBits * level;
+    if ((tick & ((uint64_t(1) << shift) - 1)) != 0)
+      continue;
+
+    const unsigned slot = unsigned(tick >> shift) & (SlotCount - 1);
+    if (Occupied[level] & (uint64_t(1) << slot)) {
+      Occupied[level] &= ~(uint64_t(1) << slot);
+      redistribute(&Slots[level][slot]);
+    }
+  }
+
+  const unsigned slot = unsigned(tick) & (SlotCount - 1);
+  if (Occupied[0] & (uint64_t(1) << slot)) {
+    Occupied[0] &= ~(uint64_t(1) << slot);
+    redistribute(&Slots[0][slot]); // Everything in it expires now.
+  }
+}
+
+void TimerWheel::Advance(uint64_t tick) {
+  while (CurrentTick < tick) {
+    // Ticks before the next step with work change nothing but the current tick, so skip them.
+    const uint64_t next = getNextStepTick();
+    if (next > tick) {
+      CurrentTick = tick;
+      break;
+    }
+
+    CurrentTick = next;
+    step();
+  }
+}
+
+} // namespace Util
+} // namespace OVR
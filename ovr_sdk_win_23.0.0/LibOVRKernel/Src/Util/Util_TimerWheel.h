@@ -0,0 +1,133 @@
+/************************************************************************************
+
+Filename    :   Util_TimerWheel.h
+Content     :   Hierarchical timer wheel
+Created     :   October 18, 2026
+Notes       :
+
+Copyright   :   Copyright (c) Facebook Technologies, LLC and its affiliates. All rights reserved.
+
+Licensed under the Oculus Master SDK License Version 1.0 (the "License");
+you may not use the Oculus VR Rift SDK except in compliance with the License,
+which is provided at the time of installation or download, or which
+otherwise accompanies this software in either electronic or hard copy form.
+
+You may obtain a copy of the License at
+
+https://developer.oculus.com/licenses/oculusmastersdk-1.0
+
+Unless required by applicable law or agreed to in writing, the Oculus VR SDK
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+
+************************************************************************************/
+
+#ifndef OVR_Util_TimerWheel_h
+#define OVR_Util_TimerWheel_h
+
+#include "Kernel/OVR_Types.h"
+
+namespace OVR {
+namespace Util {
+
+//-----------------------------------------------------------------------------
+// TimerWheel
+//
+// Orders timers by expiry in integer ticks, in O(1) per insertion, removal and expiry. Four
+// levels of 64 slots cover 64^4 ticks, about 4.7 hours at 1 ms ticks; later expiries wait in
+// an overflow list until they're in range. Each level's slots span 64 times the ticks of the
+// level below, and a slot's entries are redistributed to the lower levels as time reaches it.
+//
+// The wheel doesn't lock or own its entries, which are embedded in the timers that use it.
+//
+// Example usage:
+//     wheel.Insert(&entry, wheel.GetCurrentTick() + 10);
+//     ...
+//     wheel.Advance(nowTick);
+//     while (TimerWheel::Entry* expired = wheel.PopExpired())
+//       ...
+
+class TimerWheel {
+ public:
+  enum { SlotBits = 6, SlotCount = 1 << SlotBits, LevelCount = 4 };
+
+  class Entry {
+   public:
+    Entry() : pPrev(nullptr), pNext(nullptr), ExpiryTick(0), Location(0) {}
+
+    bool IsInserted() const {
+      return pPrev != nullptr;
+    }
+
+    uint64_t GetExpiryTick() const {
+      return ExpiryTick;
+    }
+
+   private:
+    friend class TimerWheel;
+
+    Entry* pPrev;
+    Entry* pNext;
+    uint64_t ExpiryTick;
+    int Location; // Level * SlotCount + slot, or Location_Overflow or Location_Expired.
+
+    OVR_NON_COPYABLE(Entry);
+  };
+
+  explicit TimerWheel(uint64_t currentTick = 0);
+  ~TimerWheel();
+
+  uint64_t GetCurrentTick() const {
+    return CurrentTick;
+  }
+
+  size_t GetCount() const {
+    return Count;
+  }
+
+  // Adds an entry which isn't inserted. Entries expiring at or before the current tick are
+  // expired right away, for the next PopExpired.
+  void Insert(Entry* entry, uint64_t expiryTick);
+
+  // Removes an entry if it's inserted, including when it has expired but not been popped.
+  void Remove(Entry* entry);
+
+  // Moves the current tick forward to tick, expiring the entries that are due by then.
+  // Ticks without work are skipped rather than stepped through.
+  void Advance(uint64_t tick);
+
+  // Removes and returns an expired entry, in the order they expired, or null if there are none.
+  Entry* PopExpired();
+
+  // Returns the earliest tick by which Advance would expire or redistribute entries: the
+  // current tick if there are expired ones, or UINT64_MAX if the wheel is empty.
+  uint64_t GetNextEventTick() const;
+
+ private:
+  enum { Location_Overflow = -1, Location_Expired = -2 };
+
+  void link(Entry* head, Entry* entry, int location);
+  void unlink(Entry* entry);
+  void place(Entry* entry);
+  void redistribute(Entry* head);
+  void step();
+  uint64_t getNextStepTick() const; // The next tick with expiries or redistribution.
+
+  Entry* getHead(int location);
+
+  uint64_t CurrentTick;
+  size_t Count;
+  uint64_t Occupied[LevelCount]; // Bit n is set when slot n of the level has entries.
+  Entry Slots[LevelCount][SlotCount]; // List heads.
+  Entry Overflow;
+  Entry Expired;
+
+  OVR_NON_COPYABLE(TimerWheel);
+};
+
+} // namespace Util
+} // namespace OVR
+
+#endif // OVR_Util_TimerWheel_h
@@ -52,14 +52,6 @@ const int DefaultThreshholdMsec = 60000; // milliseconds
 //-----------------------------------------------------------------------------
 // Tools
 
-static uint32_t GetFastMsTime() {
-#if defined(OVR_OS_MS)
-  return ::GetTickCount();
-#else
-  return Timer::GetTicksMs();
-#endif
-}
-
 static std::string SanitizeString(const char* cstr) {
   std::ostringstream ss;
   char ch;
@@ -71,6 +63,60 @@ static std::string SanitizeString(const char* cstr) {
   return ss.str();
 }
 
+//-----------------------------------------------------------------------------
+// LatencyHistogram
+
+LatencyHistogram::LatencyHistogram() : SumNanos(0), MaxNanos(0) {
+  for (int i = 0; i < BucketCount; ++i)
+    Counts[i].store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::GetCount() const {
+  uint64_t total = 0;
+  for (int i = 0; i < BucketCount; ++i)
+    total += Counts[i].load(std::memory_order_relaxed);
+  return total;
+}
+
+uint64_t LatencyHistogram::GetMean() const {
+  const uint64_t count = GetCount();
+  return count ? (SumNanos.load(std::memory_order_relaxed) / count) : 0;
+}
+
+uint64_t LatencyHistogram::GetPercentile(double fraction) const {
+  uint64_t counts[BucketCount];
+  uint64_t total = 0;
+  for (int i = 0; i < BucketCount; ++i) {
+    counts[i] = Counts[i].load(std::memory_order_relaxed);
+    total += counts[i];
+  }
+  if (total == 0)
+    return 0;
+
+  const double clamped = Alg::Clamp(fraction, 0.0, 1.0);
+  const uint64_t rank = Alg::Max<uint64_t>(uint64_t(clamped * double(total) + 0.5), 1);
+
+  uint64_t seen = 0;
+  for (int i = 0; i < BucketCount; ++i) {
+    seen += counts[i];
+    if (seen >= rank)
+      return Alg::Min(GetBucketUpperBound(i), GetMax());
+  }
+  return GetMax();
+}
+
+uint64_t LatencyHistogram::GetBucketUpperBound(int bucket) {
+  if (bucket < SubBucketCount)
+    return uint64_t(bucket);
+  if (bucket >= BucketCount - 1)
+    return UINT64_MAX;
+
+  const int exponent = bucket / SubBucketCount + SubBucketBits - 1;
+  const uint64_t subBucket = uint64_t(bucket % SubBucketCount);
+  const int shift = exponent - SubBucketBits;
+  return ((SubBucketCount + subBucket + 1) << shift) - 1;
+}
+
 //-----------------------------------------------------------------------------
 // WatchDogObserver
 
@@ -81,6 +127,7 @@ WatchDogObserver::WatchDogObserver()
       DogList(),
       IsReporting(false),
       TerminationEvent(),
+      DeadlinesChanged(),
       DeadlockSeen(false),
       AutoTerminateOnDeadlock(true),
       ApplicationName(),
@@ -176,6 +223,54 @@ void WatchDogObserver::OnDeadlock(const String& deadlockedThreadName) {
   }
 }
 
+uint64_t WatchDogObserver::checkDeadlines(uint64_t nowNanos) {
+  Lock::Locker locker(&ListLock);
+  uint64_t nextCheck = UINT64_MAX;
+
+  const int count = DogList.GetSizeI();
+  for (int i = 0; i < count; ++i) {
+    WatchDog* dog = DogList[i];
+
+    const uint64_t deadline = dog->DeadlineNanos.load(std::memory_order_relaxed);
+    if (deadline == 0)
+      continue;
+
+    uint64_t cycle, fed;
+    dog->loadCycleStart(cycle, fed);
+
+    if ((fed <= nowNanos) && (nowNanos - fed >= deadline)) {
+      dog->reportMiss(cycle, nowNanos - fed);
+
+      // Missed or not, its next cycle starts at an unknown time, so poll for it.
+      nextCheck = Alg::Min(nextCheck, nowNanos + deadline);
+    } else {
+      nextCheck = Alg::Min(nextCheck, fed + deadline);
+    }
+  }
+
+  return nextCheck;
+}
+
+bool WatchDogObserver::waitForTermination(uint64_t wakeNanos) {
+  const uint64_t now = Timer::GetRealTicksNanos();
+
+  // Event waits have millisecond resolution, so the rest of the wait is a sleep, after which
+  // termination is checked.
+  if (wakeNanos > now) {
+    const uint64_t delay = wakeNanos - now;
+    if (delay >= 1000000) {
+      Event* events[] = {&TerminationEvent, &DeadlinesChanged};
+      const unsigned delayMsec = unsigned(Alg::Min<uint64_t>(delay / 1000000, 0x7fffffff));
+      if (Event::WaitAny(events, 2, delayMsec) == 1)
+        DeadlinesChanged.ResetEvent();
+    } else {
+      std::this_thread::sleep_for(std::chrono::nanoseconds(delay));
+    }
+  }
+
+  return TerminationEvent.Wait(0);
+}
+
 int WatchDogObserver::Run() {
   Thread::SetCurrentThreadName("WatchDog");
 
@@ -192,28 +287,45 @@ int WatchDogObserver::Run() {
   // from debugger breakpoints and sleep/resume of the OS.
   int ConsecutiveLongCycles = 0; // Number of long cycles seen in a row
 
+  unsigned attributesVersion = 0;
+  Thread::UpdateBackgroundThreadAttributes(attributesVersion);
+
+  uint64_t nextLongCycleCheck =
+      Timer::GetRealTicksNanos() + uint64_t(kWakeupIntervalMsec) * 1000000;
+  uint64_t nextDeadlineCheck = UINT64_MAX;
+
   // While not requested to terminate:
-  while (!TerminationEvent.Wait(kWakeupIntervalMsec)) {
+  while (!waitForTermination(Alg::Min(nextLongCycleCheck, nextDeadlineCheck))) {
+    const uint64_t now = Timer::GetRealTicksNanos();
+    nextDeadlineCheck = checkDeadlines(now);
+
+    if (now < nextLongCycleCheck)
+      continue;
+    nextLongCycleCheck = now + uint64_t(kWakeupIntervalMsec) * 1000000;
+
+    Thread::UpdateBackgroundThreadAttributes(attributesVersion);
+
     bool sawLongCycle = false;
     String deadlockedThreadName;
 
     {
       Lock::Locker locker(&ListLock);
 
-      const uint32_t t1 = GetFastMsTime();
+      const uint64_t t1 = Timer::GetRealTicksNanos();
 
       const int count = DogList.GetSizeI();
       for (int i = 0; i < count; ++i) {
-        const WatchDog* dog = DogList[i];
+        WatchDog* dog = DogList[i];
 
         const int threshold = dog->ThreshholdMilliseconds;
-        const uint32_t t0 = dog->WhenLastFedMilliseconds;
+        const uint64_t t0 = dog->WhenLastFedNanos;
 
         // If threshold exceeded, assume there is thread deadlock of some sort.
-        int delta = static_cast<int>(t1 - t0);
+        // The delta is negative if the dog was fed after t1 was read.
+        const int64_t delta = int64_t(t1 - t0) / 1000000;
 
         // Include an upper bound in case the computer went to sleep
-        if (delta > threshold && (ConsecutiveLongCycles > 0 || delta < threshold * 5)) {
+        if (delta > threshold && (ConsecutiveLongCycles > 0 || delta < int64_t(threshold) * 5)) {
           sawLongCycle = true;
 
           deadlockedThreadName = dog->ThreadName;
@@ -226,6 +338,19 @@ int WatchDogObserver::Run() {
               deadlockedThreadName.c_str(),
               "'");
         }
+
+        const uint64_t missed = dog->MissedDeadlines.load(std::memory_order_relaxed);
+        if (missed != dog->LoggedMissedDeadlines) {
+          Logger.LogWarningF(
+              "WatchDogObserver::Run: Thread '%s' missed %llu deadlines of %llu us "
+              "(p99 cycle %llu us, max %llu us)",
+              dog->ThreadName.c_str(),
+              (unsigned long long)(missed - dog->LoggedMissedDeadlines),
+              (unsigned long long)(dog->DeadlineNanos.load(std::memory_order_relaxed) / 1000),
+              (unsigned long long)(dog->CycleHistogram.GetPercentile(0.99) / 1000),
+              (unsigned long long)(dog->CycleHistogram.GetMax() / 1000));
+          dog->LoggedMissedDeadlines = missed;
+        }
       }
     }
 
@@ -259,6 +384,9 @@ void WatchDogObserver::Add(WatchDog* dog) {
     Logger.LogDebugF("WatchDogObserver::Add Watchdog: %s", dog->GetThreadName().c_str());
     DogList.PushBack(dog);
     dog->Listed = true;
+
+    if (dog->DeadlineNanos.load(std::memory_order_relaxed) != 0)
+      DeadlinesChanged.SetEvent();
   } else
     Logger.LogDebugF(
         "WatchDogObserver::Add Watchdog: %s already added.", dog->GetThreadName().c_str());
@@ -297,12 +425,20 @@ void WatchDogObserver::DisableReporting() {
   IsReporting = false;
 }
 
+void WatchDogObserver::GetStats(Array<WatchDogStats>& stats) {
+  Lock::Locker locker(&ListLock);
+
+  stats.Resize(DogList.GetSize());
+  for (size_t i = 0; i < DogList.GetSize(); ++i)
+    DogList[i]->GetStats(stats[i]);
+}
+
 //-----------------------------------------------------------------------------
 // WatchDog
 
 WatchDog::WatchDog(const String& threadName)
     : ThreshholdMilliseconds(DefaultThreshholdMsec), ThreadName(threadName), Listed(false) {
-  WhenLastFedMilliseconds = GetFastMsTime();
+  WhenLastFedNanos = Timer::GetRealTicksNanos();
 
   OVR_ASSERT(!ThreadName.empty());
 }
@@ -324,12 +460,85 @@ void WatchDog::Enable() {
 }
 
 void WatchDog::Feed(int threshold) {
-  WhenLastFedMilliseconds = GetFastMsTime();
+  const uint64_t now = Timer::GetRealTicksNanos();
+  const uint64_t cycleNanos = now - WhenLastFedNanos.load(std::memory_order_relaxed);
+  const uint64_t cycle = CycleCount.load(std::memory_order_relaxed);
   ThreshholdMilliseconds = threshold;
 
   if (!Listed) {
+    // The time since construction or Disable isn't a cycle.
+    storeCycleStart(cycle, now);
     Enable();
+    return;
   }
+
+  CycleHistogram.Record(cycleNanos);
+
+  // The miss is reported before the next cycle is published, so that the observer can only
+  // report it for this cycle too, which reportMiss ignores.
+  const uint64_t deadline = DeadlineNanos.load(std::memory_order_relaxed);
+  if ((deadline != 0) && (cycleNanos > deadline))
+    reportMiss(cycle, cycleNanos);
+
+  storeCycleStart(cycle + 1, now);
+}
+
+void WatchDog::storeCycleStart(uint64_t cycle, uint64_t whenFedNanos) {
+  const uint32_t sequence = CycleSequence.load(std::memory_order_relaxed);
+  CycleSequence.store(sequence + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  CycleCount.store(cycle, std::memory_order_relaxed);
+  WhenLastFedNanos.store(whenFedNanos, std::memory_order_relaxed);
+
+  CycleSequence.store(sequence + 2, std::memory_order_release);
+}
+
+void WatchDog::loadCycleStart(uint64_t& cycle, uint64_t& whenFedNanos) const {
+  for (;;) {
+    const uint32_t sequence = CycleSequence.load(std::memory_order_acquire);
+    cycle = CycleCount.load(std::memory_order_relaxed);
+    whenFedNanos = WhenLastFedNanos.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_acquire);
+
+    if (((sequence & 1) == 0) && (CycleSequence.load(std::memory_order_relaxed) == sequence))
+      return;
+  }
+}
+
+void WatchDog::SetDeadline(uint64_t deadlineNanos, DeadlineMissFunc onMiss) {
+  WatchDogObserver* observer = WatchDogObserver::GetInstance();
+  {
+    Lock::Locker locker(&observer->ListLock);
+    OnDeadlineMiss = onMiss;
+    DeadlineNanos.store(deadlineNanos, std::memory_order_relaxed);
+  }
+  observer->DeadlinesChanged.SetEvent();
+}
+
+bool WatchDog::reportMiss(uint64_t cycle, uint64_t cycleNanos) {
+  // The fed thread and the observer can both see the miss; the first to mark it reports it.
+  uint64_t reported = ReportedCycle.load(std::memory_order_relaxed);
+  if ((reported == cycle + 1) || !ReportedCycle.compare_exchange_strong(reported, cycle + 1))
+    return false;
+
+  MissedDeadlines.fetch_add(1, std::memory_order_relaxed);
+
+  if (OnDeadlineMiss.IsValid())
+    OnDeadlineMiss(this, cycleNanos);
+  return true;
+}
+
+void WatchDog::GetStats(WatchDogStats& stats) const {
+  stats.ThreadName = ThreadName;
+  stats.CycleCount = CycleCount.load(std::memory_order_relaxed);
+  stats.MeanCycleNanos = CycleHistogram.GetMean();
+  stats.MedianCycleNanos = CycleHistogram.GetPercentile(0.5);
+  stats.P99CycleNanos = CycleHistogram.GetPercentile(0.99);
+  stats.P999CycleNanos = CycleHistogram.GetPercentile(0.999);
+  stats.MaxCycleNanos = CycleHistogram.GetMax();
+  stats.DeadlineNanos = DeadlineNanos.load(std::memory_order_relaxed);
+  stats.MissedDeadlines = MissedDeadlines.load(std::memory_order_relaxed);
 }
 } // namespace Util
 } // namespace OVR
@@ -28,8 +28,11 @@ limitations under the License.
 #define OVR_Util_Watchdog_h
 
 #include <thread>
+#include "Kernel/OVR_Alg.h"
 #include "Kernel/OVR_Allocator.h"
+#include "Kernel/OVR_Array.h"
 #include "Kernel/OVR_Atomic.h"
+#include "Kernel/OVR_Delegates.h"
 #include "Kernel/OVR_String.h"
 #include "Kernel/OVR_System.h"
 #include "Kernel/OVR_Threads.h"
@@ -38,6 +41,80 @@ limitations under the License.
 namespace OVR {
 namespace Util {
 
+//-----------------------------------------------------------------------------
+// LatencyHistogram
+//
+// Counts durations in nanoseconds, in log-linear buckets which are exact below 16 ns and
+// within 1/16 of the value above that, up to about 18 minutes. Recording doesn't lock or use
+// atomic read-modify-write instructions, so it must only be done by one thread at a time.
+// Other threads may read the counts at any time.
+
+class LatencyHistogram {
+ public:
+  enum {
+    SubBucketBits = 4,
+    SubBucketCount = 1 << SubBucketBits,
+    MaxValueBits = 40, // Longer durations are counted in the last bucket.
+    BucketCount = (MaxValueBits - SubBucketBits + 1) * SubBucketCount
+  };
+
+  LatencyHistogram();
+
+  void Record(uint64_t nanos) {
+    std::atomic<uint64_t>& count = Counts[GetBucket(nanos)];
+    count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    SumNanos.store(SumNanos.load(std::memory_order_relaxed) + nanos, std::memory_order_relaxed);
+    if (nanos > MaxNanos.load(std::memory_order_relaxed))
+      MaxNanos.store(nanos, std::memory_order_relaxed);
+  }
+
+  uint64_t GetCount() const;
+  uint64_t GetMean() const;
+  uint64_t GetMax() const {
+    return MaxNanos.load(std::memory_order_relaxed);
+  }
+
+  // Returns the duration which the given fraction (0 to 1) of the recorded durations don't
+  // exceed, rounded up to its bucket's upper bound, or 0 if nothing was recorded.
+  uint64_t GetPercentile(double fraction) const;
+
+  static int GetBucket(uint64_t nanos) {
+    if (nanos < SubBucketCount)
+      return int(nanos);
+    if (nanos >> MaxValueBits)
+      return BucketCount - 1;
+    const int exponent = 63 - Alg::CountLeading0Bits(nanos);
+    const int subBucket = int(nanos >> (exponent - SubBucketBits)) & (SubBucketCount - 1);
+    return (exponent - SubBucketBits + 1) * SubBucketCount + subBucket;
+  }
+
+  static uint64_t GetBucketUpperBound(int bucket);
+
+ private:
+  std::atomic<uint64_t> Counts[BucketCount];
+  std::atomic<uint64_t> SumNanos;
+  std::atomic<uint64_t> MaxNanos;
+
+  OVR_NON_COPYABLE(LatencyHistogram);
+};
+
+//-----------------------------------------------------------------------------
+// WatchDogStats
+//
+// Cycle statistics of a watchdog, as returned by WatchDog::GetStats.
+
+struct WatchDogStats {
+  String ThreadName;
+  uint64_t CycleCount;
+  uint64_t MeanCycleNanos;
+  uint64_t MedianCycleNanos;
+  uint64_t P99CycleNanos;
+  uint64_t P999CycleNanos;
+  uint64_t MaxCycleNanos;
+  uint64_t DeadlineNanos; // 0 if no deadline is set.
+  uint64_t MissedDeadlines;
+};
+
 //-----------------------------------------------------------------------------
 // WatchDog
 //
@@ -60,11 +137,23 @@ namespace Util {
 // when the system goes to sleep or the debugger is active. When 15 long cycles
 // have been detected, the observer sees that thread as deadlocked and a report
 // is generated / the offending process is terminated.
+//
+// Each Feed() also records the time since the previous one, with nanosecond
+// resolution, in a histogram of cycle durations. Threads with real-time
+// requirements can set a cycle deadline with SetDeadline(). A miss is reported
+// to the deadline callback as soon as it's seen: by Feed() if the cycle ends
+// late, or by the observer if the cycle is still running at its deadline.
+// While any deadline is set, the observer wakes at the next one rather than
+// every ~4s. GetStats() returns the cycle statistics and number of misses.
 
 class WatchDog : public NewOverrideBase {
   friend class WatchDogObserver;
 
  public:
+  // Called with the watchdog and the cycle duration, or the time so far if the cycle is
+  // still running.
+  typedef Delegate<void(WatchDog*, uint64_t)> DeadlineMissFunc;
+
   WatchDog(const String& threadName);
   ~WatchDog();
 
@@ -75,11 +164,40 @@ class WatchDog : public NewOverrideBase {
 
   void Feed(int threshold);
 
+  // Sets the deadline for each cycle, from one Feed() to the next, or disables it if
+  // deadlineNanos is 0. The callback runs on this thread or the watchdog thread, and must not
+  // block. Call this from the thread which feeds the watchdog.
+  void SetDeadline(uint64_t deadlineNanos, DeadlineMissFunc onMiss = DeadlineMissFunc());
+
+  void GetStats(WatchDogStats& stats) const;
+
+  const LatencyHistogram& GetCycleHistogram() const {
+    return CycleHistogram;
+  }
+
  protected:
-  // Use 32 bit int so assignment and comparison is atomic
-  std::atomic<uint32_t> WhenLastFedMilliseconds = {0};
+  // Returns false if the miss of the given cycle was already reported.
+  bool reportMiss(uint64_t cycle, uint64_t cycleNanos);
+
+  // CycleCount and WhenLastFedNanos are written together by the fed thread, under
+  // CycleSequence, so that the observer reads a cycle with its own start time.
+  void storeCycleStart(uint64_t cycle, uint64_t whenFedNanos);
+  void loadCycleStart(uint64_t& cycle, uint64_t& whenFedNanos) const;
+
+  std::atomic<uint64_t> WhenLastFedNanos = {0};
   std::atomic<int> ThreshholdMilliseconds = {0};
 
+  // Written by the fed thread only.
+  LatencyHistogram CycleHistogram;
+  std::atomic<uint64_t> CycleCount = {0};
+  std::atomic<uint32_t> CycleSequence = {0}; // Odd while a cycle start is being written.
+  std::atomic<uint64_t> DeadlineNanos = {0};
+  DeadlineMissFunc OnDeadlineMiss; // Changed under the observer's ListLock.
+
+  std::atomic<uint64_t> ReportedCycle = {0}; // Index + 1 of the last cycle reported missed.
+  std::atomic<uint64_t> MissedDeadlines = {0};
+  uint64_t LoggedMissedDeadlines = 0; // Used by the observer.
+
   String ThreadName;
   bool Listed;
 };
@@ -130,6 +248,9 @@ class WatchDogObserver : public SystemSingletonBase<WatchDogObserver> {
     AddBreakpadInfoClient = pAddBreakpadInfoClient;
   }
 
+  // Gets the statistics of all enabled watchdogs.
+  void GetStats(Array<WatchDogStats>& stats);
+
  protected:
   Lock ListLock;
   Array<WatchDog*> DogList;
@@ -138,6 +259,7 @@ class WatchDogObserver : public SystemSingletonBase<WatchDogObserver> {
   bool IsReporting = false;
 
   Event TerminationEvent;
+  Event DeadlinesChanged; // Set when deadlines are set or added, to recompute the wait.
 
   // Has a deadlock been seen?
   bool DeadlockSeen = false;
@@ -157,6 +279,13 @@ class WatchDogObserver : public SystemSingletonBase<WatchDogObserver> {
  protected:
   int Run();
 
+  // Reports deadline misses of cycles still running, and returns when to check next.
+  uint64_t checkDeadlines(uint64_t nowNanos);
+
+  // Waits until the given time or a deadline change, and returns true if termination was
+  // requested.
+  bool waitForTermination(uint64_t wakeNanos);
+
   void Add(WatchDog* dog);
   void Remove(WatchDog* dog);
 };
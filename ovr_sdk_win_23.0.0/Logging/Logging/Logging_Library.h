@@ -33,6 +33,7 @@ limitations under the License.
 
 #include <time.h>
 #include <array>
+#include <atomic>
 #include <map>
 #include <memory>
 #include <mutex>
@@ -668,6 +669,11 @@ class OutputWorker {
   // and the channel will write to no other outputs.
   void SetChannelSingleOutput(const char* channelName, const char* outputPluginName);
 
+  // Sets a function for the worker thread to call on itself, such as to set its scheduling
+  // attributes. The worker calls it as it starts, and at its next wakeup if it's already
+  // running. Pass nullptr to clear it.
+  void SetWorkerThreadHook(void (*hook)());
+
  private:
   // Is the logger running in a debugger?
   bool IsInDebugger;
@@ -754,7 +760,11 @@ class OutputWorker {
 
   void WorkerThreadEntrypoint();
 
+  void RunWorkerThreadHook();
+
   Lock StartStopLock;
+  std::atomic<void (*)()> WorkerThreadHook;
+  std::atomic<bool> WorkerThreadHookPending;
 #if defined(_WIN32)
   // Event letting the worker thread know the queue is not empty
   AutoHandle WorkerWakeEvent;
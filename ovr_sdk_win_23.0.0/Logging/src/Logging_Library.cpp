@@ -48,6 +48,12 @@ limitations under the License.
 #include <locale>
 #endif // !_WIN32
 
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif // defined(__linux__)
+
 namespace ovrlog {
 
 //--------------------------------------------------------------------------------------------------
@@ -463,7 +469,9 @@ OutputWorker::OutputWorker()
       ChannelOutputPluginFiltering(),
       WorkQueueLock(),
       WorkQueueOverrun(0),
-      StartStopLock()
+      StartStopLock(),
+      WorkerThreadHook(nullptr),
+      WorkerThreadHookPending(false)
 #if defined(_WIN32)
       ,
       WorkerWakeEvent(),
@@ -1138,24 +1146,56 @@ void OutputWorker::WorkerThreadEntrypoint() {
 #if defined(_WIN32)
   // Lower the priority for logging.
   ::SetThreadPriority(::GetCurrentThread(), THREAD_PRIORITY_LOWEST);
+#elif defined(__linux__)
+  // Linux has a nice value per thread, which setpriority sets given the thread id.
+  setpriority(PRIO_PROCESS, (id_t)syscall(SYS_gettid), 10);
 #else
-  // Other desktop platforms (e.g. Linux, OSX) don't let you set thread priorities.
+  // OSX doesn't let you set thread priorities without real-time scheduling.
 #endif // defined(_WIN32)
 
+  RunWorkerThreadHook();
+
 #if defined(_WIN32)
   while (!WorkerTerminator.IsTerminated()) {
     if (WorkerTerminator.WaitOn(WorkerWakeEvent.Get())) {
+      if (WorkerThreadHookPending.load())
+        RunWorkerThreadHook();
       ProcessQueuedMessages();
     }
   }
 #else
   while (!Terminated.load()) {
     WorkerCv.wait(lock);
+    if (WorkerThreadHookPending.load())
+      RunWorkerThreadHook();
     ProcessQueuedMessages();
   }
 #endif // defined(_WIN32)
 }
 
+void OutputWorker::RunWorkerThreadHook() {
+  WorkerThreadHookPending.store(false);
+  void (*hook)() = WorkerThreadHook.load();
+  if (hook)
+    hook();
+}
+
+void OutputWorker::SetWorkerThreadHook(void (*hook)()) {
+  WorkerThreadHook.store(hook);
+  WorkerThreadHookPending.store(true);
+
+  // Wake the worker thread, if it's running, to call the hook
+#if defined(_WIN32)
+  ::SetEvent(WorkerWakeEvent.Get());
+#else
+  {
+    // The worker holds the mutex except while it waits, so this doesn't miss the wakeup.
+    std::lock_guard<std::mutex> lock(WorkerCvMutex);
+  }
+  WorkerCv.notify_one();
+#endif // defined(_WIN32)
+}
+
 void OutputWorker::Write(
     const char* subsystemName,
     Level messageLogLevel,